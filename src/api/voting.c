@@ -0,0 +1,248 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation of the libvoting Shared Library
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "voting.h"
+#include "allocator.h"
+#include "election.h"
+#include "proportional.h"
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+struct voting_election {
+    Allocator allocator; /**< Serves every allocation of the election */
+    ptrTallies tallies;  /**< Ballots and tallies */
+    bool stale;          /**< Ballots were added since the last count */
+};
+
+// Every entry point allocates with the allocator of its election
+static const Allocator *enter(const VotingElection *election) {
+    return set_thread_allocator(&election->allocator);
+}
+
+static void leave(const Allocator *previous) { set_thread_allocator(previous); }
+
+VotingElection *voting_election_create(const VotingAllocator *allocator) {
+    Allocator chosen = *get_system_allocator();
+    if (allocator != NULL) {
+        if (!allocator->allocate || !allocator->reallocate ||
+            !allocator->release)
+            return NULL;
+        chosen.allocate = allocator->allocate;
+        chosen.reallocate = allocator->reallocate;
+        chosen.release = allocator->release;
+        chosen.context = allocator->context;
+    }
+    VotingElection *election =
+        chosen.allocate(chosen.context, sizeof(VotingElection));
+    if (election == NULL)
+        return NULL;
+    election->allocator = chosen;
+    election->stale = false;
+
+    const Allocator *previous = enter(election);
+    election->tallies = init_tallies();
+    leave(previous);
+    if (election->tallies == NULL) {
+        chosen.release(chosen.context, election);
+        return NULL;
+    }
+    return election;
+}
+
+VotingStatus voting_election_load(VotingElection *election, const char *path,
+                                  int nb_candidates) {
+    if (election == NULL || path == NULL || nb_candidates < 0 ||
+        nb_candidates >= MAX_TAB)
+        return VOTING_ERROR_ARGUMENT;
+    if (access(path, R_OK) != 0)
+        return VOTING_ERROR_IO;
+    if (nb_candidates == 0)
+        nb_candidates = infer_candidate_count(path);
+    if (nb_candidates <= 0 || nb_candidates >= MAX_TAB)
+        return VOTING_ERROR_FORMAT;
+
+    const Allocator *previous = enter(election);
+    int status = set_tallies_from_file(election->tallies, path, nb_candidates);
+    leave(previous);
+    election->stale = false;
+    return status == 0 ? VOTING_OK : VOTING_ERROR_FORMAT;
+}
+
+VotingStatus voting_election_set_candidates(VotingElection *election,
+                                            const char *const *names,
+                                            int nb_candidates) {
+    if (election == NULL || names == NULL || nb_candidates <= 0 ||
+        nb_candidates >= MAX_TAB)
+        return VOTING_ERROR_ARGUMENT;
+    for (int i = 0; i < nb_candidates; i++) {
+        if (names[i] == NULL)
+            return VOTING_ERROR_ARGUMENT;
+    }
+
+    const Allocator *previous = enter(election);
+    ptrBallots ballots = election->tallies->ballots;
+    clear_ballots(ballots);
+    VotingStatus status = VOTING_OK;
+    for (int i = 0; i < nb_candidates; i++) {
+        ballots->tags[i] = init_stringbuffer(names[i], strlen(names[i]));
+        if (ballots->tags[i] == NULL)
+            status = VOTING_ERROR_MEMORY;
+    }
+    ballots->columns = nb_candidates;
+    if (status != VOTING_OK)
+        clear_ballots(ballots);
+    leave(previous);
+    election->stale = true;
+    return status;
+}
+
+VotingStatus voting_election_add_ballot(VotingElection *election,
+                                        const int *ranks) {
+    if (election == NULL || ranks == NULL)
+        return VOTING_ERROR_ARGUMENT;
+    ptrBallots ballots = election->tallies->ballots;
+    if (ballots->columns == 0)
+        return VOTING_ERROR_ARGUMENT;
+    for (uint c = 0; c < ballots->columns; c++) {
+        if (ranks[c] > MAX_RANK)
+            return VOTING_ERROR_ARGUMENT;
+    }
+
+    const Allocator *previous = enter(election);
+    int status = add_ballot(ballots, ranks, ballots->columns);
+    leave(previous);
+    election->stale = true;
+    return status == 0 ? VOTING_OK : VOTING_ERROR_MEMORY;
+}
+
+/**
+ * @brief Brings the tallies up to date with the ballots.
+ */
+static VotingStatus refresh_tallies(VotingElection *election) {
+    if (election->tallies->ballots->columns == 0)
+        return VOTING_ERROR_ARGUMENT;
+    if (!election->stale)
+        return VOTING_OK;
+    if (update_tallies(election->tallies) != 0)
+        return VOTING_ERROR_MEMORY;
+    election->stale = false;
+    return VOTING_OK;
+}
+
+VotingStatus voting_election_count(VotingElection *election,
+                                   const char *method,
+                                   const VotingOptions *options,
+                                   VotingResult *result) {
+    if (election == NULL || method == NULL || result == NULL)
+        return VOTING_ERROR_ARGUMENT;
+    ElectionOptions election_options;
+    init_election_options(&election_options, str_to_enum(method));
+    if (election_options.method == UNKNOWN || election_options.method == ALL)
+        return VOTING_ERROR_METHOD;
+    if (options != NULL) {
+        if (options->truncation < VOTING_TRUNCATION_ZERO ||
+            options->truncation > VOTING_TRUNCATION_IGNORE)
+            return VOTING_ERROR_ARGUMENT;
+        election_options.approvals = options->approvals;
+        election_options.policy = (enum TruncationPolicy)options->truncation;
+    }
+
+    const Allocator *previous = enter(election);
+    VotingStatus status = refresh_tallies(election);
+    int winner = -1;
+    if (status == VOTING_OK)
+        winner = find_election_winner(election->tallies, &election_options);
+    leave(previous);
+    if (status != VOTING_OK)
+        return status;
+    if (winner < 0)
+        return VOTING_ERROR_NO_WINNER;
+
+    const Ballots *ballots = election->tallies->ballots;
+    result->winner = winner;
+    result->nb_candidates = ballots->columns;
+    result->ballots = ballots->rows;
+    result->rejected = ballots->rejected;
+    return VOTING_OK;
+}
+
+VotingStatus voting_election_allocate_seats(VotingElection *election,
+                                            const char *method, int seats,
+                                            int *allocated) {
+    if (election == NULL || method == NULL || seats < 0 || allocated == NULL)
+        return VOTING_ERROR_ARGUMENT;
+    enum SeatMethod seat_method;
+    switch (str_to_enum(method)) {
+    case DHONDT:
+        seat_method = SEATS_DHONDT;
+        break;
+    case SAINTE_LAGUE:
+        seat_method = SEATS_SAINTE_LAGUE;
+        break;
+    case HARE:
+        seat_method = SEATS_HARE;
+        break;
+    case DROOP:
+        seat_method = SEATS_DROOP;
+        break;
+    default:
+        return VOTING_ERROR_METHOD;
+    }
+
+    const Allocator *previous = enter(election);
+    VotingStatus status = refresh_tallies(election);
+    if (status == VOTING_OK &&
+        allocate_seats(election->tallies->first_choices,
+                       election->tallies->ballots->columns, seats,
+                       seat_method, allocated) != 0)
+        status = VOTING_ERROR_NO_WINNER;
+    leave(previous);
+    return status;
+}
+
+const char *voting_election_candidate(const VotingElection *election,
+                                      int index) {
+    if (election == NULL || index < 0 ||
+        (uint)index >= election->tallies->ballots->columns)
+        return NULL;
+    const StringBuffer *tag = election->tallies->ballots->tags[index];
+    return tag ? tag->string : NULL;
+}
+
+void voting_election_destroy(VotingElection *election) {
+    if (election == NULL)
+        return;
+    Allocator allocator = election->allocator;
+    const Allocator *previous = enter(election);
+    delete_tallies(election->tallies);
+    leave(previous);
+    allocator.release(allocator.context, election);
+}
+
+const char *voting_status_string(VotingStatus status) {
+    switch (status) {
+    case VOTING_OK:
+        return "success";
+    case VOTING_ERROR_ARGUMENT:
+        return "invalid argument";
+    case VOTING_ERROR_MEMORY:
+        return "out of memory";
+    case VOTING_ERROR_IO:
+        return "cannot read the file";
+    case VOTING_ERROR_FORMAT:
+        return "not a ballot file";
+    case VOTING_ERROR_METHOD:
+        return "unknown method";
+    case VOTING_ERROR_NO_WINNER:
+        return "no single winner";
+    }
+    return "unknown status";
+}
@@ -0,0 +1,194 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Public Interface of the libvoting Shared Library
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef VOTING_H
+#define VOTING_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Voting libvoting
+ *
+ * Counts elections in the calling process. The library has no global state:
+ * every election is an opaque handle owning its memory, allocated with the
+ * allocator it was created with. Distinct handles may be used from distinct
+ * threads at the same time, a handle from one thread at a time. No function
+ * prints or exits, failures are reported as VotingStatus codes.
+ * @{
+ */
+
+/**
+ * @brief Version of this interface, raised when it changes incompatibly.
+ */
+#define VOTING_API_VERSION 1
+
+/**
+ * @brief What a function of the library reports.
+ */
+typedef enum voting_status {
+    VOTING_OK = 0,               /**< Success */
+    VOTING_ERROR_ARGUMENT = -1,  /**< An argument is NULL or out of range */
+    VOTING_ERROR_MEMORY = -2,    /**< The allocator failed */
+    VOTING_ERROR_IO = -3,        /**< A file cannot be read */
+    VOTING_ERROR_FORMAT = -4,    /**< A file is not a ballot file */
+    VOTING_ERROR_METHOD = -5,    /**< The method is unknown */
+    VOTING_ERROR_NO_WINNER = -6, /**< The method finds no single winner */
+} VotingStatus;
+
+/**
+ * @brief Memory functions of an election, and their context.
+ */
+typedef struct voting_allocator {
+    void *(*allocate)(void *context, size_t size);
+    void *(*reallocate)(void *context, void *pointer, size_t size);
+    void (*release)(void *context, void *pointer);
+    void *context; /**< Passed to each call */
+} VotingAllocator;
+
+/**
+ * @brief How scoring rules count truncated ballots.
+ */
+typedef enum voting_truncation {
+    VOTING_TRUNCATION_ZERO,    /**< Unranked candidates score nothing */
+    VOTING_TRUNCATION_AVERAGE, /**< They share the remaining points */
+    VOTING_TRUNCATION_IGNORE,  /**< Truncated ballots are not counted */
+} VotingTruncation;
+
+/**
+ * @brief Parameters of a count.
+ */
+typedef struct voting_options {
+    int approvals;               /**< Approved ranks of approval voting */
+    VotingTruncation truncation; /**< Truncation policy of scoring rules */
+} VotingOptions;
+
+/**
+ * @brief Outcome of a count.
+ */
+typedef struct voting_result {
+    int winner;        /**< Index of the winner */
+    int nb_candidates; /**< Number of candidates */
+    unsigned ballots;  /**< Ballots counted */
+    unsigned rejected; /**< Rows rejected while reading the file */
+} VotingResult;
+
+/**
+ * @brief An election: its candidates, ballots and tallies.
+ */
+typedef struct voting_election VotingElection;
+
+/**
+ * @brief Creates an empty election.
+ *
+ * @param[in] allocator The allocator of every allocation of the election,
+ *                      copied. NULL for malloc, realloc and free.
+ * @return The election, or NULL if memory allocation fails.
+ *
+ * @post The election must be freed with voting_election_destroy.
+ */
+VotingElection *voting_election_create(const VotingAllocator *allocator);
+
+/**
+ * @brief Replaces the ballots of an election with those of a CSV file.
+ *
+ * @param[in,out] election The election.
+ * @param[in] path The ballot file, in the format of VotingMethods.
+ * @param[in] nb_candidates The number of candidates, 0 to infer it from the
+ *                          file.
+ * @return VOTING_OK, or why the file could not be loaded.
+ */
+VotingStatus voting_election_load(VotingElection *election, const char *path,
+                                  int nb_candidates);
+
+/**
+ * @brief Removes every ballot and names the candidates of an election.
+ *
+ * @param[in,out] election The election.
+ * @param[in] names The names of the candidates.
+ * @param[in] nb_candidates The number of candidates, below 256.
+ * @return VOTING_OK, VOTING_ERROR_ARGUMENT or VOTING_ERROR_MEMORY.
+ */
+VotingStatus voting_election_set_candidates(VotingElection *election,
+                                            const char *const *names,
+                                            int nb_candidates);
+
+/**
+ * @brief Adds a ballot to an election.
+ *
+ * @param[in,out] election The election, whose candidates are set.
+ * @param[in] ranks The rank of each candidate, from 1 to 255, or 0 when the
+ *                  ballot does not rank it.
+ * @return VOTING_OK, VOTING_ERROR_ARGUMENT if a rank is out of range, or
+ * VOTING_ERROR_MEMORY.
+ */
+VotingStatus voting_election_add_ballot(VotingElection *election,
+                                        const int *ranks);
+
+/**
+ * @brief Finds the single winner of an election.
+ *
+ * @param[in,out] election The election. Its tallies are updated first if
+ *                         ballots were added since the last count.
+ * @param[in] method The name of the method, as VotingMethods -m takes it.
+ * @param[in] options The parameters of the count, NULL for the defaults.
+ * @param[out] result The outcome.
+ * @return VOTING_OK, or why there is no winner.
+ */
+VotingStatus voting_election_count(VotingElection *election,
+                                   const char *method,
+                                   const VotingOptions *options,
+                                   VotingResult *result);
+
+/**
+ * @brief Allocates seats to the candidates of an election, read as lists.
+ *
+ * @param[in,out] election The election.
+ * @param[in] method "dhondt", "saintelague", "hare" or "droop".
+ * @param[in] seats The number of seats.
+ * @param[out] allocated The seats of each candidate.
+ * @return VOTING_OK, or why the seats could not be allocated.
+ */
+VotingStatus voting_election_allocate_seats(VotingElection *election,
+                                            const char *method, int seats,
+                                            int *allocated);
+
+/**
+ * @brief Gives the name of a candidate.
+ *
+ * @return The name, owned by the election, or NULL if index is out of range.
+ */
+const char *voting_election_candidate(const VotingElection *election,
+                                      int index);
+
+/**
+ * @brief Frees an election.
+ *
+ * @param[in] election The election to free, may be NULL.
+ */
+void voting_election_destroy(VotingElection *election);
+
+/**
+ * @brief Describes a status.
+ *
+ * @return A static string.
+ */
+const char *voting_status_string(VotingStatus status);
+
+/** @} */ // End of Voting group
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VOTING_H
@@ -1,22 +1,416 @@
+#include "arena.h"
+#include "ballots.h"
+#include "batch.h"
+#include "bootstrap.h"
+#include "bucklin.h"
+#include "cache.h"
 #include "condorcet.h"
+#include "elimination.h"
 #include "first_past_the_post.h"
+#include "histogram.h"
 #include "majority_judgement.h"
+#include "margin.h"
 #include "matrix.h"
 #include "miscellaneous.h"
+#include "proportional.h"
+#include "scoring_rules.h"
+#include "server.h"
+#include "smith.h"
+#include "stats.h"
 #include "stringbuffer.h"
+#include "summary.h"
+#include "trace.h"
+#include "tracker.h"
+#include "withdrawal.h"
+#include "writer.h"
+#include <errno.h>
 #include <getopt.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Loads the tallies of a ballot file, through the cache if any, or
+ * of a tally summary.
+ */
+static ptrTallies load_election(char *inputFile, int nb_candidates,
+                                const char *cacheDir, bool is_summary,
+                                FILE *info) {
+    ptrTallies tallies = init_tallies();
+    if (tallies == NULL) {
+        fprintf(stderr, "Could not allocate the tallies\n");
+        exit(EXIT_FAILURE);
+    }
+    if (is_summary) {
+        ptrTallySummary summary = init_tally_summary();
+        if (summary == NULL || read_tally_summary(summary, inputFile) != 0 ||
+            set_tallies_from_summary(tallies, summary) != 0) {
+            fprintf(stderr, "Could not read the tally summary %s\n",
+                    inputFile);
+            exit(EXIT_FAILURE);
+        }
+        delete_tally_summary(summary);
+    } else if (load_tallies(tallies, cacheDir, inputFile, nb_candidates) != 0) {
+        fprintf(stderr, "Could not read the ballots of %s\n", inputFile);
+        exit(EXIT_FAILURE);
+    }
+    if (tallies->from_cache)
+        fprintf(info, "Tallies read from the cache\n");
+    return tallies;
+}
+
+/**
+ * @brief Stops when a method needs every ballot and only has a summary.
+ */
+static void require_ballots(const Tallies *tallies, const char *method) {
+    if (!tallies->has_ballots) {
+        fprintf(stderr, "%s needs the ballots, not a tally summary\n",
+                method);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void print_scoring_rules(ptrWriter out, const Tallies *tallies,
+                                const ScoringRule *rules, int nb_rules,
+                                enum TruncationPolicy policy) {
+    const Ballots *ballots = tallies->ballots;
+    int nb_candidates = ballots->columns;
+    double *scores = mem_alloc(sizeof(double) * nb_rules * nb_candidates);
+    if (scores == NULL) {
+        fprintf(stderr, "Could not score the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+    // The histogram is enough when unranked candidates score zero
+    if (policy == TRUNCATION_ZERO) {
+        compute_scoring_rules_from_histogram(tallies->histogram, rules,
+                                             nb_rules, scores);
+    } else if (compute_scoring_rules(ballots, rules, nb_rules, policy,
+                                     scores) != 0) {
+        fprintf(stderr, "Could not score the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Candidates sorted by the first rule, one column per rule
+    CandidateScore *ranking = rank_by_score(scores, nb_candidates);
+    const char *headers[5] = {"Candidate"};
+    for (int k = 0; k < nb_rules; k++)
+        headers[k + 1] = rules[k].name;
+    begin_table(out, headers, nb_rules + 1, 2);
+    for (int i = 0; i < nb_candidates; i++) {
+        int candidate = ranking[i].candidate;
+        double values[4];
+        for (int k = 0; k < nb_rules; k++)
+            values[k] = scores[k * nb_candidates + candidate];
+        write_table_row(out, ballots->tags[candidate]->string, values);
+    }
+    end_table(out);
+
+    mem_free(ranking);
+    mem_free(scores);
+}
+
+static void print_seats(ptrWriter out, const Tallies *tallies, int seats,
+                        enum SeatMethod method) {
+    // The plurality totals, as in the totals row of the first round
+    const Ballots *ballots = tallies->ballots;
+    int allocated[MAX_TAB];
+    if (allocate_seats(tallies->first_choices, ballots->columns, seats, method,
+                       allocated) != 0) {
+        fprintf(stderr, "Could not allocate %d seats\n", seats);
+        exit(EXIT_FAILURE);
+    }
+
+    static const char *const headers[] = {"List", "Votes", "Seats"};
+    begin_table(out, headers, 3, 0);
+    for (uint i = 0; i < ballots->columns; i++) {
+        double values[2] = {tallies->first_choices[i], allocated[i]};
+        write_table_row(out, ballots->tags[i]->string, values);
+    }
+    end_table(out);
+}
+
+/**
+ * @brief Writes candidates in the order of a ranking, with their score.
+ */
+static void print_ranking(ptrWriter out, StringBuffer *const *tags,
+                          const char *score, const CandidateScore *ranking,
+                          int nb_candidates) {
+    const char *headers[] = {"Candidate", score};
+    begin_table(out, headers, 2, 0);
+    for (int i = 0; i < nb_candidates; i++) {
+        double value = ranking[i].score;
+        write_table_row(out, tags[ranking[i].candidate]->string, &value);
+    }
+    end_table(out);
+}
+
+/**
+ * @brief Writes the winner of the last round of a first past the post, or
+ * the two finalists when nobody holds an absolute majority.
+ */
+static void print_leaders(ptrWriter out, ptrMatrix results, const char *label) {
+    int nb_leaders;
+    int *totals = results->data[results->rows - 1];
+    int *leaders =
+        get_candidates_for_next_round(totals, results->columns, &nb_leaders);
+    if (nb_leaders == 1) {
+        emit_winner(out, label, leaders[0], results->tags[leaders[0]]->string);
+    } else {
+        static const char *const headers[] = {"Finalist", "Votes"};
+        begin_table(out, headers, 2, 0);
+        for (int i = 0; i < nb_leaders; i++) {
+            double votes = totals[leaders[i]];
+            write_table_row(out, results->tags[leaders[i]]->string, &votes);
+        }
+        end_table(out);
+    }
+    mem_free(leaders);
+}
+
+/**
+ * @brief Writes the ballots of a file as a matrix, when one holds them.
+ */
+static void emit_ballot_matrix(ptrWriter out, char *path, int nb_candidates) {
+    if (path == NULL)
+        return;
+    ptrMatrix ballots = init_matrix(false);
+    if (ballots != NULL &&
+        set_matrix_from_file(ballots, path, nb_candidates) == 0)
+        emit_matrix(out, ballots, " | ");
+    delete_matrix(ballots);
+}
+
+/**
+ * @brief Puts the plurality totals of the tallies in the single row of a
+ * matrix, as print_leaders reads them.
+ */
+static ptrMatrix first_choice_results(const Tallies *tallies) {
+    ptrMatrix results = init_matrix(false);
+    if (results == NULL)
+        return NULL;
+    const Ballots *ballots = tallies->ballots;
+    results->rows = 1;
+    results->columns = ballots->columns;
+    for (uint c = 0; c < ballots->columns; c++) {
+        const StringBuffer *tag = ballots->tags[c];
+        results->tags[c] = init_stringbuffer(tag->string, tag->size);
+        results->data[0][c] = tallies->first_choices[c];
+    }
+    return results;
+}
+
+/**
+ * @brief Writes how often each candidate wins when the ballots are drawn
+ * again, with replacement, from the election.
+ */
+static void print_bootstrap(ptrWriter out, const Tallies *tallies,
+                            const ElectionOptions *options,
+                            uint nb_resamples, uint64_t seed,
+                            int nb_workers) {
+    uint wins[MAX_TAB];
+    int undecided = run_bootstrap(tallies, options, nb_resamples, seed,
+                                  nb_workers, wins);
+    if (undecided < 0) {
+        fprintf(stderr, "Could not resample the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+    char note[96];
+    snprintf(note, sizeof(note),
+             "Bootstrap over %u resamples, %d without a single winner",
+             nb_resamples, undecided);
+    emit_note(out, note);
+    static const char *const headers[] = {"Candidate", "Win frequency"};
+    begin_table(out, headers, 2, 4);
+    for (uint c = 0; c < tallies->ballots->columns; c++) {
+        double frequency = (double)wins[c] / nb_resamples;
+        write_table_row(out, tallies->ballots->tags[c]->string, &frequency);
+    }
+    end_table(out);
+}
+
+/**
+ * @brief Writes how many ballots must be rewritten for another candidate to
+ * win the plurality, two-round and instant-runoff counts.
+ */
+static void print_margins(ptrWriter out, const Tallies *tallies,
+                          int nb_workers) {
+    require_ballots(tallies, "Margin of victory");
+    const Ballots *ballots = tallies->ballots;
+    FirstChoiceIndex *index = build_first_choice_index(ballots);
+    Margins margins;
+    if (index == NULL ||
+        find_margins(ballots, index, nb_workers, &margins) != 0) {
+        fprintf(stderr, "Could not compute the margins\n");
+        exit(EXIT_FAILURE);
+    }
+    delete_first_choice_index(index);
+    char note[256];
+    snprintf(note, sizeof(note),
+             "Plurality elects %s, two-round %s, instant-runoff %s",
+             ballots->tags[margins.plurality_winner]->string,
+             ballots->tags[margins.two_round_winner]->string,
+             ballots->tags[margins.irv_winner]->string);
+    emit_note(out, note);
+    static const char *const headers[] = {"Count", "Lower", "Upper"};
+    begin_table(out, headers, 3, 0);
+    double bounds[2] = {margins.plurality, margins.plurality};
+    write_table_row(out, "Plurality", bounds);
+    bounds[0] = bounds[1] = margins.two_round;
+    write_table_row(out, "Two-round", bounds);
+    bounds[0] = margins.irv_lower;
+    bounds[1] = margins.irv_upper;
+    write_table_row(out, "Instant-runoff", bounds);
+    end_table(out);
+}
+
+// A loser whose withdrawal changes the winner of a method spoils it
+static void print_withdrawals(ptrWriter out, ptrMatrix duel,
+                              int nb_candidates, int nb_workers) {
+    Withdrawal *withdrawals = mem_alloc(sizeof(Withdrawal) * nb_candidates);
+    if (withdrawals == NULL ||
+        find_withdrawal_winners(duel, nb_candidates, nb_workers,
+                                withdrawals) != 0) {
+        fprintf(stderr, "Could not count the withdrawals\n");
+        exit(EXIT_FAILURE);
+    }
+    int before[4];
+    if (!find_condorcet_winner(duel, nb_candidates, &before[0]))
+        before[0] = -1;
+    before[1] = find_minimax_condorcet_winner(duel, nb_candidates);
+    CandidateScore *ranking =
+        find_ranked_pairs_condorcet_winner(duel, nb_candidates);
+    if (ranking == NULL) {
+        fprintf(stderr, "Could not rank the pairs\n");
+        exit(EXIT_FAILURE);
+    }
+    before[2] = ranking[0].candidate;
+    mem_free(ranking);
+    before[3] = find_schulze_condorcet_winner(duel, nb_candidates);
+
+    static const char *const labels[] = {"Condorcet", "Minimax Condorcet",
+                                         "Ranked pairs", "Schulze Condorcet"};
+    char label[256];
+    for (int c = 0; c < nb_candidates; c++) {
+        const char *withdrawn = duel->tags[c]->string;
+        int after[4] = {withdrawals[c].condorcet, withdrawals[c].minimax,
+                        withdrawals[c].ranked_pairs, withdrawals[c].schulze};
+        for (int m = 0; m < 4; m++) {
+            snprintf(label, sizeof(label), "%s without %s", labels[m],
+                     withdrawn);
+            if (after[m] >= 0) {
+                emit_winner(out, label, after[m],
+                            duel->tags[after[m]]->string);
+            } else {
+                snprintf(label, sizeof(label), "No %s winner without %s",
+                         labels[m], withdrawn);
+                emit_note(out, label);
+            }
+        }
+        for (int m = 0; m < 4; m++) {
+            if (before[m] < 0 || before[m] == c || after[m] == before[m])
+                continue;
+            snprintf(label, sizeof(label),
+                     "%s spoils the %s count, %s winning without them",
+                     withdrawn, labels[m],
+                     after[m] >= 0 ? duel->tags[after[m]]->string : "nobody");
+            emit_note(out, label);
+        }
+    }
+    mem_free(withdrawals);
+}
+
+static void save_trace(ptrTrace trace, const char *path) {
+    if (write_trace(trace, path) != 0) {
+        perror("Could not write the trace");
+        exit(EXIT_FAILURE);
+    }
+    clear_trace(trace);
+}
+
+/**
+ * @brief Counts every election of a directory or a manifest and writes one
+ * record per election.
+ */
+static void run_batch_mode(const char *batchPath, const char *method,
+                           const ElectionOptions *options,
+                           const char *cacheDir, const char *outputFile,
+                           enum OutputFormat format, int nb_workers,
+                           const char *traceFile) {
+    ptrBatch batch = init_batch(options, method, cacheDir);
+    if (batch == NULL || add_batch_path(batch, batchPath) < 0) {
+        fprintf(stderr, "Could not list the elections of %s\n", batchPath);
+        exit(EXIT_FAILURE);
+    }
+    Trace trace;
+    if (traceFile != NULL) {
+        init_trace(&trace);
+        batch->trace = &trace;
+    }
+    if (run_batch(batch, nb_workers) != 0) {
+        fprintf(stderr, "Could not start the workers\n");
+        exit(EXIT_FAILURE);
+    }
+    ptrWriter writer = open_writer(outputFile, format);
+    if (writer == NULL) {
+        perror("Could not open the output file");
+        exit(EXIT_FAILURE);
+    }
+    int failed = write_batch_records(batch, writer);
+    if (close_writer(writer) != 0) {
+        perror("Could not write the records");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(stderr, "%u elections, %d failed\n", batch->nb_jobs, failed);
+    // The events name the files of the jobs, freed with the batch
+    if (traceFile != NULL)
+        save_trace(&trace, traceFile);
+    delete_batch(batch);
+}
 
 int main(int argc, char **argv) {
     int opt;
     char *inputFile = NULL;
     char *outputFile = NULL;
     char *method = NULL;
+    char *weightsFile = NULL;
+    char *cacheDir = NULL;
+    char *summaryFile = NULL;
+    char *batchPath = NULL;
+    char *socketPath = NULL;
+    char *traceFile = NULL;
+    int nb_workers = 0;
+    int nb_resamples = 0;
+    bool show_margins = false;
+    bool show_withdrawals = false;
+    uint64_t seed = 1;
+    int approvals = 1;
+    int seats = 0;
+    enum TruncationPolicy policy = TRUNCATION_ZERO;
     bool is_duel = false;
+    bool is_summary = false;
+    enum OutputFormat format = FORMAT_TEXT;
+    bool show_stats = false;
+    bool count_events = false;
+    bool show_memory = false;
+    Stats stats;
+    PerfCounters perf;
+    MemoryTracker tracker;
+    Trace trace;
 
-    while ((opt = getopt(argc, argv, "i:d:o:m:")) != -1) {
+    static const struct option long_options[] = {
+        {"serve", required_argument, NULL, 'D'},
+        {"stats", no_argument, NULL, 'P'},
+        {"perf-counters", no_argument, NULL, 'H'},
+        {"mem-stats", no_argument, NULL, 'M'},
+        {"trace", required_argument, NULL, 'R'},
+        {"bootstrap", required_argument, NULL, 'B'},
+        {"seed", required_argument, NULL, 'E'},
+        {"margin", no_argument, NULL, 'V'},
+        {"withdrawal", no_argument, NULL, 'W'},
+        {NULL, 0, NULL, 0}};
+    while ((opt = getopt_long(argc, argv, "i:d:T:b:j:o:f:m:k:w:t:s:c:S:",
+                              long_options, NULL)) != -1) {
         switch (opt) {
         case 'i':
             inputFile = optarg;
@@ -25,22 +419,163 @@ int main(int argc, char **argv) {
             inputFile = optarg;
             is_duel = true;
             break;
+        case 'T':
+            inputFile = optarg;
+            is_summary = true;
+            break;
+        case 'b':
+            batchPath = optarg;
+            break;
+        case 'j':
+            nb_workers = atoi(optarg);
+            break;
+        case 'D':
+            socketPath = optarg;
+            break;
+        case 'P':
+            if (!STATS_ENABLED) {
+                fprintf(stderr, "Built without VOTING_STATS, no --stats\n");
+                exit(EXIT_FAILURE);
+            }
+            show_stats = true;
+            break;
+        case 'H':
+            if (!STATS_ENABLED) {
+                fprintf(stderr,
+                        "Built without VOTING_STATS, no --perf-counters\n");
+                exit(EXIT_FAILURE);
+            }
+            count_events = true;
+            break;
+        case 'M':
+            show_memory = true;
+            break;
+        case 'R':
+            if (!STATS_ENABLED) {
+                fprintf(stderr, "Built without VOTING_STATS, no --trace\n");
+                exit(EXIT_FAILURE);
+            }
+            traceFile = optarg;
+            break;
+        case 'B':
+            nb_resamples = atoi(optarg);
+            if (nb_resamples <= 0) {
+                fprintf(stderr, "Number of resamples must be positive\n");
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'E':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'V':
+            show_margins = true;
+            break;
+        case 'W':
+            show_withdrawals = true;
+            break;
         case 'o':
             outputFile = optarg;
             break;
+        case 'f':
+            if (parse_output_format(optarg, &format) != 0) {
+                fprintf(stderr, "Invalid output format: %s\n", optarg);
+                exit(EXIT_FAILURE);
+            }
+            break;
         case 'm':
             method = optarg;
             break;
+        case 'k':
+            approvals = atoi(optarg);
+            break;
+        case 'w':
+            weightsFile = optarg;
+            break;
+        case 's':
+            seats = atoi(optarg);
+            break;
+        case 'c':
+            cacheDir = optarg;
+            break;
+        case 'S':
+            summaryFile = optarg;
+            break;
+        case 't':
+            if (strcmp(optarg, "zero") == 0)
+                policy = TRUNCATION_ZERO;
+            else if (strcmp(optarg, "average") == 0)
+                policy = TRUNCATION_AVERAGE;
+            else if (strcmp(optarg, "ignore") == 0)
+                policy = TRUNCATION_IGNORE;
+            else {
+                fprintf(stderr, "Invalid truncation policy: %s\n", optarg);
+                exit(EXIT_FAILURE);
+            }
+            break;
         default:
             fprintf(stderr,
-                    "Usage: %s [-i inputfile] [-o outputfile] [-m method]\n",
+                    "Usage: %s [-i inputfile | -d duelfile | -T summary | "
+                    "-b directory|manifest [-j workers]] [-o outputfile] "
+                    "[-f text|csv|json|binary] "
+                    "[-m method] [-k approvals] [-w weightsfile] "
+                    "[-t zero|average|ignore] [-s seats] "
+                    "[-c cachedir] [-S summaryfile] [--serve socket] "
+                    "[--stats] [--perf-counters] [--mem-stats] "
+                    "[--trace tracefile] "
+                    "[--bootstrap resamples [--seed seed] [-j workers]] "
+                    "[--margin [-j workers]] "
+                    "[--withdrawal [-j workers]]\n",
                     argv[0]);
             exit(EXIT_FAILURE);
         }
     }
 
+    if (socketPath != NULL) {
+        if (serve_elections(socketPath) != 0) {
+            perror("Could not serve on the socket");
+            exit(EXIT_FAILURE);
+        }
+        return 0;
+    }
+
+    if (batchPath != NULL) {
+        if (!method) {
+            fprintf(stderr, "Batch mode requires a method\n");
+            exit(EXIT_FAILURE);
+        }
+        ElectionOptions options;
+        init_election_options(&options, str_to_enum(method));
+        options.approvals = approvals;
+        options.policy = policy;
+        run_batch_mode(batchPath, method, &options, cacheDir, outputFile,
+                       format, nb_workers, traceFile);
+        return 0;
+    }
+
+    // Everything the election allocates comes from one arena, freed at once
+    ptrArena arena = init_arena(ARENA_BLOCK_SIZE);
+    if (arena == NULL) {
+        fprintf(stderr, "Could not allocate the arena\n");
+        exit(EXIT_FAILURE);
+    }
+    set_thread_allocator(get_arena_allocator(arena));
+    // The tracker sits over the arena, counting what each library takes
+    if (show_memory) {
+        init_memory_tracker(&tracker, get_arena_allocator(arena));
+        set_thread_allocator(get_tracking_allocator(&tracker));
+    }
+
+    // The results go to the output file, or to the standard output where
+    // the messages around them must not break a machine-readable format
+    ptrWriter out = open_writer(outputFile, format);
+    if (out == NULL) {
+        perror("Could not open the output file");
+        exit(EXIT_FAILURE);
+    }
+    FILE *info = outputFile || format == FORMAT_TEXT ? stdout : stderr;
+
     int nb_candidates;
-    printf("Enter the number of candidates: ");
+    fprintf(info, "Enter the number of candidates: ");
     if (scanf("%d", &nb_candidates) != 1) {
         perror("scanf failed");
         exit(EXIT_FAILURE);
@@ -55,99 +590,158 @@ int main(int argc, char **argv) {
         exit(EXIT_FAILURE);
     }
 
-    printf("Input file: %s\n", inputFile);
-    printf("Output file: %s\n", outputFile ? outputFile : "None");
-    printf("Method: %s\n", method);
+    fprintf(info, "Input file: %s\n", inputFile);
+    fprintf(info, "Output file: %s\n", outputFile ? outputFile : "None");
+    fprintf(info, "Method: %s\n", method);
+
+    // Without counters, for lack of hardware support or of permission, only
+    // the timings are left
+    if (count_events && open_perf_counters(&perf) == 0) {
+        fprintf(stderr, "Hardware counters unavailable: %s\n",
+                strerror(errno));
+        count_events = false;
+    }
+
+    // The clock starts once the number of candidates has been typed
+    if (traceFile != NULL) {
+        init_trace(&trace);
+        attach_trace_thread(&trace, "main");
+    }
+    if (show_stats || count_events) {
+        reset_stats(&stats);
+        if (count_events)
+            attach_perf_counters(&stats, &perf);
+        set_thread_stats(&stats);
+    }
 
     enum Method method_enum = str_to_enum(method);
-    Matrix *matrix;
-    CandidateScore *ranked_pairs_winners, *majority_judgement_winners;
-    int *winners, resultSize, winner;
+    Matrix *matrix = NULL;
+    ptrTallies tallies = NULL;
+    CandidateScore *ranked_pairs_winners, *majority_judgement_winners,
+        *median_ranking;
+    int winner;
+    char note[64];
+    ScoringRule rules[4];
+    int nb_rules = 0;
+    SmithWinners smith_winners;
 
+    // The two-round count reads the ballot file, every other method the
+    // tallies, ALL both
+    bool reads_csv = method_enum == UNI2 || method_enum == ALL ||
+                     method_enum == UNKNOWN;
+    bool reads_tallies = method_enum != UNI2 && method_enum != UNKNOWN;
+    if (is_summary && reads_csv) {
+        fprintf(stderr, "%s cannot run on a tally summary\n", method);
+        exit(EXIT_FAILURE);
+    }
+    // Resamples are counted from the ballots, whatever the method reads
+    ElectionOptions options;
+    init_election_options(&options, method_enum);
+    options.approvals = approvals;
+    options.policy = policy;
+    if (nb_resamples > 0 && (is_duel || is_summary)) {
+        fprintf(stderr, "--bootstrap needs the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+    if (nb_resamples > 0 && !can_bootstrap(&options)) {
+        fprintf(stderr, "%s cannot be bootstrapped\n", method);
+        exit(EXIT_FAILURE);
+    }
+    if (show_margins && (is_duel || is_summary)) {
+        fprintf(stderr, "--margin needs the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!is_duel &&
+        (reads_tallies || nb_resamples > 0 || show_margins || show_withdrawals))
+        tallies = load_election(inputFile, nb_candidates, cacheDir,
+                                is_summary, info);
+    if (summaryFile != NULL) {
+        ptrTallySummary summary = init_tally_summary();
+        if (tallies == NULL || summary == NULL ||
+            set_summary_from_tallies(summary, tallies) != 0 ||
+            write_tally_summary(summary, summaryFile) != 0) {
+            fprintf(stderr, "Could not write the tally summary %s\n",
+                    summaryFile);
+            exit(EXIT_FAILURE);
+        }
+        delete_tally_summary(summary);
+    }
+
+    STATS_BEGIN(PHASE_METHOD);
     switch (method_enum) {
     case UNI1:
+    case UNI2:
         if (is_duel) {
             fprintf(stderr,
                     "First Past The Post is not compatible with duels\n");
             exit(EXIT_FAILURE);
         }
-        matrix = init_matrix(false);
-        set_matrix_from_file(matrix, inputFile, nb_candidates);
-        print_matrix(matrix, " | ");
-        matrix =
-            first_past_the_post_one_round_results(inputFile, nb_candidates);
-        winners = get_candidates_for_next_round(matrix->data[matrix->rows - 1],
-                                                matrix->columns, &resultSize);
-        print_matrix(matrix, " | ");
-        for (int i = 0; i < resultSize; i++) {
-            print_stringbuffer(matrix->tags[winners[i]], STDOUT_AS_LIST, " | ");
-        }
-        break;
-    case UNI2:
-        if (is_duel) {
-            fprintf(stderr,
-                    "First Past The Post is not compatible with duels\n");
+        emit_ballot_matrix(out, is_summary ? NULL : inputFile, nb_candidates);
+        matrix = method_enum == UNI1
+                     ? first_choice_results(tallies)
+                     : first_past_the_post_two_round_results(inputFile,
+                                                             nb_candidates);
+        if (matrix == NULL) {
+            fprintf(stderr, "Could not count the ballots of %s\n",
+                    inputFile);
             exit(EXIT_FAILURE);
         }
-        matrix = init_matrix(false);
-        set_matrix_from_file(matrix, inputFile, nb_candidates);
-        print_matrix(matrix, " | ");
-        matrix =
-            first_past_the_post_two_round_results(inputFile, nb_candidates);
-        winners = get_candidates_for_next_round(matrix->data[matrix->rows - 1],
-                                                matrix->columns, &resultSize);
-        for (int i = 0; i < resultSize; i++) {
-            print_stringbuffer(matrix->tags[winners[i]], STDOUT_AS_LIST, " | ");
+        if (method_enum == UNI1) {
+            emit_matrix(out, matrix, " | ");
+            print_leaders(out, matrix, "First past the post");
+        } else {
+            print_leaders(out, matrix, "Two-round");
         }
+        delete_matrix(matrix);
+        matrix = NULL;
         break;
     case CM:
-        matrix = init_matrix(true);
-        if (is_duel)
+        if (is_duel) {
+            matrix = init_matrix(true);
             set_matrix_from_file(matrix, inputFile, nb_candidates);
-        else
-            set_duel_from_file(matrix, inputFile, nb_candidates);
+        } else {
+            matrix = tallies->duel;
+        }
         if (find_condorcet_winner(matrix, nb_candidates, &winner)) {
-            printf("\nCondorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
-            printf("\n");
+            emit_winner(out, "Condorcet", winner,
+                        matrix->tags[winner]->string);
         } else {
-            printf("\nNo Condorcet winner found.\n\nTrying with Minimax...\n");
+            emit_note(out, "No Condorcet winner found.\n\n"
+                           "Trying with Minimax...");
             winner = find_minimax_condorcet_winner(matrix, nb_candidates);
-            printf("\nMinimax Condorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
+            emit_winner(out, "Minimax Condorcet", winner,
+                        matrix->tags[winner]->string);
         }
         break;
     case CP:
-        matrix = init_matrix(true);
-        if (is_duel)
+        if (is_duel) {
+            matrix = init_matrix(true);
             set_matrix_from_file(matrix, inputFile, nb_candidates);
-        else
-            set_duel_from_file(matrix, inputFile, nb_candidates);
+        } else {
+            matrix = tallies->duel;
+        }
         ranked_pairs_winners =
             find_ranked_pairs_condorcet_winner(matrix, nb_candidates);
-        printf("\n%20s | %s\n", "Candidate", "Score");
-        printf("%20s-|-%s\n", "-------------------", "-----");
-        for (int i = 0; i < nb_candidates; i++) {
-            printf("%20s | ",
-                   matrix->tags[ranked_pairs_winners[i].candidate]->string);
-            printf(" %d\n", ranked_pairs_winners[i].score);
-        }
+        print_ranking(out, matrix->tags, "Score", ranked_pairs_winners,
+                      nb_candidates);
+        mem_free(ranked_pairs_winners);
         break;
     case CS:
-        matrix = init_matrix(true);
-        if (is_duel)
+        if (is_duel) {
+            matrix = init_matrix(true);
             set_matrix_from_file(matrix, inputFile, nb_candidates);
-        else
-            set_duel_from_file(matrix, inputFile, nb_candidates);
+        } else {
+            matrix = tallies->duel;
+        }
         if (find_condorcet_winner(matrix, nb_candidates, &winner)) {
-            printf("\nCondorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
-            printf("\n");
+            emit_winner(out, "Condorcet", winner,
+                        matrix->tags[winner]->string);
         } else {
-            printf("\nNo Condorcet winner found.\n\nTrying with Schulze...\n");
+            emit_note(out, "No Condorcet winner found.\n\n"
+                           "Trying with Schulze...");
             winner = find_schulze_condorcet_winner(matrix, nb_candidates);
-            printf("\nSchulze Condorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
+            emit_winner(out, "Schulze Condorcet", winner,
+                        matrix->tags[winner]->string);
         }
         break;
     case JM:
@@ -156,62 +750,215 @@ int main(int argc, char **argv) {
                     "Majority Judgement is not compatible with duels\n");
             exit(EXIT_FAILURE);
         }
-        matrix = init_matrix(false);
-        set_matrix_from_file(matrix, inputFile, nb_candidates);
         majority_judgement_winners =
-            find_majority_judgement_winner(matrix, nb_candidates);
-        printf("\n%20s | %s\n", "Candidate", "Score");
-        printf("%20s-|-%s\n", "-------------------", "-----");
-        for (int i = 0; i < nb_candidates; i++) {
-            printf(
-                "%20s | ",
-                matrix->tags[majority_judgement_winners[i].candidate]->string);
-            printf(" %d\n", majority_judgement_winners[i].score);
+            majority_judgement_ranking(tallies->histogram);
+        print_ranking(out, tallies->ballots->tags, "Grade",
+                      majority_judgement_winners, nb_candidates);
+        mem_free(majority_judgement_winners);
+        break;
+    case BORDA:
+    case DOWDALL:
+    case APPROVAL:
+    case SCORING:
+        if (is_duel) {
+            fprintf(stderr, "Scoring rules are not compatible with duels\n");
+            exit(EXIT_FAILURE);
+        }
+        if (method_enum == BORDA || method_enum == SCORING)
+            set_borda_rule(&rules[nb_rules++], nb_candidates);
+        if (method_enum == DOWDALL || method_enum == SCORING)
+            set_dowdall_rule(&rules[nb_rules++], nb_candidates);
+        if (method_enum == APPROVAL || method_enum == SCORING)
+            set_approval_rule(&rules[nb_rules++], nb_candidates, approvals);
+        if (method_enum == SCORING && weightsFile != NULL &&
+            set_rule_from_file(&rules[nb_rules++], weightsFile) != 0) {
+            fprintf(stderr, "Invalid weights file: %s\n", weightsFile);
+            exit(EXIT_FAILURE);
+        }
+        // Every rule is computed in the same pass over the ballots
+        if (policy != TRUNCATION_ZERO)
+            require_ballots(tallies, "Truncation policy");
+        print_scoring_rules(out, tallies, rules, nb_rules, policy);
+        break;
+    case BUCKLIN:
+    case MEDIAN:
+        if (is_duel) {
+            fprintf(stderr, "Bucklin is not compatible with duels\n");
+            exit(EXIT_FAILURE);
+        }
+        // The ballots are read once, every round works on the histogram
+        if (method_enum == BUCKLIN) {
+            int round = 0;
+            winner = find_bucklin_winner(tallies->histogram, &round);
+            if (round > 0)
+                snprintf(note, sizeof(note), "Majority reached at round %d",
+                         round);
+            else
+                snprintf(note, sizeof(note), "No majority reached, most "
+                                             "ranked candidate elected");
+            emit_note(out, note);
+            emit_winner(out, "Bucklin", winner,
+                        tallies->ballots->tags[winner]->string);
+        } else {
+            median_ranking = median_rank_ranking(tallies->histogram);
+            print_ranking(out, tallies->ballots->tags, "Median rank",
+                          median_ranking, nb_candidates);
+            mem_free(median_ranking);
+        }
+        break;
+    case BALDWIN:
+    case NANSON:
+        if (is_duel) {
+            matrix = init_matrix(true);
+            set_matrix_from_file(matrix, inputFile, nb_candidates);
+        } else {
+            matrix = tallies->duel;
+        }
+        if (method_enum == BALDWIN)
+            winner = find_baldwin_winner(matrix, nb_candidates);
+        else
+            winner = find_nanson_winner(matrix, nb_candidates);
+        emit_winner(out, method_enum == BALDWIN ? "Baldwin" : "Nanson",
+                    winner, matrix->tags[winner]->string);
+        break;
+    case COOMBS:
+        if (is_duel) {
+            fprintf(stderr, "Coombs is not compatible with duels\n");
+            exit(EXIT_FAILURE);
+        }
+        require_ballots(tallies, "Coombs");
+        winner = find_coombs_winner(tallies->ballots);
+        emit_winner(out, "Coombs", winner,
+                    tallies->ballots->tags[winner]->string);
+        break;
+    case SMITH_IRV:
+    case TIDEMAN:
+    case WOODALL:
+        if (is_duel) {
+            fprintf(stderr, "Smith hybrids are not compatible with duels\n");
+            exit(EXIT_FAILURE);
+        }
+        require_ballots(tallies, "Instant-runoff");
+        if (find_smith_hybrid_winners(tallies->duel, tallies->ballots,
+                                      &smith_winners) != 0) {
+            fprintf(stderr, "Could not count the ballots of %s\n", inputFile);
+            exit(EXIT_FAILURE);
+        }
+        if (method_enum == SMITH_IRV)
+            emit_winner(out, "Smith//IRV", smith_winners.smith_irv,
+                        tallies->ballots->tags[smith_winners.smith_irv]
+                            ->string);
+        else if (method_enum == TIDEMAN)
+            emit_winner(out, "Tideman's Alternative", smith_winners.tideman,
+                        tallies->ballots->tags[smith_winners.tideman]
+                            ->string);
+        else
+            emit_winner(out, "Woodall", smith_winners.woodall,
+                        tallies->ballots->tags[smith_winners.woodall]
+                            ->string);
+        break;
+    case DHONDT:
+    case SAINTE_LAGUE:
+    case HARE:
+    case DROOP:
+        if (is_duel) {
+            fprintf(stderr, "Seat allocation is not compatible with duels\n");
+            exit(EXIT_FAILURE);
         }
+        if (seats <= 0) {
+            fprintf(stderr, "Number of seats must be positive\n");
+            exit(EXIT_FAILURE);
+        }
+        print_seats(out, tallies, seats,
+                    method_enum == DHONDT         ? SEATS_DHONDT
+                    : method_enum == SAINTE_LAGUE ? SEATS_SAINTE_LAGUE
+                    : method_enum == HARE         ? SEATS_HARE
+                                                  : SEATS_DROOP);
         break;
     case ALL:
-        matrix = init_matrix(true);
         if (!is_duel) {
-            set_matrix_from_file(matrix, inputFile, nb_candidates);
-            print_matrix(matrix, " | ");
+            emit_ballot_matrix(out, inputFile, nb_candidates);
             matrix =
                 first_past_the_post_two_round_results(inputFile, nb_candidates);
-            winners = get_candidates_for_next_round(
-                matrix->data[matrix->rows - 1], matrix->columns, &resultSize);
-            for (int i = 0; i < resultSize; i++) {
-                print_stringbuffer(matrix->tags[winners[i]], STDOUT_AS_LIST,
-                                   " | ");
+            if (matrix == NULL) {
+                fprintf(stderr, "Could not count the ballots of %s\n",
+                        inputFile);
+                exit(EXIT_FAILURE);
             }
-            set_duel_from_file(matrix, inputFile, nb_candidates);
-        } else
+            print_leaders(out, matrix, "Two-round");
+            delete_matrix(matrix);
+            matrix = tallies->duel;
+        } else {
+            matrix = init_matrix(true);
             set_matrix_from_file(matrix, inputFile, nb_candidates);
+        }
         if (find_condorcet_winner(matrix, nb_candidates, &winner)) {
-            printf("\nCondorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
-            printf("\n");
+            emit_winner(out, "Condorcet", winner,
+                        matrix->tags[winner]->string);
         } else {
-            printf("\nNo Condorcet winner found.\n\nTrying with Other "
-                   "Methods...\n");
+            emit_note(out, "No Condorcet winner found.\n\n"
+                           "Trying with Other Methods...");
             winner = find_minimax_condorcet_winner(matrix, nb_candidates);
-            printf("\nMinimax Condorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
+            emit_winner(out, "Minimax Condorcet", winner,
+                        matrix->tags[winner]->string);
             winner = find_schulze_condorcet_winner(matrix, nb_candidates);
-            printf("\nSchulze Condorcet winner is candidate : ");
-            print_stringbuffer(matrix->tags[winner], STDOUT, "");
+            emit_winner(out, "Schulze Condorcet", winner,
+                        matrix->tags[winner]->string);
         }
         ranked_pairs_winners =
             find_ranked_pairs_condorcet_winner(matrix, nb_candidates);
-        printf("\n%20s | %s\n", "Candidate", "Score");
-        printf("%20s-|-%s\n", "-------------------", "-----");
-        for (int i = 0; i < nb_candidates; i++) {
-            printf("%20s | ",
-                   matrix->tags[ranked_pairs_winners[i].candidate]->string);
-            printf(" %d\n", ranked_pairs_winners[i].score);
-        }
+        print_ranking(out, matrix->tags, "Score", ranked_pairs_winners,
+                      nb_candidates);
+        mem_free(ranked_pairs_winners);
         break;
     case UNKNOWN:
         fprintf(stderr, "Invalid method: %s\n", method);
         exit(EXIT_FAILURE);
     }
+    if (nb_resamples > 0)
+        print_bootstrap(out, tallies, &options, nb_resamples, seed,
+                        nb_workers);
+    if (show_margins)
+        print_margins(out, tallies, nb_workers);
+    // The duel matrix a method read is reused, so is that of the tallies
+    if (show_withdrawals) {
+        ptrMatrix duel = matrix != NULL && matrix->is_duel ? matrix
+                         : tallies != NULL                  ? tallies->duel
+                                                            : NULL;
+        if (duel == NULL || nb_candidates < 2) {
+            fprintf(stderr, "--withdrawal needs a duel matrix of at least "
+                            "2 candidates\n");
+            exit(EXIT_FAILURE);
+        }
+        print_withdrawals(out, duel, nb_candidates, nb_workers);
+    }
+    STATS_END(PHASE_METHOD);
+    // The duel of the tallies is theirs, any other matrix is the method's
+    if (tallies == NULL || matrix != tallies->duel)
+        delete_matrix(matrix);
+    delete_tallies(tallies);
+    if (show_stats || count_events) {
+        flush_writer(out);
+        set_thread_stats(NULL);
+    }
+    if (show_stats)
+        emit_stats(out, &stats);
+    if (count_events) {
+        emit_perf_stats(out, &stats);
+        close_perf_counters(&perf);
+    }
+    // Only the writer should be left alive by then
+    if (show_memory)
+        emit_memory_stats(out, &tracker);
+    if (close_writer(out) != 0) {
+        perror("Could not write the results");
+        exit(EXIT_FAILURE);
+    }
+    if (traceFile != NULL) {
+        detach_trace_thread();
+        save_trace(&trace, traceFile);
+    }
+    set_thread_allocator(NULL);
+    delete_arena(arena);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Bucklin and Median Rank Methods
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "bucklin.h"
+#include "allocator.h"
+#include "histogram.h"
+#include <stdlib.h>
+
+/*-----------------------------------------------------------------*/
+
+int find_bucklin_winner(const Histogram *ranks, int *round) {
+    if (ranks == NULL || ranks->rows == 0)
+        return -1;
+    uint totals[MAX_TAB] = {0};
+    int winner = 0;
+    for (uint r = 1; r < ranks->columns; r++) {
+        // One more rank per round, the ballots are never read again
+        winner = 0;
+        for (uint c = 0; c < ranks->rows; c++) {
+            totals[c] += ranks->counts[c][r];
+            if (totals[c] > totals[winner])
+                winner = c;
+        }
+        if (totals[winner] * 2 > ranks->ballots) {
+            if (round != NULL)
+                *round = r;
+            return winner;
+        }
+    }
+    if (round != NULL)
+        *round = -1;
+    return winner;
+}
+
+void get_median_ranks(const Histogram *ranks, int *medians) {
+    for (uint c = 0; c < ranks->rows; c++) {
+        uint total = 0;
+        medians[c] = -1;
+        for (uint r = 1; r < ranks->columns; r++) {
+            total += ranks->counts[c][r];
+            if (total * 2 > ranks->ballots) {
+                medians[c] = r;
+                break;
+            }
+        }
+    }
+}
+
+static bool has_better_median(int first_median, uint first_total,
+                              int second_median, uint second_total) {
+    if (first_median != second_median) {
+        return second_median == -1 ||
+               (first_median != -1 && first_median < second_median);
+    }
+    return first_total > second_total;
+}
+
+CandidateScore *median_rank_ranking(const Histogram *ranks) {
+    int nb_candidates = ranks->rows;
+    CandidateScore *ranking = mem_alloc(sizeof(CandidateScore) * nb_candidates);
+    if (ranking == NULL)
+        return NULL;
+
+    int medians[MAX_TAB];
+    uint totals[MAX_TAB];
+    get_median_ranks(ranks, medians);
+    for (int c = 0; c < nb_candidates; c++) {
+        totals[c] = get_histogram_prefix(
+            ranks, c, medians[c] == -1 ? ranks->columns : (uint)medians[c]);
+    }
+
+    // Insertion sort, ties keep the candidates order
+    for (int i = 0; i < nb_candidates; i++) {
+        int j = i;
+        while (j > 0) {
+            int previous = ranking[j - 1].candidate;
+            if (!has_better_median(medians[i], totals[i], medians[previous],
+                                   totals[previous]))
+                break;
+            ranking[j] = ranking[j - 1];
+            j--;
+        }
+        ranking[j].candidate = i;
+        ranking[j].score = medians[i];
+    }
+    return ranking;
+}
@@ -0,0 +1,60 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Bucklin and Median Rank Methods
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef BUCKLIN_H
+#define BUCKLIN_H
+
+#include "ballots.h"
+#include "histogram.h"
+#include "miscellaneous.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Finds the Bucklin winner from a rank-position histogram.
+ *
+ * Round r counts, for every candidate, the ballots ranking it r-th or better.
+ * The first round where someone is ranked that high by a strict majority of
+ * the ballots elects the candidate with the most such ballots. Each round only
+ * adds one histogram column to running totals, so the whole count is O(C * R)
+ * once the histogram exists. When truncated ballots prevent any majority, the
+ * candidate with the most ranked ballots wins.
+ *
+ * @param[in] ranks The rank histogram of the election.
+ * @param[out] round The deciding round, -1 when no round reached a
+ *                   majority, may be NULL.
+ * @return The index of the winner, -1 if there are no candidates.
+ */
+int find_bucklin_winner(const Histogram *ranks, int *round);
+
+/**
+ * @brief Finds the median rank of every candidate.
+ *
+ * The median rank is the best rank r such that a strict majority of the
+ * ballots rank the candidate r-th or better.
+ *
+ * @param[in] ranks The rank histogram of the election.
+ * @param[out] medians One median rank per candidate, -1 when no majority ranks
+ *                     the candidate at all.
+ */
+void get_median_ranks(const Histogram *ranks, int *medians);
+
+/**
+ * @brief Ranks candidates by median rank.
+ *
+ * Candidates with the best median rank come first, ties being broken by the
+ * number of ballots ranking them at their median rank or better. The first
+ * candidate is the Bucklin winner.
+ *
+ * @param[in] ranks The rank histogram of the election.
+ * @return The candidates, best first, each with its median rank as score. To
+ * be freed by the caller.
+ */
+CandidateScore *median_rank_ranking(const Histogram *ranks);
+
+#endif // BUCKLIN_H
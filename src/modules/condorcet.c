@@ -7,6 +7,7 @@
 /*-----------------------------------------------------------------*/
 
 #include "condorcet.h"
+#include "allocator.h"
 #include "matrix.h"
 #include "stdbool.h"
 #include <limits.h>
@@ -63,7 +64,7 @@ int find_minimax_condorcet_winner(ptrMatrix duel, int nb_candidates) {
 CandidateScore *find_ranked_pairs_condorcet_winner(ptrMatrix duel,
                                                    int nb_candidates) {
     CandidateScore *candidates_scores =
-        malloc(sizeof(CandidateScore) * nb_candidates);
+        mem_alloc(sizeof(CandidateScore) * nb_candidates);
 
     for (int i = 0; i < nb_candidates; i++) {
         candidates_scores[i].candidate = i;
@@ -93,60 +94,62 @@ CandidateScore *find_ranked_pairs_condorcet_winner(ptrMatrix duel,
 
 /*-----------------------------------------------------------------*/
 
-int find_schulze_condorcet_winner(ptrMatrix duel, int nb_candidates) {
-    int **schulze_matrix = malloc(sizeof(int *) * nb_candidates);
+void init_schulze_paths(ptrMatrix duel, int nb_candidates, int *paths) {
     for (int i = 0; i < nb_candidates; i++) {
-        schulze_matrix[i] = malloc(sizeof(int) * nb_candidates);
         for (int j = 0; j < nb_candidates; j++) {
-            schulze_matrix[i][j] = duel->data[i][j];
+            bool wins = i != j && duel->data[i][j] > duel->data[j][i];
+            paths[i * nb_candidates + j] = wins ? duel->data[i][j] : 0;
         }
     }
+}
 
-    for (int i = 0; i < nb_candidates; i++) {
-        for (int j = 0; j < nb_candidates; j++) {
-            if (i != j) {
-                for (int k = 0; k < nb_candidates; k++) {
-                    if (i != k && j != k) {
-                        schulze_matrix[j][k] =
-                            schulze_matrix[j][k] >
-                                    schulze_matrix[j][i] + schulze_matrix[i][k]
-                                ? schulze_matrix[j][k]
-                                : schulze_matrix[j][i] + schulze_matrix[i][k];
-                    }
-                }
-            }
-        }
-    }
-
-    int *candidates_scores = malloc(sizeof(int) * nb_candidates);
-    for (int i = 0; i < nb_candidates; i++) {
-        candidates_scores[i] = 0;
-    }
-
-    for (int i = 0; i < nb_candidates; i++) {
+void widen_schulze_paths(int *paths, int nb_candidates, int first, int last) {
+#define PATH(i, j) paths[(i) * nb_candidates + (j)]
+    for (int i = first; i < last; i++) {
         for (int j = 0; j < nb_candidates; j++) {
-            if (i != j) {
-                if (schulze_matrix[i][j] > schulze_matrix[j][i]) {
-                    candidates_scores[i]++;
-                }
+            if (i == j || PATH(j, i) == 0)
+                continue;
+            for (int k = 0; k < nb_candidates; k++) {
+                if (i == k || j == k)
+                    continue;
+                // A path is as strong as its weakest duel
+                int through = PATH(j, i) < PATH(i, k) ? PATH(j, i) : PATH(i, k);
+                if (through > PATH(j, k))
+                    PATH(j, k) = through;
             }
         }
     }
+#undef PATH
+}
 
+int find_schulze_path_winner(const int *paths, int nb_candidates,
+                             int withdrawn) {
     int schulze_winner = -1;
     int schulze_score = INT_MIN;
     for (int i = 0; i < nb_candidates; i++) {
-        if (candidates_scores[i] > schulze_score) {
-            schulze_score = candidates_scores[i];
+        if (i == withdrawn)
+            continue;
+        int score = 0;
+        for (int j = 0; j < nb_candidates; j++) {
+            if (i != j && j != withdrawn &&
+                paths[i * nb_candidates + j] > paths[j * nb_candidates + i])
+                score++;
+        }
+        if (score > schulze_score) {
+            schulze_score = score;
             schulze_winner = i;
         }
     }
+    return schulze_winner;
+}
 
-    for (int i = 0; i < nb_candidates; i++) {
-        free(schulze_matrix[i]);
-    }
-    free(schulze_matrix);
-    free(candidates_scores);
-
+int find_schulze_condorcet_winner(ptrMatrix duel, int nb_candidates) {
+    int *paths = mem_alloc(sizeof(int) * nb_candidates * nb_candidates);
+    if (paths == NULL)
+        return -1;
+    init_schulze_paths(duel, nb_candidates, paths);
+    widen_schulze_paths(paths, nb_candidates, 0, nb_candidates);
+    int schulze_winner = find_schulze_path_winner(paths, nb_candidates, -1);
+    mem_free(paths);
     return schulze_winner;
-}
\ No newline at end of file
+}
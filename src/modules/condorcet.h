@@ -22,4 +22,42 @@ CandidateScore *find_ranked_pairs_condorcet_winner(ptrMatrix duel,
 
 int find_schulze_condorcet_winner(ptrMatrix duel, int nb_candidates);
 
+/**
+ * @brief Sets the Schulze paths through no other candidate: the votes of
+ * each duel won, 0 for a duel lost or tied.
+ *
+ * @param[in] duel The duel matrix of the election.
+ * @param[in] nb_candidates Number of candidates.
+ * @param[out] paths nb_candidates rows of nb_candidates path strengths.
+ */
+void init_schulze_paths(ptrMatrix duel, int nb_candidates, int *paths);
+
+/**
+ * @brief Lets the Schulze paths go through the candidates from `first` to
+ * `last` excluded.
+ *
+ * A path is as strong as its weakest duel and the strongest one is kept, so
+ * widening through every candidate, in any order and in as many calls as
+ * needed, gives the strongest paths. Paths widened through all but one
+ * candidate are those of the election it withdrew from.
+ *
+ * @param[in,out] paths The path strengths.
+ * @param[in] nb_candidates Number of candidates.
+ * @param[in] first The first candidate to go through.
+ * @param[in] last The candidate after the last one.
+ */
+void widen_schulze_paths(int *paths, int nb_candidates, int first, int last);
+
+/**
+ * @brief Finds the candidate with the most stronger paths than the reverse
+ * ones, the first among ties.
+ *
+ * @param[in] paths The strongest paths.
+ * @param[in] nb_candidates Number of candidates.
+ * @param[in] withdrawn A candidate left out, -1 for none.
+ * @return The Schulze winner.
+ */
+int find_schulze_path_winner(const int *paths, int nb_candidates,
+                             int withdrawn);
+
 #endif // CONDORCET_H
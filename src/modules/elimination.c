@@ -0,0 +1,135 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Elimination Methods
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "elimination.h"
+#include "matrix.h"
+#include "piles.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+/*-----------------------------------------------------------------*/
+
+static void init_borda_scores(ptrMatrix duel, int nb_candidates,
+                              long *scores) {
+    for (int i = 0; i < nb_candidates; i++) {
+        scores[i] = 0;
+        for (int j = 0; j < nb_candidates; j++) {
+            if (i != j)
+                scores[i] += duel->data[i][j];
+        }
+    }
+}
+
+/**
+ * @brief Removes a candidate and its duels from the scores of the others.
+ */
+static void remove_candidate(ptrMatrix duel, int nb_candidates, long *scores,
+                             bool *continuing, int candidate) {
+    continuing[candidate] = false;
+    for (int i = 0; i < nb_candidates; i++) {
+        if (continuing[i])
+            scores[i] -= duel->data[i][candidate];
+    }
+}
+
+static int first_continuing(const bool *continuing, int nb_candidates) {
+    for (int i = 0; i < nb_candidates; i++) {
+        if (continuing[i])
+            return i;
+    }
+    return -1;
+}
+
+int find_baldwin_winner(ptrMatrix duel, int nb_candidates) {
+    long scores[MAX_TAB];
+    bool continuing[MAX_TAB];
+    init_borda_scores(duel, nb_candidates, scores);
+    for (int i = 0; i < nb_candidates; i++)
+        continuing[i] = true;
+
+    for (int remaining = nb_candidates; remaining > 1; remaining--) {
+        int loser = -1;
+        for (int i = 0; i < nb_candidates; i++) {
+            if (continuing[i] && (loser == -1 || scores[i] <= scores[loser]))
+                loser = i;
+        }
+        remove_candidate(duel, nb_candidates, scores, continuing, loser);
+    }
+    return first_continuing(continuing, nb_candidates);
+}
+
+int find_nanson_winner(ptrMatrix duel, int nb_candidates) {
+    long scores[MAX_TAB];
+    bool continuing[MAX_TAB];
+    init_borda_scores(duel, nb_candidates, scores);
+    for (int i = 0; i < nb_candidates; i++)
+        continuing[i] = true;
+
+    int remaining = nb_candidates;
+    while (remaining > 1) {
+        // Below average means score * remaining < sum of scores
+        long total = 0;
+        for (int i = 0; i < nb_candidates; i++) {
+            if (continuing[i])
+                total += scores[i];
+        }
+        int losers[MAX_TAB], nb_losers = 0;
+        for (int i = 0; i < nb_candidates; i++) {
+            if (continuing[i] && scores[i] * remaining < total)
+                losers[nb_losers++] = i;
+        }
+        if (nb_losers == 0)
+            break;
+        // Mark them all first, their duels against each other do not count
+        // for anybody still running
+        for (int k = 0; k < nb_losers; k++)
+            continuing[losers[k]] = false;
+        for (int k = 0; k < nb_losers; k++) {
+            for (int i = 0; i < nb_candidates; i++) {
+                if (continuing[i])
+                    scores[i] -= duel->data[i][losers[k]];
+            }
+        }
+        remaining -= nb_losers;
+    }
+    return first_continuing(continuing, nb_candidates);
+}
+
+int find_coombs_winner(const Ballots *ballots) {
+    if (ballots == NULL || ballots->columns == 0)
+        return -1;
+    ptrPiles firsts = init_piles(ballots, PILE_TOP);
+    ptrPiles lasts = init_piles(ballots, PILE_BOTTOM);
+    if (firsts == NULL || lasts == NULL) {
+        delete_piles(firsts);
+        delete_piles(lasts);
+        return -1;
+    }
+
+    int nb_candidates = ballots->columns, winner = -1;
+    for (int remaining = nb_candidates; winner == -1; remaining--) {
+        uint voting = ballots->rows - firsts->exhausted;
+        int loser = -1;
+        for (int i = 0; i < nb_candidates && winner == -1; i++) {
+            if (!firsts->continuing[i])
+                continue;
+            if (remaining == 1 || firsts->counts[i] * 2 > voting)
+                winner = i;
+            else if (loser == -1 || lasts->counts[i] >= lasts->counts[loser])
+                loser = i;
+        }
+        if (winner == -1) {
+            eliminate_from_piles(firsts, loser);
+            eliminate_from_piles(lasts, loser);
+        }
+    }
+
+    delete_piles(firsts);
+    delete_piles(lasts);
+    return winner;
+}
@@ -0,0 +1,59 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Elimination Methods
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef ELIMINATION_H
+#define ELIMINATION_H
+
+#include "ballots.h"
+#include "matrix.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Finds the Baldwin winner.
+ *
+ * Repeatedly eliminates the candidate with the lowest Borda score, computed
+ * from the duel matrix as the number of duels won by ballot. Scores are not
+ * recomputed after an elimination: the duels against the eliminated candidate
+ * are subtracted from the others, so the whole count is O(C^2). Among tied
+ * lowest scores, the last candidate is eliminated.
+ *
+ * @param[in] duel The duel matrix of the election.
+ * @param[in] nb_candidates Number of candidates.
+ * @return The index of the winner.
+ */
+int find_baldwin_winner(ptrMatrix duel, int nb_candidates);
+
+/**
+ * @brief Finds the Nanson winner.
+ *
+ * Like Baldwin, but every round eliminates all the candidates whose Borda
+ * score is below the average of the continuing candidates. When nobody is
+ * below average the remaining candidates are tied and the first one wins.
+ *
+ * @param[in] duel The duel matrix of the election.
+ * @param[in] nb_candidates Number of candidates.
+ * @return The index of the winner.
+ */
+int find_nanson_winner(ptrMatrix duel, int nb_candidates);
+
+/**
+ * @brief Finds the Coombs winner.
+ *
+ * A candidate ranked first (alone) on a strict majority of the ballots that
+ * still rank someone wins, otherwise the candidate ranked last (alone) on
+ * the most ballots is eliminated. Unranked candidates share the last place.
+ * First and last places are followed by two sets of piles, so an elimination
+ * only revisits the ballots that had the eliminated candidate at either end.
+ *
+ * @param[in] ballots The ballots of the election.
+ * @return The index of the winner, -1 on failure.
+ */
+int find_coombs_winner(const Ballots *ballots);
+
+#endif // ELIMINATION_H
@@ -9,10 +9,28 @@
 #ifndef FIRST_PAST_THE_POST_H
 #define FIRST_PAST_THE_POST_H
 
+#include "ballots.h"
 #include "matrix.h"
 
 /*-----------------------------------------------------------------*/
 
+/**
+ * @brief Index of the first choice of every ballot.
+ *
+ * Ballots are grouped by first choice (a counting sort), so the ballots whose
+ * preferred candidate is eliminated can be visited without scanning the
+ * others. A ballot whose best rank is shared by several candidates, or that
+ * ranks nobody, has no first choice and lands in the last bucket.
+ */
+typedef struct s_first_choice_index {
+    int *first_choices;        /**< Per ballot first choice, -1 if none */
+    uint *order;               /**< Ballot indices grouped by first choice */
+    uint offsets[MAX_TAB + 1]; /**< Bucket c is order[offsets[c]..[c + 1]) */
+    int totals[MAX_TAB];       /**< Number of ballots per first choice */
+    uint rows;                 /**< The number of ballots indexed */
+    uint columns;              /**< The number of candidates */
+} FirstChoiceIndex;
+
 /**
  * @brief Formats the voting data in a matrix for First Past The Post voting.
  *
@@ -56,6 +74,27 @@ void format_votes_with_filter(ptrMatrix matrix, int nb_candidates);
 ptrMatrix first_past_the_post_one_round_results(char *csv_votes,
                                                 int nb_candidates);
 
+/**
+ * @brief Builds the first choice index of a ballot store.
+ *
+ * Uses the same rule as `format_votes_with_filter`: a ballot counts for the
+ * candidate holding its unique best rank. The ranks are read column by column
+ * in a single pass.
+ *
+ * @param[in] ballots The ballots of the election.
+ * @return The index, or NULL if memory allocation fails.
+ *
+ * @post The returned index must be freed with delete_first_choice_index.
+ */
+FirstChoiceIndex *build_first_choice_index(const Ballots *ballots);
+
+/**
+ * @brief Frees a first choice index.
+ *
+ * @param[in] index The index to free, may be NULL.
+ */
+void delete_first_choice_index(FirstChoiceIndex *index);
+
 /**
  * @brief Updates a matrix by setting non-relevant columns to -1.
  *
@@ -86,33 +125,54 @@ ptrMatrix first_past_the_post_one_round_results(char *csv_votes,
 void update_matrix_data(ptrMatrix matrix, const int *keep_columns,
                         int keep_size);
 
+/**
+ * @brief Selects the candidates qualified for the next round.
+ *
+ * @param[in] totals The number of votes of each candidate.
+ * @param[in] size The number of candidates.
+ * @param[out] resultSize 1 if a candidate has an absolute majority, 2
+ *                        otherwise.
+ * @return The indices of the qualified candidates, to be freed by the caller.
+ */
 int *get_candidates_for_next_round(int *totals, int size, int *resultSize);
 
 /**
- * @brief Processes voting data for a two-round first-past-the-post election
- * system using matrices.
- *
- * This function conducts a two-round first-past-the-post election. In the first
- * round, the votes are tallied using the
- * 'first_past_the_post_one_round_results' function. After the first round, the
- * positions of the top candidates (by default, the top 2) are determined based
- * on the totals. The voting data is then re-fetched and filtered to include
- * only these top candidates, and a second round of voting is conducted. The
- * final results, including the vote counts for the second round, are stored in
- * the matrix with an additional row for totals.
+ * @brief Computes a two-round runoff from the original ranks.
+ *
+ * The first round comes straight from the index totals. When nobody holds an
+ * absolute majority, the two finalists keep the ballots that already chose
+ * them and only the buckets of eliminated candidates (and ballots without a
+ * first choice) are revisited to find which finalist they rank better. The
+ * work of the second round is thus proportional to those ballots.
+ *
+ * @param[in] ballots The ballots of the election.
+ * @param[in] index The first choice index built from the same ballots.
+ * @return A matrix whose columns are the candidates, with the first round
+ * totals as first row and, when a second round is needed, its totals as
+ * second row (0 for eliminated candidates).
+ *
+ * @note It is the caller's responsibility to free the allocated matrix.
+ */
+ptrMatrix first_past_the_post_runoff_results(const Ballots *ballots,
+                                             const FirstChoiceIndex *index);
+
+/**
+ * @brief Processes voting data for a two-round first-past-the-post election.
+ *
+ * Loads the ballots of the CSV file, builds their first choice index and runs
+ * `first_past_the_post_runoff_results` on them. The second round is computed
+ * from the original preferences of the voters, not from the first round
+ * filtered matrix.
  *
  * @param[in] csv_votes The path to the CSV file containing the voting data.
  * @param[in] nb_candidates The number of candidates in the election.
- * @return A pointer to a matrix structure containing the final round election
- * results.
+ * @return A pointer to a matrix structure containing the totals of each round,
+ * the last row being the deciding one, or NULL if the file cannot be read.
  *
  * @pre The csv_votes path must point to a readable CSV file in the correct
  * format.
- * @post The returned matrix contains the second round vote count for the top
- * candidates.
  *
- * @note The function assumes that the top 2 candidates from the first round
- * proceed to the second round, but this can be adjusted as needed.
+ * @note It is the caller's responsibility to free the allocated matrix.
  */
 ptrMatrix first_past_the_post_two_round_results(char *csv_votes,
                                                 int nb_candidates);
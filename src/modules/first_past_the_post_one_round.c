@@ -6,6 +6,8 @@
  **/
 /*-----------------------------------------------------------------*/
 
+#include "first_past_the_post.h"
+#include "allocator.h"
 #include "matrix.h"
 #include "miscellaneous.h"
 #include <stdlib.h>
@@ -52,24 +54,88 @@ ptrMatrix first_past_the_post_one_round_results(char *csv_votes,
                                                 int nb_candidates) {
     // Initialize the matrix from the file
     ptrMatrix results = init_matrix(false);
-    set_matrix_from_file(results, csv_votes, nb_candidates);
 
     // Check if matrix initialization was successful
     if (results == NULL) {
         return NULL;
     }
+    if (set_matrix_from_file(results, csv_votes, nb_candidates) != 0) {
+        delete_matrix(results);
+        return NULL;
+    }
 
     // Format the votes
     format_votes_with_filter(results, nb_candidates);
 
-    // Add a new row for totals
-    results->rows += 1;
-
     // Calculate totals and add them as the last row
     add_totals_row(results);
 
-    // Add a new row for percentages
-    results->rows += 1;
-
     return results;
 }
+
+FirstChoiceIndex *build_first_choice_index(const Ballots *ballots) {
+    if (ballots == NULL)
+        return NULL;
+    FirstChoiceIndex *index = mem_alloc(sizeof(FirstChoiceIndex));
+    if (index == NULL)
+        return NULL;
+    uint rows = ballots->rows, columns = ballots->columns;
+    index->rows = rows;
+    index->columns = columns;
+    index->first_choices = mem_alloc(rows * sizeof(int) + 1);
+    index->order = mem_alloc(rows * sizeof(uint) + 1);
+    unsigned short *best = mem_alloc(rows * sizeof(unsigned short) + 1);
+    if (index->first_choices == NULL || index->order == NULL ||
+        best == NULL) {
+        mem_free(best);
+        delete_first_choice_index(index);
+        return NULL;
+    }
+
+    // Column by column, keep the best rank seen so far for every ballot and
+    // forget the choice as soon as that rank is shared
+    for (uint i = 0; i < rows; i++) {
+        best[i] = MAX_RANK + 1;
+        index->first_choices[i] = -1;
+    }
+    for (uint c = 0; c < columns; c++) {
+        const rank_t *column = get_ballots_column(ballots, c);
+        for (uint i = 0; i < rows; i++) {
+            rank_t rank = column[i];
+            if (rank == RANK_NONE || rank > best[i])
+                continue;
+            index->first_choices[i] = rank < best[i] ? (int)c : -1;
+            best[i] = rank;
+        }
+    }
+    mem_free(best);
+
+    // Counting sort of the ballots by first choice, bucket `columns` holding
+    // the ballots without one
+    uint counts[MAX_TAB + 1] = {0};
+    for (uint i = 0; i < rows; i++) {
+        int choice = index->first_choices[i];
+        counts[choice == -1 ? columns : (uint)choice]++;
+    }
+    index->offsets[0] = 0;
+    for (uint c = 0; c <= columns; c++) {
+        index->offsets[c + 1] = index->offsets[c] + counts[c];
+        if (c < columns)
+            index->totals[c] = counts[c];
+    }
+    for (uint c = 0; c <= columns; c++)
+        counts[c] = index->offsets[c];
+    for (uint i = 0; i < rows; i++) {
+        int choice = index->first_choices[i];
+        index->order[counts[choice == -1 ? columns : (uint)choice]++] = i;
+    }
+    return index;
+}
+
+void delete_first_choice_index(FirstChoiceIndex *index) {
+    if (index == NULL)
+        return;
+    mem_free(index->first_choices);
+    mem_free(index->order);
+    mem_free(index);
+}
@@ -7,6 +7,7 @@
 /*-----------------------------------------------------------------*/
 
 #include "first_past_the_post.h"
+#include "allocator.h"
 #include "matrix.h"
 #include "miscellaneous.h"
 #include <stdlib.h>
@@ -40,15 +41,17 @@ int *get_candidates_for_next_round(int *totals, int size, int *resultSize) {
 
     // Find the candidate with the highest percentage and any candidates with
     // over 50%
-    for (int i = 1; i < size; i++) {
+    for (int i = 0; i < size; i++) {
         double percentage = ((double)totals[i] / totalVotes) * 100;
         if (percentage > 50.0) {
             // If a candidate has over 50% of the votes, they are the only one
             // present
             *resultSize = 1;
-            int *result = (int *)malloc(sizeof(int));
+            int *result = mem_alloc(sizeof(int));
             result[0] = i;
             return result;
+        } else if (i == 0) {
+            continue; // The first candidate is the initial maximum
         } else if (totals[i] > totals[maxIndex]) {
             // Otherwise, keep track of the candidates with the highest
             // percentages
@@ -62,45 +65,86 @@ int *get_candidates_for_next_round(int *totals, int size, int *resultSize) {
     // If no candidate has over 50% of the votes, return the two candidates with
     // the highest percentages
     *resultSize = 2;
-    int *result = (int *)malloc(2 * sizeof(int));
+    int *result = mem_alloc(2 * sizeof(int));
     result[0] = maxIndex;
     result[1] = secondMaxIndex;
     return result;
 }
 
-ptrMatrix first_past_the_post_two_round_results(char *csv_votes,
-                                                int nb_candidates) {
-    // Run the first round of voting and get the results in a matrix
-    ptrMatrix results =
-        first_past_the_post_one_round_results(csv_votes, nb_candidates);
-
-    // Check if the first round results were successfully obtained
-    if (results == NULL) {
+ptrMatrix first_past_the_post_runoff_results(const Ballots *ballots,
+                                             const FirstChoiceIndex *index) {
+    if (ballots == NULL || index == NULL || index->rows != ballots->rows ||
+        index->columns != ballots->columns || index->columns == 0)
+        return NULL;
+    ptrMatrix results = init_matrix(false);
+    if (results == NULL)
         return NULL;
-    }
-
-    // Calculate the totals for the first round
-    add_totals_row(results);
 
-    // Get the total row
-    int *totals = results->data[results->rows - 1];
+    // First round, straight from the index
+    uint columns = index->columns;
+    results->columns = columns;
+    results->rows = 1;
+    for (uint c = 0; c < columns; c++) {
+        const StringBuffer *tag = ballots->tags[c];
+        results->tags[c] = tag != NULL
+                               ? init_stringbuffer(tag->string, tag->size)
+                               : init_stringbuffer(NULL, 0);
+        results->data[0][c] = index->totals[c];
+    }
 
-    // Get the candidates for the second round
     int resultSize;
-    int *candidates =
-        get_candidates_for_next_round(totals, results->columns, &resultSize);
+    int *finalists =
+        get_candidates_for_next_round(results->data[0], columns, &resultSize);
+    if (resultSize != 2 || finalists[1] < 0) {
+        mem_free(finalists);
+        return results;
+    }
 
-    // Update data to keep only candidates' columns for the second round
-    update_matrix_data(results, candidates, resultSize);
+    // Second round, the finalists keep their own ballots
+    uint first = finalists[0], second = finalists[1];
+    mem_free(finalists);
+    results->rows = 2;
+    for (uint c = 0; c < columns; c++)
+        results->data[1][c] = 0;
+    results->data[1][first] = index->totals[first];
+    results->data[1][second] = index->totals[second];
+
+    // Only the ballots of eliminated candidates, and those without a first
+    // choice (the last bucket), are transferred
+    const rank_t *first_ranks = get_ballots_column(ballots, first);
+    const rank_t *second_ranks = get_ballots_column(ballots, second);
+    for (uint c = 0; c <= columns; c++) {
+        if (c == first || c == second)
+            continue;
+        for (uint k = index->offsets[c]; k < index->offsets[c + 1]; k++) {
+            uint ballot = index->order[k];
+            rank_t a = first_ranks[ballot], b = second_ranks[ballot];
+            if (a != RANK_NONE && (b == RANK_NONE || a < b))
+                results->data[1][first]++;
+            else if (b != RANK_NONE && (a == RANK_NONE || b < a))
+                results->data[1][second]++;
+        }
+    }
+    return results;
+}
 
-    // Format the votes for the second round
-    format_votes_with_filter(results, nb_candidates);
+ptrMatrix first_past_the_post_two_round_results(char *csv_votes,
+                                                int nb_candidates) {
+    ptrBallots ballots = init_ballots();
+    if (ballots == NULL)
+        return NULL;
+    if (set_ballots_from_file(ballots, csv_votes, nb_candidates) != 0) {
+        delete_ballots(ballots);
+        return NULL;
+    }
 
-    // Calculate the totals for the second round
-    add_totals_row(results);
+    // Index the first choices once, the runoff only revisits what it needs
+    FirstChoiceIndex *index = build_first_choice_index(ballots);
+    ptrMatrix results = first_past_the_post_runoff_results(ballots, index);
 
     // Cleanup
-    free(candidates);
+    delete_first_choice_index(index);
+    delete_ballots(ballots);
 
     return results;
 }
@@ -6,42 +6,180 @@
  **/
 /*-----------------------------------------------------------------*/
 
-#include "matrix.h"
+#include "majority_judgement.h"
+#include "allocator.h"
+#include "ballots.h"
+#include "histogram.h"
 #include <stdlib.h>
 
 /*-----------------------------------------------------------------*/
 
-CandidateScore *find_majority_judgement_winner(ptrMatrix matrix,
-                                               int nb_candidates) {
-    CandidateScore *scores = malloc(nb_candidates * sizeof(CandidateScore));
+/*
+ * Grades are handled by level, from the worst (level 0, missing grade) to
+ * the best (level G, grade 1). The grades of a candidate sorted by level are
+ * x_0 <= ... <= x_{n-1} and their lower middle is x_k with k = (n - 1) / 2.
+ * Removing the middle grade repeatedly yields x_k first, then goes down
+ * (x_{k-1}, x_{k-2}, ...) and up (x_{k+1}, x_{k+2}, ...) alternately.
+ */
 
-    for (int i = 0; i < nb_candidates; i++) {
-        scores[i].candidate = i;
-        scores[i].score = 0;
+static uint nb_levels(const Histogram *grades) {
+    return grades->columns > 0 ? grades->columns : 1;
+}
+
+static uint level_count(const Histogram *grades, int candidate, uint level) {
+    // Level 0 is the missing grade, level l > 0 is the grade G + 1 - l
+    return level == 0 ? grades->counts[candidate][RANK_NONE]
+                      : grades->counts[candidate][nb_levels(grades) - level];
+}
+
+/**
+ * @brief Fills `below[l]`, the number of grades under level l.
+ */
+static void fill_cumulative(const Histogram *grades, int candidate,
+                            uint *below) {
+    uint levels = nb_levels(grades);
+    below[0] = 0;
+    for (uint l = 0; l < levels; l++)
+        below[l + 1] = below[l] + level_count(grades, candidate, l);
+}
+
+static uint level_of(const uint *below, uint levels, uint index) {
+    uint level = 0;
+    while (level + 1 < levels && below[level + 1] <= index)
+        level++;
+    return level;
+}
+
+/**
+ * @brief Walks down (step -1) or up (step +1) from `start` until the two
+ * sorted grade lists differ.
+ *
+ * @return The number of grades read before the difference, or -1 if the
+ * lists are equal up to the end of the walk. The differing levels are
+ * stored in first_level and second_level.
+ */
+static long first_difference(const uint *first, const uint *second,
+                             uint levels, uint n, uint start, int step,
+                             uint *first_level, uint *second_level) {
+    if (start >= n)
+        return -1;
+    uint a = level_of(first, levels, start);
+    uint b = level_of(second, levels, start);
+    long index = start;
+    while (true) {
+        if (a != b) {
+            *first_level = a;
+            *second_level = b;
+            return step < 0 ? (long)start - index : index - (long)start;
+        }
+        // Both runs share the level, skip to where the first of them ends
+        if (step < 0) {
+            uint run_start = first[a] > second[b] ? first[a] : second[b];
+            if (run_start == 0)
+                return -1;
+            index = run_start - 1;
+            while (first[a] > (uint)index)
+                a--;
+            while (second[b] > (uint)index)
+                b--;
+        } else {
+            uint run_end = first[a + 1] < second[b + 1] ? first[a + 1]
+                                                        : second[b + 1];
+            if (run_end >= n)
+                return -1;
+            index = run_end;
+            while (first[a + 1] <= (uint)index)
+                a++;
+            while (second[b + 1] <= (uint)index)
+                b++;
+        }
     }
+}
+
+static int compare_cumulative(const uint *first, const uint *second,
+                              uint levels, uint n) {
+    if (n == 0)
+        return 0;
+    uint k = (n - 1) / 2;
+    uint down_a, down_b, up_a, up_b;
+    long down = first_difference(first, second, levels, n, k, -1, &down_a,
+                                 &down_b);
+    long up = first_difference(first, second, levels, n, k + 1, +1, &up_a,
+                               &up_b);
+
+    // Position of those grades in the median removal sequence
+    long down_position = -1, up_position = -1;
+    if (down >= 0)
+        down_position = n % 2 ? (down == 0 ? 0 : 2 * down - 1) : 2 * down;
+    if (up >= 0)
+        up_position = n % 2 ? 2 * up + 2 : 2 * up + 1;
+
+    if (down_position < 0 && up_position < 0)
+        return 0;
+    if (up_position < 0 || (down_position >= 0 && down_position < up_position))
+        return (int)down_a - (int)down_b;
+    return (int)up_a - (int)up_b;
+}
 
-    for (uint i = 0; i < matrix->rows; i++) {
-        for (uint j = 0; j < matrix->columns; j++) {
-            int grade = matrix->data[i][j];
-            if (grade == -1)
-                continue; // ignore -1
-
-            // Assign grades based on the score
-            if (grade == 1) {
-                scores[j].score += 5; // A
-            } else if (grade >= 2 && grade <= 3) {
-                scores[j].score += 4; // B
-            } else if (grade >= 4 && grade <= 5) {
-                scores[j].score += 3; // C
-            } else if (grade >= 6 && grade <= 7) {
-                scores[j].score += 2; // D
-            } else if (grade >= 8 && grade <= 9) {
-                scores[j].score += 1; // E
-            } else if (grade == 10) {
-                scores[j].score += 0; // F
-            }
+int compare_majority_judgement(const Histogram *grades, int first,
+                               int second) {
+    uint below_first[MAX_RANK + 2], below_second[MAX_RANK + 2];
+    fill_cumulative(grades, first, below_first);
+    fill_cumulative(grades, second, below_second);
+    return compare_cumulative(below_first, below_second, nb_levels(grades),
+                              grades->ballots);
+}
+
+CandidateScore *majority_judgement_ranking(const Histogram *grades) {
+    uint levels = nb_levels(grades), n = grades->ballots;
+    int nb_candidates = grades->rows;
+    CandidateScore *ranking = mem_alloc(sizeof(CandidateScore) * nb_candidates);
+    uint *below = mem_alloc(sizeof(uint) * (MAX_RANK + 2) * nb_candidates + 1);
+    if (ranking == NULL || below == NULL) {
+        mem_free(ranking);
+        mem_free(below);
+        return NULL;
+    }
+
+    // Cumulative histograms are built once, each comparison is then O(G)
+    for (int c = 0; c < nb_candidates; c++)
+        fill_cumulative(grades, c, below + c * (MAX_RANK + 2));
+
+    // Insertion sort, ties keep the candidates order
+    for (int i = 0; i < nb_candidates; i++) {
+        int j = i;
+        while (j > 0 &&
+               compare_cumulative(below + i * (MAX_RANK + 2),
+                                  below + ranking[j - 1].candidate *
+                                              (MAX_RANK + 2),
+                                  levels, n) > 0) {
+            ranking[j] = ranking[j - 1];
+            j--;
         }
+        ranking[j].candidate = i;
     }
 
-    return scores;
-}
\ No newline at end of file
+    // Score is the majority grade, as written in the ballots
+    for (int i = 0; i < nb_candidates; i++) {
+        const uint *cumulative = below + ranking[i].candidate * (MAX_RANK + 2);
+        uint level = n > 0 ? level_of(cumulative, levels, (n - 1) / 2) : 0;
+        ranking[i].score = level == 0 ? -1 : (int)(levels - level);
+    }
+
+    mem_free(below);
+    return ranking;
+}
+
+CandidateScore *find_majority_judgement_winner(const Ballots *ballots,
+                                               int nb_candidates) {
+    if (ballots == NULL || nb_candidates <= 0 ||
+        (uint)nb_candidates != ballots->columns)
+        return NULL;
+    ptrHistogram grades = init_histogram();
+    if (grades == NULL)
+        return NULL;
+    set_histogram_from_ballots(grades, ballots);
+    CandidateScore *ranking = majority_judgement_ranking(grades);
+    delete_histogram(grades);
+    return ranking;
+}
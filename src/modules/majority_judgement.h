@@ -8,12 +8,52 @@
 
 #ifndef MAJORITY_JUDGEMENT_H
 #define MAJORITY_JUDGEMENT_H
-#include "matrix.h"
+#include "ballots.h"
+#include "histogram.h"
 #include "miscellaneous.h"
 
 /*-----------------------------------------------------------------*/
 
-CandidateScore *find_majority_judgement_winner(ptrMatrix matrix,
+/**
+ * @brief Compares two candidates by Majority Judgement.
+ *
+ * Grades are read from the histogram, 1 being the best grade and a missing
+ * grade (-1 in files) counting as worse than every grade. Candidates are
+ * compared on their majority grade (the lower middle grade), then on the
+ * sequence of majority grades obtained by removing the middle grade one at a
+ * time. That sequence walks outward from the middle of the sorted grades, so
+ * it is compared run by run on the cumulative histograms in O(G) without
+ * expanding any grade.
+ *
+ * @param[in] grades The grade histogram of the election.
+ * @param[in] first Index of the first candidate.
+ * @param[in] second Index of the second candidate.
+ * @return A positive value if first wins, a negative one if second wins, 0
+ * if they cannot be told apart.
+ */
+int compare_majority_judgement(const Histogram *grades, int first, int second);
+
+/**
+ * @brief Ranks every candidate by Majority Judgement.
+ *
+ * @param[in] grades The grade histogram of the election.
+ * @return The candidates, best first, each with its majority grade as score
+ * (-1 if it is a missing grade). To be freed by the caller.
+ */
+CandidateScore *majority_judgement_ranking(const Histogram *grades);
+
+/**
+ * @brief Ranks every candidate of a set of graded ballots.
+ *
+ * Counts the grades of each candidate in one pass, then ranks them with
+ * majority_judgement_ranking. No grade list is ever sorted.
+ *
+ * @param[in] ballots The ballots, each value being a grade.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @return The candidates, best first, or NULL on failure. To be freed by the
+ * caller.
+ */
+CandidateScore *find_majority_judgement_winner(const Ballots *ballots,
                                                int nb_candidates);
 
-#endif // MAJORITY_JUDGEMENT_H
\ No newline at end of file
+#endif // MAJORITY_JUDGEMENT_H
@@ -0,0 +1,165 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Party-List Proportional Seat Allocation
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "proportional.h"
+#include "allocator.h"
+#include <stdbool.h>
+#include <stdlib.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Exact fraction numerator / denominator attached to a list.
+ */
+typedef struct s_quotient {
+    long long numerator;
+    long long denominator;
+    int list;
+} Quotient;
+
+/**
+ * @brief Whether a comes before b: larger fraction, then more votes, then
+ * first list.
+ */
+static bool quotient_before(const Quotient *a, const Quotient *b,
+                            const int *votes) {
+    long long left = a->numerator * b->denominator;
+    long long right = b->numerator * a->denominator;
+    if (left != right)
+        return left > right;
+    if (votes[a->list] != votes[b->list])
+        return votes[a->list] > votes[b->list];
+    return a->list < b->list;
+}
+
+static void sift_down(Quotient *heap, int size, int pos, const int *votes) {
+    Quotient moved = heap[pos];
+    for (int child = 2 * pos + 1; child < size; child = 2 * pos + 1) {
+        if (child + 1 < size &&
+            quotient_before(&heap[child + 1], &heap[child], votes))
+            child++;
+        if (!quotient_before(&heap[child], &moved, votes))
+            break;
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = moved;
+}
+
+static void build_heap(Quotient *heap, int size, const int *votes) {
+    for (int pos = size / 2 - 1; pos >= 0; pos--)
+        sift_down(heap, size, pos, votes);
+}
+
+/**
+ * @brief Checks the arguments and sums the votes.
+ *
+ * @return The total of the votes, -1 if the arguments are invalid.
+ */
+static long long check_votes(const int *votes, int nb_lists, int seats,
+                             int *allocated) {
+    if (votes == NULL || allocated == NULL || nb_lists <= 0 || seats < 0)
+        return -1;
+    long long total = 0;
+    for (int i = 0; i < nb_lists; i++) {
+        if (votes[i] < 0)
+            return -1;
+        total += votes[i];
+        allocated[i] = 0;
+    }
+    return total > 0 ? total : -1;
+}
+
+int allocate_highest_averages(const int *votes, int nb_lists, int seats,
+                              enum SeatMethod method, int *allocated) {
+    if (method != SEATS_DHONDT && method != SEATS_SAINTE_LAGUE)
+        return -1;
+    if (check_votes(votes, nb_lists, seats, allocated) < 0)
+        return -1;
+    Quotient *heap = mem_alloc(sizeof(Quotient) * nb_lists);
+    if (heap == NULL)
+        return -1;
+    // The next divisor of a list holding s seats is s + 1 for D'Hondt and
+    // 2s + 1 for Sainte-Laguë
+    long long step = method == SEATS_DHONDT ? 1 : 2;
+    for (int i = 0; i < nb_lists; i++)
+        heap[i] = (Quotient){votes[i], 1, i};
+    build_heap(heap, nb_lists, votes);
+
+    for (int seat = 0; seat < seats; seat++) {
+        int list = heap[0].list;
+        allocated[list]++;
+        heap[0].denominator = step * allocated[list] + 1;
+        sift_down(heap, nb_lists, 0, votes);
+    }
+    mem_free(heap);
+    return 0;
+}
+
+int allocate_largest_remainders(const int *votes, int nb_lists, int seats,
+                                enum SeatMethod method, int *allocated) {
+    if (method != SEATS_HARE && method != SEATS_DROOP)
+        return -1;
+    long long total = check_votes(votes, nb_lists, seats, allocated);
+    if (total < 0)
+        return -1;
+    Quotient *heap = mem_alloc(sizeof(Quotient) * nb_lists);
+    if (heap == NULL)
+        return -1;
+
+    // Remainders are compared as numerators over a common denominator:
+    // votes * seats mod total for Hare, votes mod quota for Droop
+    long long quota = total / (seats + 1) + 1;
+    long long left = seats;
+    int nb_voted = 0;
+    for (int i = 0; i < nb_lists; i++) {
+        long long whole, remainder;
+        if (method == SEATS_HARE) {
+            whole = (long long)votes[i] * seats / total;
+            remainder = (long long)votes[i] * seats % total;
+        } else {
+            whole = votes[i] / quota;
+            remainder = votes[i] % quota;
+        }
+        allocated[i] = whole;
+        left -= whole;
+        // A list without votes never gets a seat
+        if (votes[i] > 0)
+            heap[nb_voted++] = (Quotient){remainder, 1, i};
+    }
+
+    // A small Droop quota may leave more seats than lists with votes
+    if (left >= nb_voted) {
+        for (int k = 0; k < nb_voted; k++)
+            allocated[heap[k].list] += left / nb_voted;
+        left %= nb_voted;
+    }
+    build_heap(heap, nb_voted, votes);
+    for (int size = nb_voted; left > 0; left--) {
+        allocated[heap[0].list]++;
+        heap[0] = heap[--size];
+        sift_down(heap, size, 0, votes);
+    }
+    mem_free(heap);
+    return 0;
+}
+
+int allocate_seats(const int *votes, int nb_lists, int seats,
+                   enum SeatMethod method, int *allocated) {
+    switch (method) {
+    case SEATS_DHONDT:
+    case SEATS_SAINTE_LAGUE:
+        return allocate_highest_averages(votes, nb_lists, seats, method,
+                                         allocated);
+    case SEATS_HARE:
+    case SEATS_DROOP:
+        return allocate_largest_remainders(votes, nb_lists, seats, method,
+                                           allocated);
+    }
+    return -1;
+}
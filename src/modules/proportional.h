@@ -0,0 +1,74 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Party-List Proportional Seat Allocation
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef PROPORTIONAL_H
+#define PROPORTIONAL_H
+
+#include "miscellaneous.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Seat allocation methods.
+ */
+enum SeatMethod {
+    SEATS_DHONDT,        /**< Highest averages, divisors 1, 2, 3, ... */
+    SEATS_SAINTE_LAGUE,  /**< Highest averages, divisors 1, 3, 5, ... */
+    SEATS_HARE,          /**< Largest remainders, quota votes / seats */
+    SEATS_DROOP          /**< Largest remainders, quota votes/(seats+1)+1 */
+};
+
+/**
+ * @brief Allocates seats with a highest averages method.
+ *
+ * The lists are kept in a binary max-heap keyed by their next quotient,
+ * compared exactly by cross-multiplication. Each seat pops the best list and
+ * sifts it back with its new divisor, so the allocation costs
+ * O((S + L) log L) instead of recomputing every quotient for every seat.
+ * Equal quotients favour the list with the most votes, then the first one.
+ *
+ * @param[in] votes The votes of each list, such as the totals row added by
+ *                  add_totals_row.
+ * @param[in] nb_lists The number of lists.
+ * @param[in] seats The number of seats to fill.
+ * @param[in] method SEATS_DHONDT or SEATS_SAINTE_LAGUE.
+ * @param[out] allocated The number of seats of each list.
+ * @return 0 on success, -1 on invalid arguments or allocation failure.
+ */
+int allocate_highest_averages(const int *votes, int nb_lists, int seats,
+                              enum SeatMethod method, int *allocated);
+
+/**
+ * @brief Allocates seats with a largest remainders method.
+ *
+ * Each list first gets the integer part of its votes over the quota, the
+ * seats left are given to the largest remainders, selected with the same
+ * heap in O(L + S log L). Only lists with votes are in the heap, and when a
+ * small Droop quota leaves more seats than there are such lists, each of
+ * them first gets an equal share of the surplus. A list without votes
+ * never gets a seat.
+ *
+ * @param[in] votes The votes of each list.
+ * @param[in] nb_lists The number of lists.
+ * @param[in] seats The number of seats to fill.
+ * @param[in] method SEATS_HARE or SEATS_DROOP.
+ * @param[out] allocated The number of seats of each list.
+ * @return 0 on success, -1 on invalid arguments or allocation failure.
+ */
+int allocate_largest_remainders(const int *votes, int nb_lists, int seats,
+                                enum SeatMethod method, int *allocated);
+
+/**
+ * @brief Allocates seats with any of the supported methods.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int allocate_seats(const int *votes, int nb_lists, int seats,
+                   enum SeatMethod method, int *allocated);
+
+#endif // PROPORTIONAL_H
@@ -0,0 +1,174 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Positional Scoring Rules
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "scoring_rules.h"
+#include "allocator.h"
+#include "ballots.h"
+#include "histogram.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+static void reset_rule(ScoringRule *rule, const char *name, int length) {
+    memset(rule, 0, sizeof(ScoringRule));
+    snprintf(rule->name, MAX_RULE_NAME, "%s", name);
+    rule->length = length < 0 ? 0 : length > MAX_RANK ? MAX_RANK : length;
+}
+
+void set_borda_rule(ScoringRule *rule, int nb_candidates) {
+    reset_rule(rule, "Borda", nb_candidates);
+    for (uint r = 1; r <= rule->length; r++)
+        rule->weights[r] = nb_candidates - r;
+}
+
+void set_dowdall_rule(ScoringRule *rule, int nb_candidates) {
+    reset_rule(rule, "Dowdall", nb_candidates);
+    for (uint r = 1; r <= rule->length; r++)
+        rule->weights[r] = 1.0 / r;
+}
+
+void set_approval_rule(ScoringRule *rule, int nb_candidates, int k) {
+    char name[MAX_RULE_NAME];
+    snprintf(name, sizeof(name), "%d-approval", k);
+    reset_rule(rule, name, k < nb_candidates ? k : nb_candidates);
+    for (uint r = 1; r <= rule->length; r++)
+        rule->weights[r] = 1;
+}
+
+int set_rule_from_file(ScoringRule *rule, const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+        return -1;
+    const char *name = strrchr(filename, '/');
+    reset_rule(rule, name != NULL ? name + 1 : filename, 0);
+
+    double weight;
+    int read;
+    while (rule->length < MAX_RANK &&
+           (read = fscanf(file, " %lf , ", &weight)) != EOF) {
+        if (read != 1)
+            break;
+        rule->weights[++rule->length] = weight;
+    }
+    fclose(file);
+    return rule->length > 0 ? 0 : -1;
+}
+
+/*-----------------------------------------------------------------*/
+
+void compute_scoring_rules_from_histogram(const Histogram *histogram,
+                                          const ScoringRule *rules,
+                                          int nb_rules, double *scores) {
+    for (int k = 0; k < nb_rules; k++) {
+        const double *weights = rules[k].weights;
+        for (uint c = 0; c < histogram->rows; c++) {
+            double score = 0;
+            for (uint r = 1; r < histogram->columns; r++)
+                score += histogram->counts[c][r] * weights[r];
+            scores[k * histogram->rows + c] = score;
+        }
+    }
+}
+
+int compute_scoring_rules(const Ballots *ballots, const ScoringRule *rules,
+                          int nb_rules, enum TruncationPolicy policy,
+                          double *scores) {
+    if (ballots == NULL || rules == NULL || nb_rules <= 0 || scores == NULL)
+        return -1;
+    ptrHistogram ranked = init_histogram();
+    if (ranked == NULL)
+        return -1;
+    if (policy == TRUNCATION_ZERO) {
+        set_histogram_from_ballots(ranked, ballots);
+        compute_scoring_rules_from_histogram(ranked, rules, nb_rules, scores);
+        delete_histogram(ranked);
+        return 0;
+    }
+
+    // Number of candidates each ballot leaves out, swept column by column
+    uint rows = ballots->rows, columns = ballots->columns;
+    rank_t *left_out = mem_alloc(rows + 1);
+    ptrHistogram unranked = init_histogram();
+    if (left_out == NULL || unranked == NULL) {
+        mem_free(left_out);
+        delete_histogram(unranked);
+        delete_histogram(ranked);
+        return -1;
+    }
+    memset(left_out, 0, rows);
+    for (uint c = 0; c < columns; c++) {
+        const rank_t *column = get_ballots_column(ballots, c);
+        for (uint i = 0; i < rows; i++)
+            left_out[i] += column[i] == RANK_NONE;
+    }
+
+    // Rank counts of the kept ballots and, for AVERAGE, counts of candidates
+    // left out indexed by how many their ballot leaves out
+    ranked->rows = unranked->rows = columns;
+    ranked->columns = unranked->columns = MAX_RANK + 1;
+    for (uint c = 0; c < columns; c++) {
+        const rank_t *column = get_ballots_column(ballots, c);
+        for (uint i = 0; i < rows; i++) {
+            if (policy == TRUNCATION_IGNORE && left_out[i] > 0)
+                continue;
+            ranked->counts[c][column[i]]++;
+            if (column[i] == RANK_NONE)
+                unranked->counts[c][left_out[i]]++;
+        }
+    }
+    compute_scoring_rules_from_histogram(ranked, rules, nb_rules, scores);
+
+    if (policy == TRUNCATION_AVERAGE) {
+        for (int k = 0; k < nb_rules; k++) {
+            // average[u]: mean weight of the last u places, those shared by
+            // the u candidates a ballot leaves out
+            double average[MAX_RANK + 1] = {0};
+            double tail = 0;
+            for (uint u = 1; u <= columns; u++) {
+                tail += rules[k].weights[columns - u + 1];
+                average[u] = tail / u;
+            }
+            for (uint c = 0; c < columns; c++) {
+                double extra = 0;
+                for (uint u = 1; u <= columns; u++)
+                    extra += unranked->counts[c][u] * average[u];
+                scores[k * columns + c] += extra;
+            }
+        }
+    }
+
+    mem_free(left_out);
+    delete_histogram(unranked);
+    delete_histogram(ranked);
+    return 0;
+}
+
+/*-----------------------------------------------------------------*/
+
+CandidateScore *rank_by_score(const double *scores, int nb_candidates) {
+    CandidateScore *ranking = mem_alloc(sizeof(CandidateScore) * nb_candidates);
+    if (ranking == NULL)
+        return NULL;
+
+    // Insertion sort on the exact scores, ties keep the candidates order
+    for (int i = 0; i < nb_candidates; i++) {
+        int j = i;
+        while (j > 0 && scores[ranking[j - 1].candidate] < scores[i]) {
+            ranking[j] = ranking[j - 1];
+            j--;
+        }
+        ranking[j].candidate = i;
+    }
+    for (int i = 0; i < nb_candidates; i++)
+        ranking[i].score = (int)lround(scores[ranking[i].candidate]);
+    return ranking;
+}
@@ -0,0 +1,128 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Positional Scoring Rules
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef SCORING_RULES_H
+#define SCORING_RULES_H
+
+#include "ballots.h"
+#include "histogram.h"
+#include "miscellaneous.h"
+
+/*-----------------------------------------------------------------*/
+
+#define MAX_RULE_NAME 32
+
+/**
+ * @brief How candidates left out of a truncated ballot are scored.
+ */
+enum TruncationPolicy {
+    TRUNCATION_ZERO,    /**< Unranked candidates get no points */
+    TRUNCATION_AVERAGE, /**< They share the average of the unused weights */
+    TRUNCATION_IGNORE   /**< Ballots leaving a candidate out are ignored */
+};
+
+/**
+ * @brief A positional scoring rule, one weight per rank.
+ *
+ * `weights[r]` is the number of points given to the candidate ranked `r`,
+ * ranks above `length` are worth nothing. Ballots ranking several candidates
+ * at the same place give each of them the weight of that place.
+ */
+typedef struct s_scoring_rule {
+    char name[MAX_RULE_NAME];     /**< Name shown in results */
+    double weights[MAX_RANK + 1]; /**< Weight of each rank, [0] unused */
+    uint length;                  /**< Number of weighted ranks */
+} ScoringRule;
+
+/**
+ * @brief Sets the Borda weights: C - 1 points for the first rank down to 0.
+ *
+ * @param[out] rule The rule to set.
+ * @param[in] nb_candidates Number of candidates in the election.
+ */
+void set_borda_rule(ScoringRule *rule, int nb_candidates);
+
+/**
+ * @brief Sets the Dowdall weights: 1 / r points for rank r.
+ *
+ * @param[out] rule The rule to set.
+ * @param[in] nb_candidates Number of candidates in the election.
+ */
+void set_dowdall_rule(ScoringRule *rule, int nb_candidates);
+
+/**
+ * @brief Sets the k-approval weights: 1 point for each of the first k ranks.
+ *
+ * @param[out] rule The rule to set.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @param[in] k Number of approved ranks, 1 gives plurality.
+ */
+void set_approval_rule(ScoringRule *rule, int nb_candidates, int k);
+
+/**
+ * @brief Reads custom weights from a file.
+ *
+ * The file lists the weight of rank 1, then rank 2, and so on, separated by
+ * spaces, commas or new lines.
+ *
+ * @param[out] rule The rule to set, named after the file.
+ * @param[in] filename Path to the weights file.
+ * @return 0 on success, -1 if the file cannot be read or holds no weight.
+ */
+int set_rule_from_file(ScoringRule *rule, const char *filename);
+
+/**
+ * @brief Scores every candidate under several rules at once.
+ *
+ * The ballots are reduced to per-candidate rank counts in a single pass over
+ * the rank columns, each rule then only looks its weights up once per
+ * (candidate, rank) pair. Adding rules therefore costs O(C * R) each instead
+ * of another pass over the ballots. The AVERAGE and IGNORE policies need the
+ * number of candidates each ballot leaves out and add one sweep to count
+ * it. Under AVERAGE the candidates a ballot leaves out share the mean
+ * weight of its last places, one place each, whatever ties or gaps the
+ * ranked ones have.
+ *
+ * @param[in] ballots The ballots of the election.
+ * @param[in] rules The rules to apply.
+ * @param[in] nb_rules The number of rules.
+ * @param[in] policy How truncated ballots are handled.
+ * @param[out] scores `nb_rules * ballots->columns` scores, the score of
+ *                    candidate c under rule k being at k * columns + c.
+ * @return 0 on success, -1 on failure.
+ */
+int compute_scoring_rules(const Ballots *ballots, const ScoringRule *rules,
+                          int nb_rules, enum TruncationPolicy policy,
+                          double *scores);
+
+/**
+ * @brief Scores every candidate from an already built rank histogram.
+ *
+ * Only supports TRUNCATION_ZERO, since the histogram does not know the
+ * depth of each ballot.
+ *
+ * @param[in] histogram The rank histogram of the election.
+ * @param[in] rules The rules to apply.
+ * @param[in] nb_rules The number of rules.
+ * @param[out] scores Same layout as in compute_scoring_rules.
+ */
+void compute_scoring_rules_from_histogram(const Histogram *histogram,
+                                          const ScoringRule *rules,
+                                          int nb_rules, double *scores);
+
+/**
+ * @brief Ranks candidates by decreasing score.
+ *
+ * @param[in] scores The score of each candidate.
+ * @param[in] nb_candidates Number of candidates.
+ * @return The candidates, best first, with their score rounded to the
+ * nearest integer. To be freed by the caller.
+ */
+CandidateScore *rank_by_score(const double *scores, int nb_candidates);
+
+#endif // SCORING_RULES_H
@@ -0,0 +1,197 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Smith-Constrained Hybrid Methods
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "smith.h"
+#include "piles.h"
+#include <stdlib.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief State of Tarjan's strongly connected components search.
+ */
+typedef struct s_tarjan {
+    ptrMatrix duel;
+    int nb_candidates;
+    const bool *continuing;
+    int index[MAX_TAB];     /**< Visit order, -1 if not visited */
+    int low[MAX_TAB];       /**< Lowest index reachable from the subtree */
+    int component[MAX_TAB]; /**< Component of each candidate */
+    int stack[MAX_TAB];
+    bool on_stack[MAX_TAB];
+    int depth;
+    int visited;
+    int components;
+} Tarjan;
+
+static bool takes_part(const Tarjan *tarjan, int candidate) {
+    return tarjan->continuing == NULL || tarjan->continuing[candidate];
+}
+
+static void strong_connect(Tarjan *tarjan, int v) {
+    tarjan->index[v] = tarjan->low[v] = tarjan->visited++;
+    tarjan->stack[tarjan->depth++] = v;
+    tarjan->on_stack[v] = true;
+
+    for (int w = 0; w < tarjan->nb_candidates; w++) {
+        // v links to w when it does not lose against w
+        if (w == v || !takes_part(tarjan, w) ||
+            tarjan->duel->data[v][w] < tarjan->duel->data[w][v])
+            continue;
+        if (tarjan->index[w] == -1) {
+            strong_connect(tarjan, w);
+            if (tarjan->low[w] < tarjan->low[v])
+                tarjan->low[v] = tarjan->low[w];
+        } else if (tarjan->on_stack[w] && tarjan->index[w] < tarjan->low[v]) {
+            tarjan->low[v] = tarjan->index[w];
+        }
+    }
+
+    if (tarjan->low[v] == tarjan->index[v]) {
+        int w;
+        do {
+            w = tarjan->stack[--tarjan->depth];
+            tarjan->on_stack[w] = false;
+            tarjan->component[w] = tarjan->components;
+        } while (w != v);
+        tarjan->components++;
+    }
+}
+
+int find_smith_set(ptrMatrix duel, int nb_candidates, const bool *continuing,
+                   bool *smith) {
+    Tarjan tarjan = {.duel = duel,
+                     .nb_candidates = nb_candidates,
+                     .continuing = continuing};
+    for (int i = 0; i < nb_candidates; i++) {
+        tarjan.index[i] = -1;
+        tarjan.on_stack[i] = false;
+    }
+    for (int i = 0; i < nb_candidates; i++) {
+        if (takes_part(&tarjan, i) && tarjan.index[i] == -1)
+            strong_connect(&tarjan, i);
+    }
+
+    // Every pair is linked at least one way, so the components form a chain
+    // and the first one of the chain is only emitted once all the others are
+    int size = 0;
+    for (int i = 0; i < nb_candidates; i++) {
+        smith[i] = takes_part(&tarjan, i) &&
+                   tarjan.component[i] == tarjan.components - 1;
+        size += smith[i];
+    }
+    return size;
+}
+
+/**
+ * @brief Finds the instant-runoff loser, the last one among ties.
+ */
+static int find_irv_loser(const Piles *piles) {
+    int loser = -1;
+    for (uint c = 0; c < piles->ballots->columns; c++) {
+        if (piles->continuing[c] &&
+            (loser == -1 || piles->counts[c] <= piles->counts[loser]))
+            loser = c;
+    }
+    return loser;
+}
+
+/**
+ * @brief Finds the continuing candidate with a strict majority of the
+ * ballots still ranking someone, or the last one standing.
+ *
+ * @return The winner, -1 if there is none yet.
+ */
+static int find_irv_winner(const Piles *piles) {
+    uint voting = piles->ballots->rows - piles->exhausted;
+    int remaining = 0, last = -1;
+    for (uint c = 0; c < piles->ballots->columns; c++) {
+        if (!piles->continuing[c])
+            continue;
+        if (piles->counts[c] * 2 > voting)
+            return c;
+        remaining++;
+        last = c;
+    }
+    return remaining == 1 ? last : -1;
+}
+
+static int count_smith_irv(ptrPiles piles, const bool *smith) {
+    for (uint c = 0; c < piles->ballots->columns; c++) {
+        if (!smith[c])
+            eliminate_from_piles(piles, c);
+    }
+    int winner;
+    while ((winner = find_irv_winner(piles)) == -1)
+        eliminate_from_piles(piles, find_irv_loser(piles));
+    return winner;
+}
+
+static int count_tideman(ptrMatrix duel, ptrPiles piles, const bool *smith) {
+    int nb_candidates = piles->ballots->columns;
+    bool kept[MAX_TAB];
+    for (int c = 0; c < nb_candidates; c++)
+        kept[c] = smith[c];
+    while (true) {
+        int remaining = 0, last = -1;
+        for (int c = 0; c < nb_candidates; c++) {
+            if (!piles->continuing[c])
+                continue;
+            if (!kept[c]) {
+                eliminate_from_piles(piles, c);
+            } else {
+                remaining++;
+                last = c;
+            }
+        }
+        if (remaining == 1)
+            return last;
+        eliminate_from_piles(piles, find_irv_loser(piles));
+        find_smith_set(duel, nb_candidates, piles->continuing, kept);
+    }
+}
+
+static int count_woodall(ptrPiles piles, const bool *smith) {
+    int nb_candidates = piles->ballots->columns, left = 0;
+    for (int c = 0; c < nb_candidates; c++)
+        left += smith[c];
+    while (left > 1) {
+        int loser = find_irv_loser(piles);
+        left -= smith[loser];
+        eliminate_from_piles(piles, loser);
+    }
+    for (int c = 0; c < nb_candidates; c++) {
+        if (smith[c] && piles->continuing[c])
+            return c;
+    }
+    return -1;
+}
+
+int find_smith_hybrid_winners(ptrMatrix duel, const Ballots *ballots,
+                              SmithWinners *winners) {
+    if (duel == NULL || ballots == NULL || winners == NULL ||
+        ballots->columns == 0)
+        return -1;
+    bool smith[MAX_TAB];
+    find_smith_set(duel, ballots->columns, NULL, smith);
+
+    ptrPiles firsts = init_piles(ballots, PILE_TOP);
+    ptrPiles smith_irv = copy_piles(firsts);
+    ptrPiles tideman = copy_piles(firsts);
+    int status = -1;
+    if (firsts != NULL && smith_irv != NULL && tideman != NULL) {
+        winners->smith_irv = count_smith_irv(smith_irv, smith);
+        winners->tideman = count_tideman(duel, tideman, smith);
+        winners->woodall = count_woodall(firsts, smith);
+        status = 0;
+    }
+    delete_piles(firsts);
+    delete_piles(smith_irv);
+    delete_piles(tideman);
+    return status;
+}
@@ -0,0 +1,69 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Smith-Constrained Hybrid Methods
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef SMITH_H
+#define SMITH_H
+
+#include "ballots.h"
+#include "matrix.h"
+#include <stdbool.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Winners of the Smith-constrained instant-runoff family.
+ */
+typedef struct s_smith_winners {
+    int smith_irv; /**< Instant-runoff among the Smith set */
+    int tideman;   /**< Tideman's Alternative */
+    int woodall;   /**< Last Smith set member left by instant-runoff */
+} SmithWinners;
+
+/**
+ * @brief Finds the Smith set, the smallest non-empty set of candidates that
+ * all beat or tie every candidate outside it.
+ *
+ * Candidates are linked to every candidate they do not lose against, the
+ * strongly connected components are found by Tarjan's algorithm, and the
+ * Smith set is the one component no outside candidate links to: the last
+ * emitted, in O(C^2).
+ *
+ * @param[in] duel The duel matrix of the election.
+ * @param[in] nb_candidates Number of candidates.
+ * @param[in] continuing Candidates taking part, NULL for all of them.
+ * @param[out] smith Whether each candidate is in the Smith set.
+ * @return The size of the Smith set.
+ */
+int find_smith_set(ptrMatrix duel, int nb_candidates, const bool *continuing,
+                   bool *smith);
+
+/**
+ * @brief Finds the winners of Smith//IRV, Tideman's Alternative and Woodall.
+ *
+ * The Smith set of the whole field and the first-choice piles are computed
+ * once, each method then counts on its own copy of the piles. An
+ * instant-runoff round eliminates the continuing candidate ranked first
+ * (alone) on the fewest ballots, the last one among ties.
+ *
+ * - Smith//IRV eliminates everybody outside the Smith set, then runs an
+ *   instant-runoff until a strict majority of the ballots still ranking
+ *   someone agree on a first choice.
+ * - Tideman's Alternative alternates: keep only the Smith set of the
+ *   continuing candidates, then eliminate one instant-runoff loser.
+ * - Woodall runs an instant-runoff on the whole field and the winner is the
+ *   Smith set member eliminated last.
+ *
+ * @param[in] duel The duel matrix of the ballots.
+ * @param[in] ballots The ballots of the election.
+ * @param[out] winners The winner of each method.
+ * @return 0 on success, -1 on failure.
+ */
+int find_smith_hybrid_winners(ptrMatrix duel, const Ballots *ballots,
+                              SmithWinners *winners);
+
+#endif // SMITH_H
@@ -0,0 +1,313 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Counting Batches of Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "batch.h"
+#include "allocator.h"
+#include "arena.h"
+#include "stats.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+ptrBatch init_batch(const ElectionOptions *options, const char *method,
+                    const char *cache_dir) {
+    ptrBatch batch = mem_alloc(sizeof(Batch));
+    if (batch == NULL)
+        return NULL;
+    batch->jobs = NULL;
+    batch->nb_jobs = batch->capacity = batch->next = 0;
+    batch->options = *options;
+    batch->method = method;
+    batch->cache_dir = cache_dir;
+    batch->trace = NULL;
+    pthread_mutex_init(&batch->lock, NULL);
+    return batch;
+}
+
+static int add_batch_job(ptrBatch batch, const char *path) {
+    if (batch->nb_jobs == batch->capacity) {
+        uint capacity = batch->capacity ? 2 * batch->capacity : 16;
+        BatchJob *jobs = mem_realloc(batch->jobs, sizeof(BatchJob) * capacity);
+        if (jobs == NULL)
+            return -1;
+        batch->jobs = jobs;
+        batch->capacity = capacity;
+    }
+    BatchJob *job = &batch->jobs[batch->nb_jobs];
+    job->path = mem_strdup(path);
+    if (job->path == NULL)
+        return -1;
+    job->nb_candidates = job->winner = -1;
+    job->ballots = job->rejected = 0;
+    job->winner_name = NULL;
+    job->error = "not counted";
+    batch->nb_jobs++;
+    return 0;
+}
+
+static int compare_names(const void *first, const void *second) {
+    return strcmp(*(char *const *)first, *(char *const *)second);
+}
+
+static int add_directory(ptrBatch batch, const char *path) {
+    DIR *directory = opendir(path);
+    if (directory == NULL)
+        return -1;
+    char **names = NULL;
+    uint nb_names = 0, capacity = 0;
+    struct dirent *entry;
+    while ((entry = readdir(directory)) != NULL) {
+        size_t length = strlen(entry->d_name);
+        if (length < 4 || strcmp(entry->d_name + length - 4, ".csv") != 0)
+            continue;
+        if (nb_names == capacity) {
+            capacity = capacity ? 2 * capacity : 16;
+            char **grown = mem_realloc(names, sizeof(char *) * capacity);
+            if (grown == NULL)
+                break;
+            names = grown;
+        }
+        size_t size = strlen(path) + length + 2;
+        if ((names[nb_names] = mem_alloc(size)) == NULL)
+            break;
+        snprintf(names[nb_names++], size, "%s/%s", path, entry->d_name);
+    }
+    closedir(directory);
+
+    // readdir gives no order, the records follow the names
+    qsort(names, nb_names, sizeof(char *), compare_names);
+    int added = 0;
+    for (uint i = 0; i < nb_names; i++) {
+        if (added >= 0 && add_batch_job(batch, names[i]) == 0)
+            added++;
+        else
+            added = -1;
+        mem_free(names[i]);
+    }
+    mem_free(names);
+    return added;
+}
+
+static int add_manifest(ptrBatch batch, const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return -1;
+    char *line = NULL;
+    size_t size = 0;
+    int added = 0;
+    while (added >= 0 && getline(&line, &size, file) != -1) {
+        char *name = extract_column_name(line);
+        if (*name == '\0' || *name == '#')
+            continue;
+        added = add_batch_job(batch, name) == 0 ? added + 1 : -1;
+    }
+    free(line);
+    fclose(file);
+    return added;
+}
+
+int add_batch_path(ptrBatch batch, const char *path) {
+    struct stat info;
+    if (batch == NULL || path == NULL || stat(path, &info) != 0)
+        return -1;
+    return S_ISDIR(info.st_mode) ? add_directory(batch, path)
+                                 : add_manifest(batch, path);
+}
+
+static void count_job(const Batch *batch, BatchJob *job, ptrTallies tallies,
+                      ptrArena arena) {
+    job->nb_candidates = infer_candidate_count(job->path);
+    if (job->nb_candidates <= 0 || job->nb_candidates >= MAX_TAB) {
+        job->error = "cannot infer the number of candidates";
+        return;
+    }
+    if (load_tallies(tallies, batch->cache_dir, job->path,
+                     job->nb_candidates) != 0) {
+        job->error = "cannot read the ballots";
+        return;
+    }
+    job->ballots = tallies->ballots->rows;
+    job->rejected = tallies->ballots->rejected;
+
+    // The scratch space of the count is dropped with the arena
+    const Allocator *previous =
+        set_thread_allocator(get_arena_allocator(arena));
+    STATS_BEGIN(PHASE_METHOD);
+    job->winner = find_election_winner(tallies, &batch->options);
+    STATS_END(PHASE_METHOD);
+    set_thread_allocator(previous);
+    reset_arena(arena);
+    if (job->winner < 0) {
+        job->error = "the method has no single winner";
+        return;
+    }
+    job->winner_name = mem_strdup(tallies->ballots->tags[job->winner]->string);
+    job->error = NULL;
+}
+
+static void *run_worker(void *argument) {
+    ptrBatch batch = argument;
+    ptrTallies tallies = init_tallies();
+    ptrArena arena = init_arena(ARENA_BLOCK_SIZE);
+    if (batch->trace != NULL)
+        attach_trace_thread(batch->trace, "worker");
+    while (true) {
+        pthread_mutex_lock(&batch->lock);
+        uint next = batch->next;
+        if (next < batch->nb_jobs)
+            batch->next++;
+        pthread_mutex_unlock(&batch->lock);
+        if (next >= batch->nb_jobs)
+            break;
+        if (tallies == NULL || arena == NULL)
+            batch->jobs[next].error = "cannot allocate the tallies";
+        else {
+            TRACE_BEGIN("election", batch->jobs[next].path);
+            count_job(batch, &batch->jobs[next], tallies, arena);
+            TRACE_END();
+        }
+    }
+    detach_trace_thread();
+    delete_arena(arena);
+    delete_tallies(tallies);
+    return NULL;
+}
+
+int run_batch(ptrBatch batch, int nb_workers) {
+    if (batch == NULL)
+        return -1;
+    if (nb_workers <= 0)
+        nb_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_workers <= 0)
+        nb_workers = 1;
+    if ((uint)nb_workers > batch->nb_jobs)
+        nb_workers = batch->nb_jobs ? batch->nb_jobs : 1;
+
+    pthread_t *workers = mem_alloc(sizeof(pthread_t) * nb_workers);
+    if (workers == NULL)
+        return -1;
+    int started = 0;
+    while (started < nb_workers &&
+           pthread_create(&workers[started], NULL, run_worker, batch) == 0)
+        started++;
+    for (int i = 0; i < started; i++)
+        pthread_join(workers[i], NULL);
+    mem_free(workers);
+    return started > 0 ? 0 : -1;
+}
+
+// A failed election gives its error in place of its result
+static void write_batch_record(ptrWriter writer, const char *method,
+                               const BatchJob *job) {
+    switch (writer->format) {
+    case FORMAT_TEXT:
+        write_text(writer, job->path);
+        if (job->error != NULL) {
+            write_text(writer, " : ");
+            write_text(writer, job->error);
+        } else {
+            write_text(writer, " : ");
+            write_text(writer, method);
+            write_text(writer, " winner is candidate : ");
+            write_text(writer, job->winner_name);
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_CSV:
+        write_csv_field(writer, job->path);
+        write_text(writer, ",");
+        write_csv_field(writer, method);
+        if (job->error != NULL) {
+            write_text(writer, ",,,,,,");
+            write_csv_field(writer, job->error);
+        } else {
+            write_text(writer, ",");
+            write_integer(writer, job->nb_candidates);
+            write_text(writer, ",");
+            write_integer(writer, job->ballots);
+            write_text(writer, ",");
+            write_integer(writer, job->rejected);
+            write_text(writer, ",");
+            write_integer(writer, job->winner);
+            write_text(writer, ",");
+            write_csv_field(writer, job->winner_name);
+            write_text(writer, ",");
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_JSON:
+        write_text(writer, "{\"type\":\"election\",\"file\":");
+        write_json_string(writer, job->path);
+        write_text(writer, ",\"method\":");
+        write_json_string(writer, method);
+        if (job->error != NULL) {
+            write_text(writer, ",\"error\":");
+            write_json_string(writer, job->error);
+        } else {
+            write_text(writer, ",\"candidates\":");
+            write_integer(writer, job->nb_candidates);
+            write_text(writer, ",\"ballots\":");
+            write_integer(writer, job->ballots);
+            write_text(writer, ",\"rejected\":");
+            write_integer(writer, job->rejected);
+            write_text(writer, ",\"winner\":");
+            write_integer(writer, job->winner);
+            write_text(writer, ",\"name\":");
+            write_json_string(writer, job->winner_name);
+        }
+        write_text(writer, "}\n");
+        break;
+    case FORMAT_BINARY:
+        write_bytes(writer, &(uint8_t){RECORD_ELECTION}, 1);
+        write_binary_string(writer, job->path);
+        write_binary_string(writer, method);
+        write_bytes(writer, &(uint8_t){job->error == NULL}, 1);
+        if (job->error != NULL) {
+            write_binary_string(writer, job->error);
+        } else {
+            write_u32(writer, job->nb_candidates);
+            write_u32(writer, job->ballots);
+            write_u32(writer, job->rejected);
+            write_u32(writer, job->winner);
+            write_binary_string(writer, job->winner_name);
+        }
+        break;
+    }
+}
+
+int write_batch_records(const Batch *batch, ptrWriter writer) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    if (writer->format == FORMAT_CSV)
+        write_text(writer, "file,method,candidates,ballots,rejected,winner,"
+                           "name,error\n");
+    int failed = 0;
+    for (uint i = 0; i < batch->nb_jobs; i++) {
+        write_batch_record(writer, batch->method, &batch->jobs[i]);
+        if (batch->jobs[i].error != NULL)
+            failed++;
+    }
+    STATS_END(PHASE_OUTPUT);
+    return failed;
+}
+
+void delete_batch(ptrBatch batch) {
+    if (batch == NULL)
+        return;
+    for (uint i = 0; i < batch->nb_jobs; i++) {
+        mem_free(batch->jobs[i].path);
+        mem_free(batch->jobs[i].winner_name);
+    }
+    mem_free(batch->jobs);
+    pthread_mutex_destroy(&batch->lock);
+    mem_free(batch);
+}
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Counting Batches of Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "election.h"
+#include "trace.h"
+#include "writer.h"
+#include <pthread.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Batch Batches of Elections
+ * @{
+ */
+
+/**
+ * @brief One election of a batch and its result.
+ */
+typedef struct s_batch_job {
+    char *path;        /**< The ballot file */
+    int nb_candidates; /**< Inferred from the file */
+    uint ballots;      /**< Ballots counted */
+    uint rejected;     /**< Rows rejected while parsing */
+    int winner;        /**< Index of the winner, -1 on error */
+    char *winner_name; /**< Name of the winner */
+    const char *error; /**< Why the election failed, NULL if it did not */
+} BatchJob;
+
+/**
+ * @brief Elections counted with the same method by a pool of workers.
+ */
+typedef struct s_batch {
+    BatchJob *jobs;          /**< The elections, in the order added */
+    uint nb_jobs;            /**< The number of elections */
+    uint capacity;           /**< The number of jobs allocated */
+    ElectionOptions options; /**< The method of every count */
+    const char *method;      /**< Its name, for the records */
+    const char *cache_dir;   /**< The tally cache, NULL for none */
+    ptrTrace trace;          /**< Recorded by the workers, NULL for none */
+    uint next;               /**< First job not taken by a worker */
+    pthread_mutex_t lock;    /**< Protects next */
+} Batch;
+
+/**
+ * @brief Typedef for a pointer to a Batch structure.
+ */
+typedef Batch *ptrBatch;
+
+/**
+ * @brief Allocates an empty batch.
+ *
+ * @param[in] options The method of every count.
+ * @param[in] method The name of the method, as given on the command line.
+ * @param[in] cache_dir The tally cache directory, NULL for none.
+ * @return The batch, or NULL if memory allocation fails.
+ *
+ * @post The returned Batch must be freed with delete_batch.
+ */
+ptrBatch init_batch(const ElectionOptions *options, const char *method,
+                    const char *cache_dir);
+
+/**
+ * @brief Adds the elections of a directory or of a manifest.
+ *
+ * A directory adds every `.csv` file it holds, sorted by name. A manifest is
+ * a text file naming one ballot file per line, blank lines and lines
+ * starting with `#` being ignored.
+ *
+ * @param[in,out] batch The batch.
+ * @param[in] path The directory or the manifest.
+ * @return The number of elections added, -1 on failure.
+ */
+int add_batch_path(ptrBatch batch, const char *path);
+
+/**
+ * @brief Counts every election of a batch on a pool of worker threads.
+ *
+ * Workers take the next election until none is left. Each one keeps its own
+ * tallies from an election to the next, so their buffers are allocated once
+ * per worker instead of once per election.
+ *
+ * @param[in,out] batch The batch.
+ * @param[in] nb_workers The number of threads, 0 for one per processor.
+ * @return 0 on success, -1 if no worker could start.
+ */
+int run_batch(ptrBatch batch, int nb_workers);
+
+/**
+ * @brief Writes one record per election, in the order they were added.
+ *
+ * The text format gives a line per election, CSV a header and then a row
+ * per election, JSON an object of type "election" per line and the binary
+ * format a RECORD_ELECTION per election (see the Writer group).
+ *
+ * @param[in] batch The counted batch.
+ * @param[in,out] writer The writer of the records.
+ * @return The number of elections that failed.
+ */
+int write_batch_records(const Batch *batch, ptrWriter writer);
+
+/**
+ * @brief Frees a batch.
+ *
+ * @param[in] batch The batch to free, may be NULL.
+ */
+void delete_batch(ptrBatch batch);
+
+/** @} */ // End of Batch group
+
+#endif // BATCH_H
@@ -0,0 +1,355 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Bootstrap Resampling of an Election
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "bootstrap.h"
+#include "allocator.h"
+#include "arena.h"
+#include "first_past_the_post.h"
+#include "random.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+// Resamples taken at once by a worker
+#define RESAMPLE_BLOCK 16
+
+// FNV-1a over the ranks of a ballot
+static uint64_t hash_ranks(const rank_t *ranks, uint size) {
+    uint64_t hash = 0xcbf29ce484222325u;
+    for (uint c = 0; c < size; c++)
+        hash = (hash ^ ranks[c]) * 0x100000001b3u;
+    return hash;
+}
+
+static int add_distinct_ballot(BallotProfile *profile, const rank_t *row) {
+    uint n = profile->nb_candidates;
+    if (profile->nb_distinct == profile->capacity) {
+        uint capacity = profile->capacity ? profile->capacity * 2 : 64;
+        rank_t *ranks = mem_realloc(profile->ranks, (size_t)capacity * n);
+        if (ranks == NULL)
+            return -1;
+        profile->ranks = ranks;
+        uint *counts = mem_realloc(profile->counts, sizeof(uint) * capacity);
+        if (counts == NULL)
+            return -1;
+        profile->counts = counts;
+        int *choices =
+            mem_realloc(profile->first_choices, sizeof(int) * capacity);
+        if (choices == NULL)
+            return -1;
+        profile->first_choices = choices;
+        profile->capacity = capacity;
+    }
+    uint d = profile->nb_distinct++;
+    memcpy(&profile->ranks[(size_t)d * n], row, n);
+    profile->counts[d] = 0;
+    // As in build_first_choice_index, a shared best rank chooses no one
+    rank_t best = RANK_NONE;
+    profile->first_choices[d] = -1;
+    for (uint c = 0; c < n; c++) {
+        if (row[c] == RANK_NONE || (best != RANK_NONE && row[c] > best))
+            continue;
+        profile->first_choices[d] =
+            best == RANK_NONE || row[c] < best ? (int)c : -1;
+        best = row[c];
+    }
+    return 0;
+}
+
+BallotProfile *init_ballot_profile(const Ballots *ballots) {
+    if (ballots == NULL || ballots->columns == 0)
+        return NULL;
+    BallotProfile *profile = mem_calloc(1, sizeof(BallotProfile));
+    if (profile == NULL)
+        return NULL;
+    uint n = profile->nb_candidates = ballots->columns;
+    profile->nb_ballots = ballots->rows;
+
+    // Open addressing, slots hold a distinct ballot + 1, at most half full
+    size_t nb_slots = 16;
+    while (nb_slots < 2 * (size_t)ballots->rows)
+        nb_slots *= 2;
+    uint *slots = mem_calloc(nb_slots, sizeof(uint));
+    if (slots == NULL) {
+        delete_ballot_profile(profile);
+        return NULL;
+    }
+    rank_t row[MAX_TAB];
+    for (uint b = 0; b < ballots->rows; b++) {
+        for (uint c = 0; c < n; c++)
+            row[c] = get_ballot_rank(ballots, b, c);
+        size_t slot = hash_ranks(row, n) & (nb_slots - 1);
+        while (slots[slot] != 0 &&
+               memcmp(&profile->ranks[(size_t)(slots[slot] - 1) * n], row,
+                      n) != 0)
+            slot = (slot + 1) & (nb_slots - 1);
+        if (slots[slot] == 0) {
+            if (add_distinct_ballot(profile, row) != 0) {
+                mem_free(slots);
+                delete_ballot_profile(profile);
+                return NULL;
+            }
+            slots[slot] = profile->nb_distinct;
+        }
+        profile->counts[slots[slot] - 1]++;
+    }
+    mem_free(slots);
+    return profile;
+}
+
+void delete_ballot_profile(BallotProfile *profile) {
+    if (profile == NULL)
+        return;
+    mem_free(profile->ranks);
+    mem_free(profile->counts);
+    mem_free(profile->first_choices);
+    mem_free(profile);
+}
+
+bool can_bootstrap(const ElectionOptions *options) {
+    switch (options->method) {
+    case UNI1:
+    case UNI2:
+    case CM:
+    case CP:
+    case CS:
+    case JM:
+    case BUCKLIN:
+    case MEDIAN:
+    case BALDWIN:
+    case NANSON:
+        return true;
+    case BORDA:
+    case DOWDALL:
+    case APPROVAL:
+    case SCORING:
+        return options->policy == TRUNCATION_ZERO;
+    default:
+        return false;
+    }
+}
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief What the workers share.
+ */
+typedef struct s_bootstrap {
+    const Tallies *tallies;         /**< Of the election */
+    const ElectionOptions *options; /**< The method */
+    const BallotProfile *profile;   /**< Its distinct ballots */
+    uint64_t seed;                  /**< Of every resample */
+    uint nb_resamples;              /**< The number of resamples */
+    atomic_uint next;               /**< First resample not taken */
+} Bootstrap;
+
+typedef struct s_bootstrap_worker {
+    Bootstrap *bootstrap;
+    uint wins[MAX_TAB]; /**< Resamples won by each candidate */
+    int undecided;      /**< Resamples without a single winner */
+    bool failed;
+} BootstrapWorker;
+
+// Drawing the voters one by one is a multinomial over the distinct ballots,
+// drawn as a binomial for each given the ones before it
+static void draw_weights(const BallotProfile *profile, uint64_t seed,
+                         uint resample, uint *weights) {
+    RandomStream stream;
+    init_random_stream(&stream, seed, resample);
+    uint left = profile->nb_ballots, rest = profile->nb_ballots;
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        uint count = profile->counts[d];
+        weights[d] = left == 0       ? 0
+                     : count == rest ? left
+                                     : next_binomial(&stream, left,
+                                                     (double)count / rest);
+        left -= weights[d];
+        rest -= count;
+    }
+}
+
+// Tallies of the candidates of an election and none of its ballots
+static ptrTallies init_resample_tallies(const Tallies *tallies) {
+    ptrTallies resample = init_tallies();
+    if (resample == NULL)
+        return NULL;
+    uint n = tallies->ballots->columns;
+    for (uint c = 0; c < n; c++) {
+        const StringBuffer *tag = tallies->ballots->tags[c];
+        resample->ballots->tags[c] = init_stringbuffer(tag->string, tag->size);
+        resample->duel->tags[c] = init_stringbuffer(tag->string, tag->size);
+    }
+    resample->ballots->columns = n;
+    resample->duel->rows = resample->duel->columns = n;
+    resample->histogram->rows = n;
+    resample->histogram->columns = tallies->histogram->columns;
+    resample->histogram->ballots = tallies->ballots->rows;
+    resample->has_ballots = false;
+    return resample;
+}
+
+// Every tally is a sum over the distinct ballots, weighted by the resample
+static void set_resample_tallies(ptrTallies resample,
+                                 const BallotProfile *profile,
+                                 const uint *weights) {
+    uint n = profile->nb_candidates;
+    ptrHistogram histogram = resample->histogram;
+    for (uint i = 0; i < n; i++) {
+        memset(resample->duel->data[i], 0, sizeof(int) * n);
+        memset(histogram->counts[i], 0, sizeof(uint) * histogram->columns);
+    }
+    memset(resample->first_choices, 0, sizeof(int) * n);
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        uint weight = weights[d];
+        if (weight == 0)
+            continue;
+        const rank_t *row = &profile->ranks[(size_t)d * n];
+        if (profile->first_choices[d] != -1)
+            resample->first_choices[profile->first_choices[d]] += weight;
+        for (uint i = 0; i < n; i++) {
+            histogram->counts[i][row[i]] += weight;
+            if (row[i] == RANK_NONE)
+                continue;
+            int *wins = resample->duel->data[i];
+            for (uint j = 0; j < n; j++)
+                wins[j] += row[j] != RANK_NONE && row[i] < row[j] ? weight : 0;
+        }
+    }
+}
+
+static int find_argmax(const int *values, int size) {
+    int best = 0;
+    for (int i = 1; i < size; i++) {
+        if (values[i] > values[best])
+            best = i;
+    }
+    return best;
+}
+
+// The runoff of first_past_the_post_runoff_results, on the distinct ballots
+static int find_resample_runoff_winner(const Tallies *resample,
+                                       const BallotProfile *profile,
+                                       const uint *weights) {
+    int n = profile->nb_candidates, size;
+    int totals[MAX_TAB];
+    memcpy(totals, resample->first_choices, sizeof(int) * n);
+    int *finalists = get_candidates_for_next_round(totals, n, &size);
+    if (size != 2 || finalists[1] < 0) {
+        mem_free(finalists);
+        return find_argmax(totals, n);
+    }
+    int first = finalists[0], second = finalists[1];
+    mem_free(finalists);
+    memset(totals, 0, sizeof(int) * n);
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        const rank_t *row = &profile->ranks[(size_t)d * n];
+        rank_t a = row[first], b = row[second];
+        if (a != RANK_NONE && (b == RANK_NONE || a < b))
+            totals[first] += weights[d];
+        else if (b != RANK_NONE && (a == RANK_NONE || b < a))
+            totals[second] += weights[d];
+    }
+    return find_argmax(totals, n);
+}
+
+static void *run_bootstrap_worker(void *argument) {
+    BootstrapWorker *worker = argument;
+    Bootstrap *bootstrap = worker->bootstrap;
+    const BallotProfile *profile = bootstrap->profile;
+    ptrTallies resample = init_resample_tallies(bootstrap->tallies);
+    uint *weights = mem_alloc(sizeof(uint) * profile->nb_distinct + 1);
+    ptrArena arena = init_arena(ARENA_BLOCK_SIZE);
+    if (resample == NULL || weights == NULL || arena == NULL) {
+        worker->failed = true;
+        bootstrap->next = bootstrap->nb_resamples;
+    }
+    while (!worker->failed) {
+        uint first = atomic_fetch_add(&bootstrap->next, RESAMPLE_BLOCK);
+        if (first >= bootstrap->nb_resamples)
+            break;
+        uint last = first + RESAMPLE_BLOCK < bootstrap->nb_resamples
+                        ? first + RESAMPLE_BLOCK
+                        : bootstrap->nb_resamples;
+        for (uint k = first; k < last; k++) {
+            draw_weights(profile, bootstrap->seed, k, weights);
+            set_resample_tallies(resample, profile, weights);
+            // The scratch space of the count is dropped with the arena
+            const Allocator *previous =
+                set_thread_allocator(get_arena_allocator(arena));
+            int winner =
+                bootstrap->options->method == UNI2
+                    ? find_resample_runoff_winner(resample, profile, weights)
+                    : find_election_winner(resample, bootstrap->options);
+            set_thread_allocator(previous);
+            reset_arena(arena);
+            if (winner < 0)
+                worker->undecided++;
+            else
+                worker->wins[winner]++;
+        }
+    }
+    delete_arena(arena);
+    mem_free(weights);
+    delete_tallies(resample);
+    return NULL;
+}
+
+int run_bootstrap(const Tallies *tallies, const ElectionOptions *options,
+                  uint nb_resamples, uint64_t seed, int nb_workers,
+                  uint *wins) {
+    if (tallies == NULL || options == NULL || wins == NULL ||
+        !tallies->has_ballots || !can_bootstrap(options))
+        return -1;
+    if (nb_workers <= 0)
+        nb_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_workers <= 0)
+        nb_workers = 1;
+    if ((uint)nb_workers > nb_resamples)
+        nb_workers = nb_resamples ? nb_resamples : 1;
+
+    BallotProfile *profile = init_ballot_profile(tallies->ballots);
+    BootstrapWorker *workers = mem_calloc(nb_workers, sizeof(BootstrapWorker));
+    pthread_t *threads = mem_alloc(sizeof(pthread_t) * nb_workers);
+    if (profile == NULL || workers == NULL || threads == NULL) {
+        delete_ballot_profile(profile);
+        mem_free(workers);
+        mem_free(threads);
+        return -1;
+    }
+    Bootstrap bootstrap = {tallies, options, profile, seed, nb_resamples, 0};
+    int started = 0;
+    for (; started < nb_workers; started++) {
+        workers[started].bootstrap = &bootstrap;
+        if (pthread_create(&threads[started], NULL, run_bootstrap_worker,
+                           &workers[started]) != 0)
+            break;
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    // The workers started take every resample between them
+    int undecided = started > 0 ? 0 : -1;
+    memset(wins, 0, sizeof(uint) * tallies->ballots->columns);
+    for (int i = 0; i < started && undecided >= 0; i++) {
+        if (workers[i].failed) {
+            undecided = -1;
+            break;
+        }
+        for (uint c = 0; c < tallies->ballots->columns; c++)
+            wins[c] += workers[i].wins[c];
+        undecided += workers[i].undecided;
+    }
+    delete_ballot_profile(profile);
+    mem_free(workers);
+    mem_free(threads);
+    return undecided;
+}
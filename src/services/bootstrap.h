@@ -0,0 +1,86 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Bootstrap Resampling of an Election
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef BOOTSTRAP_H
+#define BOOTSTRAP_H
+
+#include "election.h"
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Bootstrap Bootstrap Resampling
+ * @{
+ *
+ * Each resample draws as many ballots as the election, with replacement.
+ * Only the distinct ballots are kept, each resample being a multinomial
+ * weight per distinct ballot, and the tallies of a resample are weighted
+ * sums over them. Resample k draws from its own random stream, so the
+ * frequencies only depend on the seed, not on the number of threads.
+ */
+
+/**
+ * @brief The distinct ballots of an election.
+ */
+typedef struct s_ballot_profile {
+    rank_t *ranks;      /**< nb_candidates ranks per distinct ballot */
+    uint *counts;       /**< The voters who cast each of them */
+    int *first_choices; /**< Their single best candidate, -1 for none */
+    uint nb_distinct;   /**< The number of distinct ballots */
+    uint capacity;      /**< The number of distinct ballots allocated */
+    uint nb_candidates; /**< The number of candidates */
+    uint nb_ballots;    /**< The number of voters */
+} BallotProfile;
+
+/**
+ * @brief Groups the identical ballots of a ballot store.
+ *
+ * @param[in] ballots The ballots of the election.
+ * @return The profile, or NULL if memory allocation fails.
+ *
+ * @post The returned profile must be freed with delete_ballot_profile.
+ */
+BallotProfile *init_ballot_profile(const Ballots *ballots);
+
+/**
+ * @brief Frees a profile.
+ *
+ * @param[in] profile The profile to free, may be NULL.
+ */
+void delete_ballot_profile(BallotProfile *profile);
+
+/**
+ * @brief Whether a method only needs what a resample tallies.
+ *
+ * The duel matrix, the first choices and the histogram are weighted, the
+ * two-round runoff is counted on the distinct ballots. Coombs and the Smith
+ * hybrids eliminate on the ballots themselves, the seat allocations and ALL
+ * have no single winner.
+ */
+bool can_bootstrap(const ElectionOptions *options);
+
+/**
+ * @brief Counts how often each candidate wins the resamples of an election.
+ *
+ * @param[in] tallies The tallies of the election, with its ballots.
+ * @param[in] options The method and its parameters.
+ * @param[in] nb_resamples The number of resamples.
+ * @param[in] seed The seed of every resample.
+ * @param[in] nb_workers The number of threads, 0 for one per processor.
+ * @param[out] wins The resamples won by each candidate.
+ * @return The number of resamples without a single winner, -1 if the
+ * method cannot be bootstrapped or on failure.
+ */
+int run_bootstrap(const Tallies *tallies, const ElectionOptions *options,
+                  uint nb_resamples, uint64_t seed, int nb_workers,
+                  uint *wins);
+
+/** @} */ // End of Bootstrap group
+
+#endif // BOOTSTRAP_H
@@ -0,0 +1,152 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Counting an Election with Any Method
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "election.h"
+#include "allocator.h"
+#include "bucklin.h"
+#include "condorcet.h"
+#include "elimination.h"
+#include "first_past_the_post.h"
+#include "majority_judgement.h"
+#include "smith.h"
+#include <stdlib.h>
+
+/*-----------------------------------------------------------------*/
+
+void init_election_options(ElectionOptions *options, enum Method method) {
+    options->method = method;
+    options->approvals = 1;
+    options->policy = TRUNCATION_ZERO;
+}
+
+/**
+ * @brief Takes the first candidate of a ranking and frees it.
+ */
+static int first_of_ranking(CandidateScore *ranking) {
+    if (ranking == NULL)
+        return -1;
+    int winner = ranking[0].candidate;
+    mem_free(ranking);
+    return winner;
+}
+
+static int find_argmax(const int *values, int size) {
+    int best = 0;
+    for (int i = 1; i < size; i++) {
+        if (values[i] > values[best])
+            best = i;
+    }
+    return best;
+}
+
+static int find_runoff_winner(const Ballots *ballots) {
+    FirstChoiceIndex *index = build_first_choice_index(ballots);
+    if (index == NULL)
+        return -1;
+    ptrMatrix results = first_past_the_post_runoff_results(ballots, index);
+    int winner = -1;
+    if (results != NULL) {
+        winner = find_argmax(results->data[results->rows - 1],
+                             results->columns);
+        delete_matrix(results);
+    }
+    delete_first_choice_index(index);
+    return winner;
+}
+
+static int find_scoring_winner(const Tallies *tallies,
+                               const ElectionOptions *options) {
+    int nb_candidates = tallies->ballots->columns;
+    ScoringRule rule;
+    if (options->method == DOWDALL)
+        set_dowdall_rule(&rule, nb_candidates);
+    else if (options->method == APPROVAL)
+        set_approval_rule(&rule, nb_candidates, options->approvals);
+    else
+        set_borda_rule(&rule, nb_candidates);
+
+    double scores[MAX_TAB];
+    if (options->policy == TRUNCATION_ZERO)
+        compute_scoring_rules_from_histogram(tallies->histogram, &rule, 1,
+                                             scores);
+    else if (!tallies->has_ballots ||
+             compute_scoring_rules(tallies->ballots, &rule, 1,
+                                   options->policy, scores) != 0)
+        return -1;
+    return first_of_ranking(rank_by_score(scores, nb_candidates));
+}
+
+static int find_smith_winner(const Tallies *tallies, enum Method method) {
+    SmithWinners winners;
+    if (find_smith_hybrid_winners(tallies->duel, tallies->ballots,
+                                  &winners) != 0)
+        return -1;
+    if (method == SMITH_IRV)
+        return winners.smith_irv;
+    return method == TIDEMAN ? winners.tideman : winners.woodall;
+}
+
+int find_election_winner(const Tallies *tallies,
+                         const ElectionOptions *options) {
+    if (tallies == NULL || options == NULL || tallies->ballots->columns == 0)
+        return -1;
+    ptrMatrix duel = tallies->duel;
+    int nb_candidates = tallies->ballots->columns;
+    int winner = -1, round;
+
+    switch (options->method) {
+    case UNI1:
+        return find_argmax(tallies->first_choices, nb_candidates);
+    case UNI2:
+        return tallies->has_ballots ? find_runoff_winner(tallies->ballots)
+                                    : -1;
+    case CM:
+        if (!find_condorcet_winner(duel, nb_candidates, &winner))
+            winner = find_minimax_condorcet_winner(duel, nb_candidates);
+        return winner;
+    case CP:
+        return first_of_ranking(
+            find_ranked_pairs_condorcet_winner(duel, nb_candidates));
+    case CS:
+        if (!find_condorcet_winner(duel, nb_candidates, &winner))
+            winner = find_schulze_condorcet_winner(duel, nb_candidates);
+        return winner;
+    case JM:
+        return first_of_ranking(majority_judgement_ranking(tallies->histogram));
+    case BORDA:
+    case DOWDALL:
+    case APPROVAL:
+    case SCORING:
+        return find_scoring_winner(tallies, options);
+    case BUCKLIN:
+        return find_bucklin_winner(tallies->histogram, &round);
+    case MEDIAN:
+        return first_of_ranking(median_rank_ranking(tallies->histogram));
+    case BALDWIN:
+        return find_baldwin_winner(duel, nb_candidates);
+    case NANSON:
+        return find_nanson_winner(duel, nb_candidates);
+    case COOMBS:
+        return tallies->has_ballots ? find_coombs_winner(tallies->ballots)
+                                    : -1;
+    case SMITH_IRV:
+    case TIDEMAN:
+    case WOODALL:
+        if (!tallies->has_ballots)
+            return -1;
+        return find_smith_winner(tallies, options->method);
+    case DHONDT:
+    case SAINTE_LAGUE:
+    case HARE:
+    case DROOP:
+    case ALL:
+    case UNKNOWN:
+        break;
+    }
+    return -1;
+}
@@ -0,0 +1,52 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Counting an Election with Any Method
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef ELECTION_H
+#define ELECTION_H
+
+#include "cache.h"
+#include "miscellaneous.h"
+#include "scoring_rules.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief The method of a count and its parameters.
+ */
+typedef struct s_election_options {
+    enum Method method;           /**< The method to run */
+    int approvals;                /**< Approved ranks of approval voting */
+    enum TruncationPolicy policy; /**< Truncation policy of scoring rules */
+} ElectionOptions;
+
+/**
+ * @brief Sets the default options of a method, as VotingMethods uses them.
+ *
+ * @param[out] options The options to set.
+ * @param[in] method The method to run.
+ */
+void init_election_options(ElectionOptions *options, enum Method method);
+
+/**
+ * @brief Finds the single winner of an election.
+ *
+ * Every method reads the tallies it needs: the duel matrix for the
+ * Condorcet and Borda elimination methods, the histogram for Majority
+ * Judgement, Bucklin and the scoring rules, the ballots for the runoffs.
+ * SCORING ranks by its first rule, Borda. The seat allocations and ALL have
+ * no single winner.
+ *
+ * @param[in] tallies The tallies of the election.
+ * @param[in] options The method and its parameters.
+ * @return The index of the winner, -1 if the method has no single winner,
+ * needs ballots that the tallies do not have, or fails.
+ */
+int find_election_winner(const Tallies *tallies,
+                         const ElectionOptions *options);
+
+#endif // ELECTION_H
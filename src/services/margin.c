@@ -0,0 +1,784 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Margins of Victory
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "margin.h"
+#include "allocator.h"
+#include "bootstrap.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+// A ballot tied between its best candidates, or ranking none of them
+#define TOP_TIED -1
+#define TOP_NONE -2
+
+// Rewrites tried one by one before bisecting
+#define SCANNED_REWRITES 32
+// The distinct ballots the lower bound search may visit over all its bars,
+// a node visiting all of them once per child
+#define EXPLORED_BALLOTS ((int64_t)1 << 29)
+
+static int find_argmax(const int *values, int size) {
+    int best = 0;
+    for (int i = 1; i < size; i++) {
+        if (values[i] > values[best])
+            best = i;
+    }
+    return best;
+}
+
+static int64_t min64(int64_t a, int64_t b) { return a < b ? a : b; }
+
+static int64_t max64(int64_t a, int64_t b) { return a > b ? a : b; }
+
+/*-----------------------------------------------------------------*/
+
+// A challenger leads once every rival is brought under its total by the
+// ballots rewritten for it, each taken from a rival
+static bool can_lead(const int *totals, int size, int challenger,
+                     int64_t rewritten) {
+    int64_t target = totals[challenger] + rewritten, taken = 0;
+    for (int e = 0; e < size; e++) {
+        if (e != challenger && totals[e] >= target)
+            taken += totals[e] - target + 1;
+    }
+    return taken <= rewritten;
+}
+
+static int find_plurality_margin(const int *totals, int size, int winner,
+                                 int64_t nb_ballots) {
+    if (size < 2 || nb_ballots == 0)
+        return -1;
+    int64_t margin = nb_ballots;
+    for (int c = 0; c < size; c++) {
+        if (c == winner)
+            continue;
+        // Rewriting every ballot for the challenger always makes it lead
+        int64_t lo = 0, hi = nb_ballots;
+        while (hi - lo > 1) {
+            int64_t mid = lo + (hi - lo) / 2;
+            if (can_lead(totals, size, c, mid))
+                hi = mid;
+            else
+                lo = mid;
+        }
+        margin = min64(margin, hi);
+    }
+    return margin;
+}
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief The ballots of an election seen from one runoff, a challenger
+ * against an opponent.
+ *
+ * Rewriting a ballot for the challenger closes the runoff gap by 2 when the
+ * ballot preferred the opponent, by 1 when it preferred neither and by 0
+ * when it already preferred the challenger.
+ */
+typedef struct s_runoff_groups {
+    int64_t votes[MAX_TAB + 1];    /**< Per first choice, the last for none */
+    int64_t opposing[MAX_TAB + 1]; /**< Of them, preferring the opponent */
+    int64_t neutral[MAX_TAB + 1];  /**< Of them, preferring neither */
+    int64_t gap;         /**< Opponent's runoff votes minus challenger's */
+    int64_t total;       /**< Ballots with a first choice */
+    int64_t top;         /**< Most first choices of another candidate */
+    int64_t penalty;     /**< Cost of one ballot that does not exist */
+    int size;            /**< The number of candidates */
+    int challenger;      /**< Wanted as winner */
+    int opponent;        /**< Beaten by the challenger in the runoff */
+} RunoffGroups;
+
+/**
+ * @brief Ballots rewritten for the challenger, and those left to rewrite.
+ */
+typedef struct s_rewrite {
+    int64_t count;   /**< Ballots rewritten */
+    int64_t closed;  /**< Runoff gap they close */
+    int64_t twos;    /**< Ballots left closing 2 */
+    int64_t ones;    /**< Ballots left closing 1 */
+    int64_t zeros;   /**< Ballots left closing nothing */
+    int64_t missing; /**< Ballots wanted that do not exist */
+} Rewrite;
+
+// Takes the ballots closing the gap most first
+static void take_ballots(Rewrite *rewrite, int64_t twos, int64_t ones,
+                         int64_t zeros, int64_t wanted) {
+    int64_t two = min64(wanted, twos);
+    int64_t one = min64(wanted - two, ones);
+    int64_t zero = min64(wanted - two - one, zeros);
+    rewrite->count += two + one + zero;
+    rewrite->closed += 2 * two + one;
+    rewrite->twos += twos - two;
+    rewrite->ones += ones - one;
+    rewrite->zeros += zeros - zero;
+    rewrite->missing += wanted - two - one - zero;
+}
+
+static void set_runoff_groups(RunoffGroups *groups,
+                              const BallotProfile *profile, int challenger,
+                              int opponent) {
+    int n = profile->nb_candidates;
+    memset(groups, 0, sizeof(RunoffGroups));
+    groups->size = n;
+    groups->challenger = challenger;
+    groups->opponent = opponent;
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        const rank_t *row = &profile->ranks[(size_t)d * n];
+        int first = profile->first_choices[d] == -1
+                        ? n
+                        : profile->first_choices[d];
+        int64_t count = profile->counts[d];
+        rank_t a = row[challenger], b = row[opponent];
+        groups->votes[first] += count;
+        if (a != RANK_NONE && (b == RANK_NONE || a < b)) {
+            groups->gap -= count;
+        } else if (b != RANK_NONE && (a == RANK_NONE || b < a)) {
+            groups->gap += count;
+            groups->opposing[first] += count;
+        } else {
+            groups->neutral[first] += count;
+        }
+    }
+    for (int e = 0; e < n; e++) {
+        groups->total += groups->votes[e];
+        if (e != challenger && e != opponent)
+            groups->top = max64(groups->top, groups->votes[e]);
+    }
+    groups->penalty = 4 * ((int64_t)profile->nb_ballots + 1);
+}
+
+/**
+ * @brief Twice the fewest ballots making the challenger win the runoff
+ * against the opponent, once every other candidate is held to `ceiling`
+ * first choices and `shifted` first choices of the opponent are rewritten
+ * for the challenger.
+ *
+ * Within those constraints the cheapest rewrite is greedy, and a missing
+ * ballot costs more than any rewrite. As a linear program over the ceiling
+ * and the shift, the cost is convex in both.
+ */
+static int64_t get_runoff_cost(const RunoffGroups *groups, int64_t ceiling,
+                               int64_t shifted) {
+    int c = groups->challenger, d = groups->opponent, n = groups->size;
+    bool others = n > 2;
+    int64_t kept = groups->votes[d] - shifted;
+    // Both finalists must end above the ceiling, and the opponent must not
+    // hold a majority of the ballots with a first choice
+    int64_t opponent = others ? max64(ceiling + 1, kept) : kept;
+    int64_t to_challenger =
+        others ? max64(0, ceiling + 1 - groups->votes[c] - shifted) : 0;
+    int64_t to_opponent = opponent - kept;
+
+    Rewrite rewrite = {0};
+    for (int e = 0; e <= n; e++) {
+        if (e == c || e == d)
+            continue;
+        // The ballots without a first choice raise the majority threshold
+        int64_t wanted = e < n ? groups->votes[e] - ceiling
+                               : 2 * opponent - groups->total;
+        take_ballots(&rewrite, groups->opposing[e], groups->neutral[e],
+                     groups->votes[e] - groups->opposing[e] -
+                         groups->neutral[e],
+                     max64(0, wanted));
+    }
+    int64_t count = max64(rewrite.count, to_challenger + to_opponent);
+    Rewrite extra = {0};
+    take_ballots(&extra, rewrite.twos, rewrite.ones, rewrite.zeros,
+                 count - rewrite.count);
+
+    // The rest of the gap is closed two by two, by the ballots preferring
+    // the opponent, then one by one
+    int64_t cost = 2 * (count + shifted);
+    int64_t missing = rewrite.missing + extra.missing;
+    int64_t gap =
+        groups->gap + 1 - rewrite.closed - extra.closed - 2 * shifted;
+    if (gap > 0) {
+        int64_t twos = extra.twos + kept;
+        if (2 * twos >= gap) {
+            cost += gap;
+        } else {
+            int64_t ones = min64(gap - 2 * twos, extra.ones);
+            cost += 2 * twos + 2 * ones;
+            missing += gap - 2 * twos - ones;
+        }
+    }
+    return cost + groups->penalty * missing;
+}
+
+static int64_t get_best_shift(const RunoffGroups *groups, int64_t ceiling) {
+    int64_t lo = 0, hi = groups->votes[groups->opponent];
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (get_runoff_cost(groups, ceiling, mid) <=
+            get_runoff_cost(groups, ceiling, mid + 1))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return get_runoff_cost(groups, ceiling, lo);
+}
+
+// The fewest ballots making the challenger beat the opponent in the runoff,
+// -1 if no rewrite does
+static int64_t get_runoff_margin(const RunoffGroups *groups) {
+    int64_t lo = 0, hi = groups->top;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (get_best_shift(groups, mid) <= get_best_shift(groups, mid + 1))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    int64_t cost = get_best_shift(groups, lo);
+    return cost < groups->penalty ? (cost + 1) / 2 : -1;
+}
+
+static int find_two_round_margin(const BallotProfile *profile, int winner) {
+    int n = profile->nb_candidates;
+    if (n < 2 || profile->nb_ballots == 0)
+        return -1;
+    RunoffGroups groups;
+    int64_t margin = -1;
+    for (int c = 0; c < n; c++) {
+        if (c == winner)
+            continue;
+        for (int d = 0; d < n; d++) {
+            if (d == c)
+                continue;
+            set_runoff_groups(&groups, profile, c, d);
+            // Or the challenger takes a majority in the first round
+            int64_t cost = get_runoff_margin(&groups);
+            int64_t majority = groups.total / 2 + 1 - groups.votes[c];
+            if (cost < 0 || majority < cost)
+                cost = majority;
+            if (margin < 0 || cost < margin)
+                margin = cost;
+        }
+    }
+    return margin;
+}
+
+/*-----------------------------------------------------------------*/
+
+// The best ranked continuing candidate of a ballot
+static int find_top(const rank_t *row, int n, const bool *continuing) {
+    int top = TOP_NONE;
+    rank_t best = RANK_NONE;
+    for (int c = 0; c < n; c++) {
+        if (!continuing[c] || row[c] == RANK_NONE ||
+            (best != RANK_NONE && row[c] > best))
+            continue;
+        top = best == RANK_NONE || row[c] < best ? c : TOP_TIED;
+        best = row[c];
+    }
+    return top;
+}
+
+/**
+ * @brief Counts an instant-runoff over weighted distinct ballots, with
+ * `extra` more ballots ranking only the favourite.
+ *
+ * A ballot counts for its unique best ranked continuing candidate. The
+ * count goes on until one candidate is left, which elects the same winner
+ * as stopping at a majority. A strict count fails on a tie for last place,
+ * unless the tied candidates hold no ballot, no ballot is tied and someone
+ * else holds one: eliminating them in any order then moves nothing. The
+ * eliminated candidates are written in order unless `eliminated` is NULL.
+ *
+ * @return The winner, -1 if a strict count meets a tie.
+ */
+static int count_irv(const BallotProfile *profile, const uint *weights,
+                     int favourite, int64_t extra, bool strict, short *tops,
+                     int *eliminated) {
+    int n = profile->nb_candidates, left = n;
+    bool continuing[MAX_TAB];
+    int64_t tallies[MAX_TAB] = {0}, tied = 0;
+    for (int c = 0; c < n; c++)
+        continuing[c] = true;
+    if (favourite >= 0)
+        tallies[favourite] = extra;
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        tops[d] =
+            find_top(&profile->ranks[(size_t)d * n], n, continuing);
+        if (tops[d] >= 0)
+            tallies[tops[d]] += weights[d];
+        else if (tops[d] == TOP_TIED)
+            tied += weights[d];
+    }
+    while (left > 1) {
+        // The last candidate among ties goes first, as in the Smith hybrids
+        int loser = -1, nb_tied = 0;
+        for (int c = 0; c < n; c++) {
+            if (!continuing[c])
+                continue;
+            if (loser == -1 || tallies[c] < tallies[loser]) {
+                loser = c;
+                nb_tied = 1;
+            } else if (tallies[c] == tallies[loser]) {
+                loser = c;
+                nb_tied++;
+            }
+        }
+        if (strict && nb_tied > 1 &&
+            (tallies[loser] > 0 || tied > 0 || nb_tied == left))
+            return -1;
+        continuing[loser] = false;
+        left--;
+        if (eliminated != NULL)
+            eliminated[n - 1 - left] = loser;
+        for (uint d = 0; d < profile->nb_distinct; d++) {
+            if (tops[d] != loser && tops[d] != TOP_TIED)
+                continue;
+            if (tops[d] == TOP_TIED)
+                tied -= weights[d];
+            tops[d] =
+                find_top(&profile->ranks[(size_t)d * n], n, continuing);
+            if (tops[d] >= 0)
+                tallies[tops[d]] += weights[d];
+            else if (tops[d] == TOP_TIED)
+                tied += weights[d];
+        }
+    }
+    for (int c = 0; c < n; c++) {
+        if (continuing[c])
+            return c;
+    }
+    return -1;
+}
+
+/**
+ * @brief What the workers bounding the instant-runoff margin share.
+ */
+typedef struct s_irv_search {
+    const BallotProfile *profile; /**< The distinct ballots */
+    int winner;                   /**< Of the instant-runoff count */
+    int runner_up;                /**< Last eliminated by the count */
+    uint *donors;                 /**< Distinct ballots rewritten first */
+    int64_t firsts[MAX_TAB];      /**< First choices of each candidate */
+    uint nb_tasks;                /**< Challengers, then pairs to explore */
+    atomic_uint next;             /**< First task not taken */
+    int64_t ceiling;              /**< Rewrites electing the runner-up */
+    atomic_llong upper;           /**< Best rewrite found */
+    atomic_llong lower;           /**< Cheapest order found below the bar */
+    int64_t bar;                  /**< Cost the orders are searched below */
+    int64_t budget;               /**< Nodes the pairs may expand */
+    atomic_llong expanded;        /**< Nodes expanded below the bar */
+    atomic_bool exceeded;         /**< The pairs ran out of budget */
+    atomic_bool failed;           /**< A worker could not allocate */
+} IrvSearch;
+
+// Takes ballots from the donors, the winner's supporters first, to give
+// them to the challenger
+static void rewrite_donors(const IrvSearch *search, int challenger,
+                           int64_t rewritten, uint *weights) {
+    const BallotProfile *profile = search->profile;
+    memcpy(weights, profile->counts, sizeof(uint) * profile->nb_distinct);
+    for (uint i = 0; i < profile->nb_distinct && rewritten > 0; i++) {
+        uint d = search->donors[i];
+        if (profile->first_choices[d] == challenger)
+            continue;
+        int64_t taken = min64(rewritten, weights[d]);
+        weights[d] -= taken;
+        rewritten -= taken;
+    }
+}
+
+static bool elects(const IrvSearch *search, int challenger,
+                   int64_t rewritten, uint *weights, short *tops) {
+    rewrite_donors(search, challenger, rewritten, weights);
+    return count_irv(search->profile, weights, challenger, rewritten, true,
+                     tops, NULL) == challenger;
+}
+
+static void lower_to(atomic_llong *bound, int64_t value) {
+    long long current = atomic_load(bound);
+    while (value < current &&
+           !atomic_compare_exchange_weak(bound, &current, value))
+        ;
+}
+
+// Rewriting every other ballot for the challenger elects it
+static int64_t count_other_ballots(const BallotProfile *profile,
+                                   int challenger) {
+    int64_t others = profile->nb_ballots;
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        if (profile->first_choices[d] == challenger)
+            others -= profile->counts[d];
+    }
+    return others;
+}
+
+// Searches the donor ballots electing a challenger, assuming more of them
+// never hurt. The count is not monotonic, taking many ballots from the
+// other candidates can tie them, so the steps double from few rewrites
+// before bisecting, and every smaller number is tried when there are few
+static int64_t find_fewest_rewrites(const IrvSearch *search, int challenger,
+                                    int64_t lo, int64_t hi, uint *weights,
+                                    short *tops) {
+    for (int64_t step = 1; lo + step < hi; step *= 2) {
+        if (elects(search, challenger, lo + step, weights, tops)) {
+            hi = lo + step;
+            break;
+        }
+        lo += step;
+    }
+    while (hi - lo > 1) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (elects(search, challenger, mid, weights, tops))
+            hi = mid;
+        else
+            lo = mid;
+    }
+    for (int64_t k = 1; k < hi && hi <= SCANNED_REWRITES; k++) {
+        if (elects(search, challenger, k, weights, tops))
+            return k;
+    }
+    return hi;
+}
+
+// The other challengers only need bisecting when they beat the rewrites
+// found for the runner-up, so the bound does not depend on the threads
+static void *run_upper_worker(void *argument) {
+    IrvSearch *search = argument;
+    const BallotProfile *profile = search->profile;
+    uint *weights = mem_alloc(sizeof(uint) * profile->nb_distinct + 1);
+    short *tops = mem_alloc(sizeof(short) * profile->nb_distinct + 1);
+    if (weights == NULL || tops == NULL)
+        search->failed = true;
+    while (!search->failed) {
+        uint c = atomic_fetch_add(&search->next, 1);
+        if (c >= search->nb_tasks)
+            break;
+        if ((int)c == search->winner || (int)c == search->runner_up)
+            continue;
+        int64_t hi = count_other_ballots(profile, c), lo = 0;
+        if (hi >= search->ceiling) {
+            hi = search->ceiling;
+            if (hi <= 1 || !elects(search, c, hi - 1, weights, tops))
+                lo = hi;
+            else
+                hi--;
+        }
+        lower_to(&search->upper,
+                 find_fewest_rewrites(search, c, lo, hi, weights, tops));
+    }
+    mem_free(weights);
+    mem_free(tops);
+    return NULL;
+}
+
+/**
+ * @brief A worker of the branch-and-bound, with the state of every level of
+ * its current elimination order.
+ *
+ * Level k holds, for each distinct ballot, its best rank and its top among
+ * the last k + 1 candidates of the order.
+ */
+typedef struct s_irv_worker {
+    IrvSearch *search;
+    rank_t *bests[MAX_TAB];
+    short *tops[MAX_TAB];
+    bool in_order[MAX_TAB];
+    int order[MAX_TAB];
+    int64_t best; /**< Cheapest order of the pair, or the bar */
+} IrvWorker;
+
+// The ballots rewritten for a tally to end below another, or both to hold
+// none, one rewritten ballot closing their gap by at most 2
+static int64_t get_gap_cost(int64_t tally, int64_t other) {
+    if (tally < other)
+        return 0;
+    return min64((tally - other) / 2 + 1, tally + other);
+}
+
+// Puts `added` before the candidates of the level below, returning a lower
+// bound on the ballots rewritten for it to be eliminated first among them.
+// Unless kept, the level is left as it was and only the bound is computed
+static int64_t add_to_order(IrvWorker *worker, int level, int added,
+                            bool keep) {
+    const BallotProfile *profile = worker->search->profile;
+    int n = profile->nb_candidates;
+    if (keep && worker->bests[level] == NULL) {
+        worker->bests[level] = mem_alloc(profile->nb_distinct + 1);
+        worker->tops[level] =
+            mem_alloc(sizeof(short) * profile->nb_distinct + 1);
+        if (worker->bests[level] == NULL || worker->tops[level] == NULL)
+            return -1;
+    }
+    rank_t *bests = worker->bests[level];
+    short *tops = worker->tops[level];
+    int64_t tallies[MAX_TAB] = {0};
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        rank_t rank = profile->ranks[(size_t)d * n + added];
+        rank_t best = level > 0 ? worker->bests[level - 1][d] : RANK_NONE;
+        short top = level > 0 ? worker->tops[level - 1][d] : TOP_NONE;
+        if (rank != RANK_NONE && (best == RANK_NONE || rank < best)) {
+            best = rank;
+            top = added;
+        } else if (rank != RANK_NONE && rank == best) {
+            top = TOP_TIED;
+        }
+        if (keep) {
+            bests[d] = best;
+            tops[d] = top;
+        }
+        if (top >= 0)
+            tallies[top] += profile->counts[d];
+    }
+    worker->order[level] = added;
+    // It must end below each of them
+    int64_t cost = 0;
+    for (int k = 0; k < level; k++)
+        cost = max64(cost, get_gap_cost(tallies[added],
+                                        tallies[worker->order[k]]));
+    // A candidate left out is eliminated before all of them, holding at
+    // least its first choices against at most their tallies here
+    bool placed[MAX_TAB] = {false};
+    for (int k = 0; k <= level; k++)
+        placed[worker->order[k]] = true;
+    for (int c = 0; c < n; c++) {
+        if (placed[c])
+            continue;
+        for (int k = 0; k <= level; k++)
+            cost = max64(cost, get_gap_cost(worker->search->firsts[c],
+                                            tallies[worker->order[k]]));
+    }
+    return cost;
+}
+
+// The cheapest children come first, the others costing at least as much
+// are pruned together once one reaches the best order. Running out of
+// budget stops the whole search
+static int explore_orders(IrvWorker *worker, int level, int64_t cost) {
+    IrvSearch *search = worker->search;
+    int n = search->profile->nb_candidates;
+    if (level == n) {
+        worker->best = min64(worker->best, cost);
+        return 0;
+    }
+    if (atomic_fetch_add(&search->expanded, 1) >= search->budget) {
+        search->exceeded = true;
+        return 0;
+    }
+    int children[MAX_TAB], nb_children = 0;
+    int64_t costs[MAX_TAB];
+    for (int c = 0; c < n; c++) {
+        if (worker->in_order[c])
+            continue;
+        int64_t added = max64(cost, add_to_order(worker, level, c, false));
+        int k = nb_children++;
+        for (; k > 0 && costs[k - 1] > added; k--) {
+            costs[k] = costs[k - 1];
+            children[k] = children[k - 1];
+        }
+        costs[k] = added;
+        children[k] = c;
+    }
+    for (int k = 0; k < nb_children && costs[k] < worker->best; k++) {
+        int c = children[k];
+        if (add_to_order(worker, level, c, true) < 0)
+            return -1;
+        worker->in_order[c] = true;
+        int status = explore_orders(worker, level + 1, costs[k]);
+        worker->in_order[c] = false;
+        if (status != 0 || search->exceeded)
+            return status;
+    }
+    return 0;
+}
+
+// Task t explores the orders won by t / n whose runner-up is t % n. Each
+// pair is pruned by its own orders only, so the nodes expanded below a bar,
+// and whether the budget covers them, do not depend on the threads
+static void *run_lower_worker(void *argument) {
+    IrvWorker *worker = argument;
+    IrvSearch *search = worker->search;
+    int n = search->profile->nb_candidates;
+    while (!search->failed && !search->exceeded) {
+        uint task = atomic_fetch_add(&search->next, 1);
+        if (task >= search->nb_tasks)
+            break;
+        int winner = task / n, runner_up = task % n;
+        if (winner == search->winner || runner_up == winner)
+            continue;
+        memset(worker->in_order, 0, sizeof(worker->in_order));
+        worker->in_order[winner] = worker->in_order[runner_up] = true;
+        worker->best = search->bar;
+        int64_t cost = 0;
+        if (add_to_order(worker, 0, winner, true) < 0 ||
+            (cost = add_to_order(worker, 1, runner_up, true)) < 0 ||
+            (cost < worker->best && explore_orders(worker, 2, cost) != 0))
+            search->failed = true;
+        lower_to(&search->lower, worker->best);
+    }
+    // The thread allocates them, and the next bar runs on other threads
+    for (int k = 0; k < n; k++) {
+        mem_free(worker->bests[k]);
+        mem_free(worker->tops[k]);
+        worker->bests[k] = NULL;
+        worker->tops[k] = NULL;
+    }
+    return NULL;
+}
+
+static int run_workers(void *(*work)(void *), void *arguments, size_t size,
+                       int nb_workers) {
+    pthread_t *threads = mem_alloc(sizeof(pthread_t) * nb_workers);
+    if (threads == NULL)
+        return -1;
+    int started = 0;
+    for (; started < nb_workers; started++) {
+        if (pthread_create(&threads[started], NULL, work,
+                           (char *)arguments + started * size) != 0)
+            break;
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    mem_free(threads);
+    return started > 0 ? 0 : -1;
+}
+
+static int bound_irv_margin(const BallotProfile *profile, int nb_workers,
+                            Margins *margins) {
+    int n = profile->nb_candidates;
+    short *tops = mem_alloc(sizeof(short) * profile->nb_distinct + 1);
+    uint *weights = mem_alloc(sizeof(uint) * profile->nb_distinct + 1);
+    uint *donors = mem_alloc(sizeof(uint) * profile->nb_distinct + 1);
+    IrvWorker *workers = mem_calloc(nb_workers, sizeof(IrvWorker));
+    int status = -1, eliminated[MAX_TAB];
+    if (tops == NULL || weights == NULL || donors == NULL || workers == NULL)
+        goto cleanup;
+    int winner =
+        count_irv(profile, profile->counts, -1, 0, false, tops, eliminated);
+    margins->irv_winner = winner;
+    margins->irv_lower = margins->irv_upper = -1;
+    if (n < 2 || profile->nb_ballots == 0) {
+        status = 0;
+        goto cleanup;
+    }
+
+    // The ballots of the winner's supporters are rewritten first
+    uint nb_donors = 0;
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        if (profile->first_choices[d] == winner)
+            donors[nb_donors++] = d;
+    }
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        if (profile->first_choices[d] != winner)
+            donors[nb_donors++] = d;
+    }
+    IrvSearch search = {.profile = profile,
+                        .winner = winner,
+                        .runner_up = eliminated[n - 2],
+                        .donors = donors,
+                        .nb_tasks = n,
+                        .next = 0,
+                        .lower = 0,
+                        .failed = false};
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        if (profile->first_choices[d] >= 0)
+            search.firsts[profile->first_choices[d]] += profile->counts[d];
+    }
+    // The runner-up usually needs the fewest, which spares bisecting the
+    // other challengers
+    search.ceiling = find_fewest_rewrites(
+        &search, search.runner_up, 0,
+        count_other_ballots(profile, search.runner_up), weights, tops);
+    search.upper = search.ceiling;
+    if (run_workers(run_upper_worker, &search, 0, nb_workers) != 0 ||
+        search.failed)
+        goto cleanup;
+
+    // Every order is searched below a bar, first the upper bound on a
+    // quarter of the budget. When that is not enough, the bars climb from 1,
+    // doubling until one is not settled, then bisect between the highest
+    // bar reached and the lowest one left unsettled. A search finishing
+    // below a bar proves that no order costs less than the cheapest one it
+    // found, and a bar may take half the nodes left
+    int64_t left = EXPLORED_BALLOTS / ((int64_t)n * (profile->nb_distinct + 1));
+    search.nb_tasks = n * n;
+    for (int i = 0; i < nb_workers; i++)
+        workers[i].search = &search;
+    int64_t reached = 0, unsettled = search.upper + 1;
+    bool climbing = false;
+    search.bar = search.upper;
+    while (reached + 1 < unsettled && left >= 2 * search.nb_tasks) {
+        search.next = 0;
+        search.lower = search.bar;
+        search.budget = unsettled > search.upper ? left / 4 : left / 2;
+        search.expanded = 0;
+        search.exceeded = false;
+        if (run_workers(run_lower_worker, workers, sizeof(IrvWorker),
+                        nb_workers) != 0 ||
+            search.failed)
+            goto cleanup;
+        left -= min64(search.expanded, search.budget);
+        if (search.exceeded) {
+            climbing = unsettled > search.upper;
+            unsettled = search.bar;
+        } else if (search.lower < search.bar) {
+            reached = search.lower;
+            break;
+        } else {
+            reached = search.bar;
+        }
+        search.bar = climbing ? min64(2 * reached + 1, unsettled - 1)
+                              : reached + (unsettled - reached) / 2;
+    }
+    margins->irv_lower = reached;
+    margins->irv_upper = search.upper;
+    status = 0;
+
+cleanup:
+    mem_free(workers);
+    mem_free(donors);
+    mem_free(weights);
+    mem_free(tops);
+    return status;
+}
+
+/*-----------------------------------------------------------------*/
+
+int find_margins(const Ballots *ballots, const FirstChoiceIndex *index,
+                 int nb_workers, Margins *margins) {
+    if (ballots == NULL || index == NULL || margins == NULL ||
+        index->rows != ballots->rows || index->columns != ballots->columns ||
+        ballots->columns == 0)
+        return -1;
+    if (nb_workers <= 0)
+        nb_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_workers <= 0)
+        nb_workers = 1;
+    int n = ballots->columns;
+    BallotProfile *profile = init_ballot_profile(ballots);
+    ptrMatrix runoff = first_past_the_post_runoff_results(ballots, index);
+    if (profile == NULL || runoff == NULL) {
+        delete_ballot_profile(profile);
+        delete_matrix(runoff);
+        return -1;
+    }
+    margins->two_round_winner =
+        find_argmax(runoff->data[runoff->rows - 1], n);
+    delete_matrix(runoff);
+
+    margins->plurality_winner = find_argmax(index->totals, n);
+    margins->plurality = find_plurality_margin(
+        index->totals, n, margins->plurality_winner, ballots->rows);
+    margins->two_round =
+        find_two_round_margin(profile, margins->two_round_winner);
+    int status = bound_irv_margin(profile, nb_workers, margins);
+    delete_ballot_profile(profile);
+    return status;
+}
@@ -0,0 +1,75 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Margins of Victory
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef MARGIN_H
+#define MARGIN_H
+
+#include "ballots.h"
+#include "first_past_the_post.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Margin Margins of Victory
+ * @{
+ *
+ * The margin of a count is the smallest number of ballots that must be
+ * rewritten, each into any other ballot, for another candidate to win. Ties
+ * are counted against the new winner, so a margin does not depend on how
+ * the count breaks them.
+ *
+ * The plurality and two-round margins are exact: rewritten ballots only
+ * matter through their first choice and, in the runoff, which finalist they
+ * prefer, so the cheapest changes follow from the first choice totals.
+ *
+ * The instant-runoff margin is bounded from both sides. The upper bound
+ * rewrites ballots of the winner's supporters until another candidate wins.
+ * The lower bound is a branch-and-bound over the elimination orders, built
+ * from the winner back to the first eliminated candidate: one rewritten
+ * ballot moves the gap between two candidates by at most 2, so every
+ * elimination of an order costs at least half the gap it has to close.
+ * The orders are searched below a bar, the cheapest partial orders first
+ * and those reaching the bar pruned, and the subtrees below their first two
+ * candidates are explored in parallel. The search expands a bounded number
+ * of nodes: the lower bound is the highest bar every order was proven to
+ * reach, which may be well below the margin when many orders cost little,
+ * as with impartial elections of many candidates.
+ */
+
+/**
+ * @brief The margins of the plurality, two-round and instant-runoff counts.
+ */
+typedef struct s_margins {
+    int plurality_winner; /**< Winner of the plurality count */
+    int two_round_winner; /**< Winner of the two-round count */
+    int irv_winner;       /**< Winner of the instant-runoff count */
+    int plurality;        /**< Margin of the plurality count */
+    int two_round;        /**< Margin of the two-round count */
+    int irv_lower;        /**< Lower bound of the instant-runoff margin */
+    int irv_upper;        /**< Upper bound of the instant-runoff margin */
+} Margins;
+
+/**
+ * @brief Computes the margins of an election.
+ *
+ * The winners are those of the counts, ties broken as they break them. A
+ * margin is -1 when nobody else can win, as with a single candidate or no
+ * ballot choosing anyone.
+ *
+ * @param[in] ballots The ballots of the election.
+ * @param[in] index The first choice index built from the same ballots.
+ * @param[in] nb_workers The number of threads, 0 for one per processor.
+ * @param[out] margins The winners and margins.
+ * @return 0 on success, -1 on failure.
+ */
+int find_margins(const Ballots *ballots, const FirstChoiceIndex *index,
+                 int nb_workers, Margins *margins);
+
+/** @} */ // End of Margin group
+
+#endif // MARGIN_H
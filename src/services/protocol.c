@@ -0,0 +1,211 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for the Wire Protocol of the Election Server
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "protocol.h"
+#include "allocator.h"
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+void init_message(Message *message) {
+    message->data = NULL;
+    message->size = message->capacity = message->offset = 0;
+    message->failed = false;
+}
+
+void clear_message(Message *message) {
+    message->size = message->offset = 0;
+    message->failed = false;
+}
+
+void release_message(Message *message) {
+    mem_free(message->data);
+    init_message(message);
+}
+
+static int reserve_message(Message *message, size_t size) {
+    if (size <= message->capacity)
+        return 0;
+    size_t capacity = message->capacity ? message->capacity : 256;
+    while (capacity < size)
+        capacity *= 2;
+    uint8_t *data = mem_realloc(message->data, capacity);
+    if (data == NULL)
+        return -1;
+    message->data = data;
+    message->capacity = capacity;
+    return 0;
+}
+
+void put_bytes(Message *message, const void *bytes, size_t size) {
+    if (message->failed)
+        return;
+    if (reserve_message(message, message->size + size) != 0) {
+        message->failed = true;
+        return;
+    }
+    memcpy(message->data + message->size, bytes, size);
+    message->size += size;
+}
+
+void put_u8(Message *message, uint8_t value) {
+    put_bytes(message, &value, 1);
+}
+
+void put_u32(Message *message, uint32_t value) {
+    uint8_t bytes[4] = {value >> 24, value >> 16, value >> 8, value};
+    put_bytes(message, bytes, 4);
+}
+
+void put_string(Message *message, const char *string) {
+    size_t length = strlen(string);
+    if (length > UINT16_MAX) {
+        message->failed = true;
+        return;
+    }
+    uint8_t bytes[2] = {length >> 8, length};
+    put_bytes(message, bytes, 2);
+    put_bytes(message, string, length);
+}
+
+static uint32_t decode_u32(const uint8_t *bytes) {
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 |
+           (uint32_t)bytes[2] << 8 | bytes[3];
+}
+
+static const uint8_t *get_bytes(Message *message, size_t size) {
+    if (message->failed || message->size - message->offset < size) {
+        message->failed = true;
+        return NULL;
+    }
+    const uint8_t *bytes = message->data + message->offset;
+    message->offset += size;
+    return bytes;
+}
+
+uint8_t get_u8(Message *message) {
+    const uint8_t *bytes = get_bytes(message, 1);
+    return bytes ? bytes[0] : 0;
+}
+
+uint32_t get_u32(Message *message) {
+    const uint8_t *bytes = get_bytes(message, 4);
+    if (bytes == NULL)
+        return 0;
+    return decode_u32(bytes);
+}
+
+bool get_string(Message *message, char *string, size_t size) {
+    const uint8_t *header = get_bytes(message, 2);
+    if (header == NULL)
+        return false;
+    size_t length = (size_t)header[0] << 8 | header[1];
+    const uint8_t *bytes = get_bytes(message, length);
+    if (bytes == NULL || length >= size) {
+        message->failed = true;
+        return false;
+    }
+    memcpy(string, bytes, length);
+    string[length] = '\0';
+    return true;
+}
+
+static int send_all(int fd, const uint8_t *bytes, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent <= 0)
+            return -1;
+        bytes += sent;
+        size -= sent;
+    }
+    return 0;
+}
+
+int send_message(int fd, const Message *message) {
+    if (message->failed || message->size > PROTOCOL_MAX_FRAME)
+        return -1;
+    uint32_t size = message->size;
+    uint8_t header[4] = {size >> 24, size >> 16, size >> 8, size};
+    if (send_all(fd, header, 4) != 0)
+        return -1;
+    return send_all(fd, message->data, message->size);
+}
+
+int put_frame(Message *output, const Message *message) {
+    if (message->failed || message->size > PROTOCOL_MAX_FRAME)
+        return -1;
+    put_u32(output, message->size);
+    put_bytes(output, message->data, message->size);
+    return output->failed ? -1 : 0;
+}
+
+int send_pending(int fd, Message *output) {
+    while (output->offset < output->size) {
+        ssize_t sent = send(fd, output->data + output->offset,
+                            output->size - output->offset,
+                            MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return 1;
+        if (sent <= 0)
+            return -1;
+        output->offset += sent;
+    }
+    clear_message(output);
+    return 0;
+}
+
+static int receive_all(int fd, uint8_t *bytes, size_t size) {
+    while (size > 0) {
+        ssize_t received = read(fd, bytes, size);
+        if (received < 0 && errno == EINTR)
+            continue;
+        if (received <= 0)
+            return -1;
+        bytes += received;
+        size -= received;
+    }
+    return 0;
+}
+
+int receive_message(int fd, Message *message) {
+    uint8_t header[4];
+    clear_message(message);
+    if (receive_all(fd, header, 4) != 0)
+        return -1;
+    uint32_t size = decode_u32(header);
+    if (size > PROTOCOL_MAX_FRAME || reserve_message(message, size) != 0 ||
+        receive_all(fd, message->data, size) != 0)
+        return -1;
+    message->size = size;
+    return 0;
+}
+
+int take_frame(Message *received, Message *message) {
+    if (received->size < 4)
+        return 0;
+    const uint8_t *header = received->data;
+    uint32_t size = decode_u32(header);
+    if (size > PROTOCOL_MAX_FRAME)
+        return -1;
+    if (received->size - 4 < size)
+        return 0;
+    clear_message(message);
+    put_bytes(message, received->data + 4, size);
+    if (message->failed)
+        return -1;
+    received->size -= 4 + size;
+    memmove(received->data, received->data + 4 + size, received->size);
+    return 1;
+}
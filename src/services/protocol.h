@@ -0,0 +1,177 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for the Wire Protocol of the Election Server
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Protocol Election Server Protocol
+ * @{
+ *
+ * Every frame is a 32-bit length followed by that many bytes. A request
+ * starts with its RequestType, a reply with a 32-bit status, 0 on success,
+ * followed by the fields of the request or by an error message. Integers
+ * are big-endian, strings a 16-bit length followed by their bytes.
+ *
+ * | Request | Fields                         | Reply                   |
+ * |---------|--------------------------------|-------------------------|
+ * | OPEN    | name, path, u32 candidates     | u32 candidates, u32     |
+ * |         | (0 infers them)                | ballots, u32 rejected   |
+ * | CREATE  | name, u32 n, n candidate names |                         |
+ * | APPEND  | name, u32 count, count * n u8  | u32 ballots             |
+ * |         | ranks (0 when unranked)        |                         |
+ * | WINNER  | name, method                   | i32 winner, name, u8    |
+ * |         |                                | whether it was cached   |
+ * | DUEL    | name                           | u32 n, n * n u32        |
+ * | RANKING | name                           | u32 n, n * (u32         |
+ * |         |                                | candidate, i32 majority |
+ * |         |                                | grade, name), best      |
+ * |         |                                | first                   |
+ * | DROP    | name                           |                         |
+ * | STOP    |                                |                         |
+ */
+
+/**
+ * @brief Largest frame a peer accepts.
+ */
+#define PROTOCOL_MAX_FRAME (16u << 20)
+
+/**
+ * @brief The requests of the protocol.
+ */
+enum RequestType {
+    REQUEST_OPEN = 1, /**< Load an election from a ballot file */
+    REQUEST_CREATE,   /**< Create an election without ballots */
+    REQUEST_APPEND,   /**< Add ballots to an election */
+    REQUEST_WINNER,   /**< Find the winner of a method */
+    REQUEST_DUEL,     /**< Read the duel matrix */
+    REQUEST_DROP,     /**< Forget an election */
+    REQUEST_STOP,     /**< Stop the server */
+    REQUEST_RANKING   /**< Rank the candidates by Majority Judgement */
+};
+
+/**
+ * @brief A frame being written or read.
+ */
+typedef struct s_message {
+    uint8_t *data;   /**< The bytes of the frame, without its length */
+    size_t size;     /**< The number of bytes */
+    size_t capacity; /**< The number of bytes allocated */
+    size_t offset;   /**< Next byte to read */
+    bool failed;     /**< A put ran out of memory or a get out of bytes */
+} Message;
+
+/**
+ * @brief Sets an empty message.
+ */
+void init_message(Message *message);
+
+/**
+ * @brief Empties a message, keeping its buffer.
+ */
+void clear_message(Message *message);
+
+/**
+ * @brief Frees the buffer of a message.
+ */
+void release_message(Message *message);
+
+/**
+ * @brief Appends bytes to a message.
+ */
+void put_bytes(Message *message, const void *bytes, size_t size);
+
+/**
+ * @brief Appends an unsigned byte to a message.
+ */
+void put_u8(Message *message, uint8_t value);
+
+/**
+ * @brief Appends a 32-bit integer to a message.
+ */
+void put_u32(Message *message, uint32_t value);
+
+/**
+ * @brief Appends a string to a message.
+ */
+void put_string(Message *message, const char *string);
+
+/**
+ * @brief Reads an unsigned byte, 0 if the message has no more bytes.
+ */
+uint8_t get_u8(Message *message);
+
+/**
+ * @brief Reads a 32-bit integer, 0 if the message has no more bytes.
+ */
+uint32_t get_u32(Message *message);
+
+/**
+ * @brief Reads a string.
+ *
+ * @param[in,out] message The message.
+ * @param[out] string The string, terminated.
+ * @param[in] size The size of string.
+ * @return false if the string is missing or does not fit.
+ */
+bool get_string(Message *message, char *string, size_t size);
+
+/**
+ * @brief Sends a message as a frame.
+ *
+ * @return 0 on success, -1 if the peer is gone.
+ */
+int send_message(int fd, const Message *message);
+
+/**
+ * @brief Appends a message as a frame to the bytes waiting to be sent.
+ *
+ * @param[in,out] output The bytes waiting, the next one to send at its
+ * offset.
+ * @param[in] message The message.
+ * @return 0 on success, -1 if the message failed, is too large or does not
+ * fit in memory.
+ */
+int put_frame(Message *output, const Message *message);
+
+/**
+ * @brief Sends as many of the bytes waiting as the socket takes without
+ * blocking, emptying the output once they are all sent.
+ *
+ * @param[in] fd The socket.
+ * @param[in,out] output The bytes waiting, from its offset.
+ * @return 0 if everything was sent, 1 if bytes are left, -1 if the peer is
+ * gone.
+ */
+int send_pending(int fd, Message *output);
+
+/**
+ * @brief Waits for a frame and reads it into a message.
+ *
+ * @return 0 on success, -1 if the peer is gone or the frame is too large.
+ */
+int receive_message(int fd, Message *message);
+
+/**
+ * @brief Moves the first complete frame of received bytes into a message.
+ *
+ * @param[in,out] received The bytes received, without the frame afterwards.
+ * @param[out] message The frame.
+ * @return 1 if a frame was moved, 0 if it is incomplete, -1 if too large.
+ */
+int take_frame(Message *received, Message *message);
+
+/** @} */ // End of Protocol group
+
+#endif // PROTOCOL_H
@@ -0,0 +1,435 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Serving Resident Elections over a Unix Socket
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "server.h"
+#include "allocator.h"
+#include "arena.h"
+#include "majority_judgement.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief The winner of a method was not counted since the last append.
+ */
+#define WINNER_STALE -2
+
+typedef struct s_resident {
+    char name[MAX_ELECTION_NAME]; /**< Chosen by the client */
+    ptrTallies tallies;           /**< Ballots and tallies */
+    int winners[UNKNOWN];         /**< Winner of each method, or stale */
+} Resident;
+
+typedef struct s_server {
+    Resident *residents;                /**< The elections in memory */
+    uint nb_residents;                  /**< The number of elections */
+    uint capacity;                      /**< The number allocated */
+    struct pollfd fds[MAX_CLIENTS + 1]; /**< The socket, then clients */
+    Message received[MAX_CLIENTS + 1];  /**< Bytes of each client */
+    Message pending[MAX_CLIENTS + 1];   /**< Replies not sent yet */
+    nfds_t nb_fds;                      /**< The socket and clients */
+    bool stopping;                      /**< A client asked to stop */
+    ptrArena scratch;                   /**< Scratch space of the counts */
+} Server;
+
+static void forget_winners(Resident *resident) {
+    for (int m = 0; m < UNKNOWN; m++)
+        resident->winners[m] = WINNER_STALE;
+}
+
+static Resident *find_resident(Server *server, const char *name) {
+    for (uint i = 0; i < server->nb_residents; i++) {
+        if (strcmp(server->residents[i].name, name) == 0)
+            return &server->residents[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Gives tallies to an election, replacing those it had.
+ */
+static int set_resident(Server *server, const char *name, ptrTallies tallies) {
+    Resident *resident = find_resident(server, name);
+    if (resident == NULL) {
+        if (server->nb_residents == server->capacity) {
+            uint capacity = server->capacity ? 2 * server->capacity : 8;
+            Resident *residents =
+                mem_realloc(server->residents, sizeof(Resident) * capacity);
+            if (residents == NULL)
+                return -1;
+            server->residents = residents;
+            server->capacity = capacity;
+        }
+        resident = &server->residents[server->nb_residents++];
+        strcpy(resident->name, name);
+    } else {
+        delete_tallies(resident->tallies);
+    }
+    resident->tallies = tallies;
+    forget_winners(resident);
+    return 0;
+}
+
+static const char *open_election(Server *server, Message *request,
+                                 Message *reply) {
+    char name[MAX_ELECTION_NAME], path[4096];
+    if (!get_string(request, name, sizeof(name)) ||
+        !get_string(request, path, sizeof(path)))
+        return "truncated request";
+    int nb_candidates = get_u32(request);
+    if (nb_candidates == 0)
+        nb_candidates = infer_candidate_count(path);
+    if (nb_candidates <= 0 || nb_candidates >= MAX_TAB)
+        return "cannot infer the number of candidates";
+
+    ptrTallies tallies = init_tallies();
+    if (tallies == NULL ||
+        set_tallies_from_file(tallies, path, nb_candidates) != 0) {
+        delete_tallies(tallies);
+        return "cannot read the ballots";
+    }
+    if (set_resident(server, name, tallies) != 0) {
+        delete_tallies(tallies);
+        return "out of memory";
+    }
+    put_u32(reply, tallies->ballots->columns);
+    put_u32(reply, tallies->ballots->rows);
+    put_u32(reply, tallies->ballots->rejected);
+    return NULL;
+}
+
+static const char *create_election(Server *server, Message *request,
+                                   Message *reply) {
+    char name[MAX_ELECTION_NAME], candidate[MAX_ELECTION_NAME];
+    if (!get_string(request, name, sizeof(name)))
+        return "truncated request";
+    uint nb_candidates = get_u32(request);
+    if (nb_candidates == 0 || nb_candidates >= MAX_TAB)
+        return "invalid number of candidates";
+
+    ptrTallies tallies = init_tallies();
+    if (tallies == NULL)
+        return "out of memory";
+    ptrBallots ballots = tallies->ballots;
+    ballots->columns = nb_candidates;
+    for (uint c = 0; c < nb_candidates; c++) {
+        if (!get_string(request, candidate, sizeof(candidate)))
+            candidate[0] = '\0';
+        ballots->tags[c] = init_stringbuffer(candidate, strlen(candidate));
+    }
+    if (request->failed || update_tallies(tallies) != 0 ||
+        set_resident(server, name, tallies) != 0) {
+        delete_tallies(tallies);
+        return request->failed ? "truncated request" : "out of memory";
+    }
+    return NULL;
+}
+
+static const char *append_ballots(Server *server, Message *request,
+                                  Message *reply) {
+    char name[MAX_ELECTION_NAME];
+    if (!get_string(request, name, sizeof(name)))
+        return "truncated request";
+    Resident *resident = find_resident(server, name);
+    if (resident == NULL)
+        return "unknown election";
+    uint count = get_u32(request);
+    uint nb_candidates = resident->tallies->ballots->columns;
+    // A truncated request must not leave part of its ballots in the tallies
+    if (request->failed ||
+        request->size - request->offset < (size_t)count * nb_candidates)
+        return "truncated request";
+
+    int row[MAX_TAB];
+    for (uint i = 0; i < count; i++) {
+        for (uint c = 0; c < nb_candidates; c++)
+            row[c] = get_u8(request);
+        if (append_ballot_to_tallies(resident->tallies, row) != 0)
+            return "out of memory";
+        forget_winners(resident);
+    }
+    put_u32(reply, resident->tallies->ballots->rows);
+    return NULL;
+}
+
+static const char *find_winner(Server *server, Message *request,
+                               Message *reply) {
+    char name[MAX_ELECTION_NAME], method[32];
+    if (!get_string(request, name, sizeof(name)) ||
+        !get_string(request, method, sizeof(method)))
+        return "truncated request";
+    Resident *resident = find_resident(server, name);
+    if (resident == NULL)
+        return "unknown election";
+    enum Method method_enum = str_to_enum(method);
+    if (method_enum == UNKNOWN || method_enum == ALL)
+        return "unknown method";
+
+    bool cached = resident->winners[method_enum] != WINNER_STALE;
+    if (!cached) {
+        ElectionOptions options;
+        init_election_options(&options, method_enum);
+        const Allocator *previous =
+            set_thread_allocator(get_arena_allocator(server->scratch));
+        resident->winners[method_enum] =
+            find_election_winner(resident->tallies, &options);
+        set_thread_allocator(previous);
+        reset_arena(server->scratch);
+    }
+    int winner = resident->winners[method_enum];
+    if (winner < 0)
+        return "the method has no single winner";
+    put_u32(reply, winner);
+    put_string(reply, resident->tallies->ballots->tags[winner]->string);
+    put_u8(reply, cached);
+    return NULL;
+}
+
+static const char *read_duel(Server *server, Message *request,
+                             Message *reply) {
+    char name[MAX_ELECTION_NAME];
+    if (!get_string(request, name, sizeof(name)))
+        return "truncated request";
+    Resident *resident = find_resident(server, name);
+    if (resident == NULL)
+        return "unknown election";
+    const Matrix *duel = resident->tallies->duel;
+    put_u32(reply, duel->columns);
+    for (uint i = 0; i < duel->columns; i++) {
+        for (uint j = 0; j < duel->columns; j++)
+            put_u32(reply, duel->data[i][j]);
+    }
+    return NULL;
+}
+
+static const char *rank_candidates(Server *server, Message *request,
+                                   Message *reply) {
+    char name[MAX_ELECTION_NAME];
+    if (!get_string(request, name, sizeof(name)))
+        return "truncated request";
+    Resident *resident = find_resident(server, name);
+    if (resident == NULL)
+        return "unknown election";
+    ptrBallots ballots = resident->tallies->ballots;
+    const Allocator *previous =
+        set_thread_allocator(get_arena_allocator(server->scratch));
+    CandidateScore *ranking =
+        majority_judgement_ranking(resident->tallies->histogram);
+    set_thread_allocator(previous);
+    if (ranking != NULL) {
+        put_u32(reply, ballots->columns);
+        for (uint c = 0; c < ballots->columns; c++) {
+            put_u32(reply, ranking[c].candidate);
+            put_u32(reply, ranking[c].score);
+            put_string(reply, ballots->tags[ranking[c].candidate]->string);
+        }
+    }
+    reset_arena(server->scratch);
+    return ranking != NULL ? NULL : "out of memory";
+}
+
+static const char *drop_election(Server *server, Message *request,
+                                 Message *reply) {
+    char name[MAX_ELECTION_NAME];
+    if (!get_string(request, name, sizeof(name)))
+        return "truncated request";
+    Resident *resident = find_resident(server, name);
+    if (resident == NULL)
+        return "unknown election";
+    delete_tallies(resident->tallies);
+    *resident = server->residents[--server->nb_residents];
+    return NULL;
+}
+
+static void handle_request(Server *server, Message *request,
+                           Message *reply) {
+    clear_message(reply);
+    put_u32(reply, 0);
+    const char *error = "unknown request";
+    switch (get_u8(request)) {
+    case REQUEST_OPEN:
+        error = open_election(server, request, reply);
+        break;
+    case REQUEST_CREATE:
+        error = create_election(server, request, reply);
+        break;
+    case REQUEST_APPEND:
+        error = append_ballots(server, request, reply);
+        break;
+    case REQUEST_WINNER:
+        error = find_winner(server, request, reply);
+        break;
+    case REQUEST_DUEL:
+        error = read_duel(server, request, reply);
+        break;
+    case REQUEST_DROP:
+        error = drop_election(server, request, reply);
+        break;
+    case REQUEST_RANKING:
+        error = rank_candidates(server, request, reply);
+        break;
+    case REQUEST_STOP:
+        server->stopping = true;
+        error = NULL;
+        break;
+    }
+    if (error != NULL || reply->failed) {
+        clear_message(reply);
+        put_u32(reply, (uint32_t)-1);
+        put_string(reply, error ? error : "out of memory");
+    }
+}
+
+static void close_client(Server *server, nfds_t i) {
+    close(server->fds[i].fd);
+    release_message(&server->received[i]);
+    release_message(&server->pending[i]);
+    server->nb_fds--;
+    server->fds[i] = server->fds[server->nb_fds];
+    server->received[i] = server->received[server->nb_fds];
+    server->pending[i] = server->pending[server->nb_fds];
+}
+
+/**
+ * @brief Reads what a client sent and queues the reply of every complete
+ * request.
+ * @return false if the client is gone or broke the protocol.
+ */
+static bool read_requests(Server *server, nfds_t i, Message *request,
+                          Message *reply) {
+    uint8_t chunk[1 << 16];
+    ssize_t size = read(server->fds[i].fd, chunk, sizeof(chunk));
+    if (size < 0 &&
+        (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+        return true;
+    if (size <= 0)
+        return false;
+    put_bytes(&server->received[i], chunk, size);
+    if (server->received[i].failed)
+        return false;
+
+    int status;
+    while ((status = take_frame(&server->received[i], request)) == 1) {
+        handle_request(server, request, reply);
+        if (put_frame(&server->pending[i], reply) != 0)
+            return false;
+    }
+    return status == 0;
+}
+
+/**
+ * @brief Reads the requests of a client and sends what its socket takes of
+ * the replies. A client is not read again until its replies are all sent.
+ * @return false if the client is gone or broke the protocol.
+ */
+static bool serve_client(Server *server, nfds_t i, Message *request,
+                         Message *reply) {
+    struct pollfd *client = &server->fds[i];
+    if ((client->revents & (POLLIN | POLLHUP | POLLERR)) &&
+        !read_requests(server, i, request, reply))
+        return false;
+    int status = send_pending(client->fd, &server->pending[i]);
+    client->events = status == 1 ? POLLOUT : POLLIN;
+    return status >= 0;
+}
+
+static int open_socket(const char *socket_path) {
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+        return -1;
+    strcpy(address.sun_path, socket_path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    unlink(socket_path);
+    if (bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(fd, MAX_CLIENTS) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int serve_elections(const char *socket_path) {
+    ptrArena scratch = init_arena(ARENA_BLOCK_SIZE);
+    int listener = scratch ? open_socket(socket_path) : -1;
+    if (listener < 0) {
+        delete_arena(scratch);
+        return -1;
+    }
+    Server server = {.residents = NULL, .nb_residents = 0, .capacity = 0,
+                     .nb_fds = 1, .stopping = false, .scratch = scratch};
+    server.fds[0].fd = listener;
+    server.fds[0].events = POLLIN;
+    Message request, reply;
+    init_message(&request);
+    init_message(&reply);
+
+    while (!server.stopping) {
+        if (poll(server.fds, server.nb_fds, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        // Backwards, since a closed client takes the place of the last one
+        for (nfds_t i = server.nb_fds - 1; i > 0 && !server.stopping; i--) {
+            if (server.fds[i].revents != 0 &&
+                !serve_client(&server, i, &request, &reply))
+                close_client(&server, i);
+        }
+        if ((server.fds[0].revents & POLLIN) &&
+            server.nb_fds < MAX_CLIENTS + 1) {
+            int client = accept(listener, NULL, NULL);
+            if (client >= 0 &&
+                fcntl(client, F_SETFL,
+                      fcntl(client, F_GETFL) | O_NONBLOCK) != 0) {
+                close(client);
+                client = -1;
+            }
+            if (client >= 0) {
+                server.fds[server.nb_fds].fd = client;
+                server.fds[server.nb_fds].events = POLLIN;
+                init_message(&server.received[server.nb_fds]);
+                init_message(&server.pending[server.nb_fds++]);
+            }
+        }
+    }
+
+    while (server.nb_fds > 1)
+        close_client(&server, server.nb_fds - 1);
+    close(listener);
+    unlink(socket_path);
+    for (uint i = 0; i < server.nb_residents; i++)
+        delete_tallies(server.residents[i].tallies);
+    mem_free(server.residents);
+    delete_arena(scratch);
+    release_message(&request);
+    release_message(&reply);
+    return 0;
+}
+
+int connect_to_server(const char *socket_path) {
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+        return -1;
+    strcpy(address.sun_path, socket_path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
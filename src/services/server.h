@@ -0,0 +1,58 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Serving Resident Elections over a Unix Socket
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "election.h"
+#include "protocol.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Server Election Server
+ * @{
+ */
+
+/**
+ * @brief Maximum size of an election name, terminator included.
+ */
+#define MAX_ELECTION_NAME 256
+
+/**
+ * @brief Maximum number of clients connected at the same time.
+ */
+#define MAX_CLIENTS 64
+
+/**
+ * @brief Serves elections on a Unix domain socket until a STOP request.
+ *
+ * Elections stay in memory between requests, so a query reads the tallies
+ * instead of the ballot file, and appended ballots update the tallies in
+ * place. The winner of each method is kept until the next append. Clients
+ * are served one request at a time, in the order they arrive. Their sockets
+ * do not block: the replies a client has not read yet wait in its queue,
+ * and its requests are not read until the queue is sent, so a client that
+ * stops reading holds up nobody else.
+ *
+ * @param[in] socket_path The path of the socket, replaced if it exists.
+ * @return 0 once stopped, -1 if the socket cannot be opened.
+ */
+int serve_elections(const char *socket_path);
+
+/**
+ * @brief Connects to a server.
+ *
+ * @param[in] socket_path The path of its socket.
+ * @return The connected socket, -1 on failure.
+ */
+int connect_to_server(const char *socket_path);
+
+/** @} */ // End of Server group
+
+#endif // SERVER_H
@@ -0,0 +1,179 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Candidate Withdrawals
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "withdrawal.h"
+#include "allocator.h"
+#include "condorcet.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief What the workers share, each block being a range of candidates.
+ */
+typedef struct s_withdrawal_search {
+    ptrMatrix duel;          /**< The duel matrix of the election */
+    const int *paths;        /**< The Schulze paths through nobody */
+    int nb_candidates;       /**< The number of candidates */
+    int nb_blocks;           /**< The ranges of candidates */
+    atomic_int next;         /**< First block not taken */
+    atomic_bool failed;      /**< A worker could not allocate */
+    Withdrawal *withdrawals; /**< The winners without each candidate */
+} WithdrawalSearch;
+
+/**
+ * @brief A worker, with a matrix for the duels left and the Schulze paths
+ * of each halving of its block.
+ */
+typedef struct s_withdrawal_worker {
+    WithdrawalSearch *search;
+    ptrMatrix remaining;
+    int *paths;
+} WithdrawalWorker;
+
+/*-----------------------------------------------------------------*/
+
+// The candidates after the withdrawn one move up a place
+static int restore_index(int candidate, int withdrawn) {
+    return candidate < 0 || candidate < withdrawn ? candidate : candidate + 1;
+}
+
+static int count_without(WithdrawalWorker *worker, int withdrawn) {
+    WithdrawalSearch *search = worker->search;
+    ptrMatrix duel = search->duel, remaining = worker->remaining;
+    int n = search->nb_candidates;
+    for (int i = 0, row = 0; i < n; i++) {
+        if (i == withdrawn)
+            continue;
+        for (int j = 0, column = 0; j < n; j++) {
+            if (j != withdrawn)
+                remaining->data[row][column++] = duel->data[i][j];
+        }
+        row++;
+    }
+    Withdrawal *withdrawal = &search->withdrawals[withdrawn];
+    int winner;
+    if (!find_condorcet_winner(remaining, n - 1, &winner))
+        winner = -1;
+    withdrawal->condorcet = restore_index(winner, withdrawn);
+    withdrawal->minimax = restore_index(
+        find_minimax_condorcet_winner(remaining, n - 1), withdrawn);
+    CandidateScore *ranking =
+        find_ranked_pairs_condorcet_winner(remaining, n - 1);
+    if (ranking == NULL)
+        return -1;
+    withdrawal->ranked_pairs = restore_index(ranking[0].candidate, withdrawn);
+    mem_free(ranking);
+    return 0;
+}
+
+// The paths of a level went through everybody outside [first, last), the
+// next level widens them through one half for the withdrawals of the other
+static void share_schulze_paths(WithdrawalWorker *worker, int *paths,
+                                int first, int last) {
+    WithdrawalSearch *search = worker->search;
+    int n = search->nb_candidates;
+    if (last - first == 1) {
+        search->withdrawals[first].schulze =
+            find_schulze_path_winner(paths, n, first);
+        return;
+    }
+    int middle = first + (last - first) / 2;
+    int *next = paths + n * n;
+    memcpy(next, paths, sizeof(int) * n * n);
+    widen_schulze_paths(next, n, middle, last);
+    share_schulze_paths(worker, next, first, middle);
+    memcpy(next, paths, sizeof(int) * n * n);
+    widen_schulze_paths(next, n, first, middle);
+    share_schulze_paths(worker, next, middle, last);
+}
+
+// Block b holds the candidates from b * n / nb_blocks on
+static void *run_withdrawal_worker(void *argument) {
+    WithdrawalWorker *worker = argument;
+    WithdrawalSearch *search = worker->search;
+    int n = search->nb_candidates;
+    // Halving the largest block takes one level per bit of its size
+    int levels = 1;
+    for (int size = (n + search->nb_blocks - 1) / search->nb_blocks; size > 1;
+         size = (size + 1) / 2)
+        levels++;
+    worker->remaining = init_matrix(true);
+    worker->paths = mem_alloc(sizeof(int) * levels * n * n);
+    if (worker->remaining == NULL || worker->paths == NULL)
+        search->failed = true;
+    while (!search->failed) {
+        int block = atomic_fetch_add(&search->next, 1);
+        if (block >= search->nb_blocks)
+            break;
+        int first = block * n / search->nb_blocks;
+        int last = (block + 1) * n / search->nb_blocks;
+        for (int c = first; c < last; c++) {
+            if (count_without(worker, c) != 0)
+                search->failed = true;
+        }
+        memcpy(worker->paths, search->paths, sizeof(int) * n * n);
+        widen_schulze_paths(worker->paths, n, 0, first);
+        widen_schulze_paths(worker->paths, n, last, n);
+        share_schulze_paths(worker, worker->paths, first, last);
+    }
+    delete_matrix(worker->remaining);
+    mem_free(worker->paths);
+    return NULL;
+}
+
+/*-----------------------------------------------------------------*/
+
+int find_withdrawal_winners(ptrMatrix duel, int nb_candidates, int nb_workers,
+                            Withdrawal *withdrawals) {
+    if (duel == NULL || withdrawals == NULL || nb_candidates < 2 ||
+        nb_candidates > MAX_TAB)
+        return -1;
+    if (nb_workers <= 0)
+        nb_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_workers <= 0)
+        nb_workers = 1;
+    if (nb_workers > nb_candidates)
+        nb_workers = nb_candidates;
+
+    int *paths = mem_alloc(sizeof(int) * nb_candidates * nb_candidates);
+    WithdrawalWorker *workers =
+        mem_calloc(nb_workers, sizeof(WithdrawalWorker));
+    pthread_t *threads = mem_alloc(sizeof(pthread_t) * nb_workers);
+    if (paths == NULL || workers == NULL || threads == NULL) {
+        mem_free(paths);
+        mem_free(workers);
+        mem_free(threads);
+        return -1;
+    }
+    init_schulze_paths(duel, nb_candidates, paths);
+    WithdrawalSearch search = {.duel = duel,
+                               .paths = paths,
+                               .nb_candidates = nb_candidates,
+                               .nb_blocks = nb_workers,
+                               .next = 0,
+                               .failed = false,
+                               .withdrawals = withdrawals};
+    int started = 0;
+    for (; started < nb_workers; started++) {
+        workers[started].search = &search;
+        if (pthread_create(&threads[started], NULL, run_withdrawal_worker,
+                           &workers[started]) != 0)
+            break;
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    mem_free(paths);
+    mem_free(workers);
+    mem_free(threads);
+    return started > 0 && !search.failed ? 0 : -1;
+}
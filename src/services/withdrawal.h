@@ -0,0 +1,57 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Candidate Withdrawals
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef WITHDRAWAL_H
+#define WITHDRAWAL_H
+
+#include "matrix.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Withdrawal Candidate Withdrawals
+ * @{
+ *
+ * Who would win if a candidate withdrew is counted on the duel matrix
+ * without that candidate's row and column, the ballots are not read again.
+ * A loser whose withdrawal changes the winner of a method is a spoiler for
+ * it, as a clone of the winner should never be.
+ *
+ * The Schulze paths of every withdrawal are shared: paths widened through
+ * the candidates outside a range serve every withdrawal in it, the range
+ * is halved and each half widened through the other one, down to a single
+ * candidate, in O(C^3 log C) instead of O(C^4). Each worker does so for its
+ * own range of candidates.
+ */
+
+/**
+ * @brief The winners left when a candidate withdraws, numbered as in the
+ * whole election.
+ */
+typedef struct s_withdrawal {
+    int condorcet;    /**< The Condorcet winner, -1 for none */
+    int minimax;      /**< The minimax winner */
+    int ranked_pairs; /**< The first of the ranked pairs ranking */
+    int schulze;      /**< The Schulze winner */
+} Withdrawal;
+
+/**
+ * @brief Counts the Condorcet methods once without each candidate.
+ *
+ * @param[in] duel The duel matrix of the election.
+ * @param[in] nb_candidates The number of candidates, at least 2.
+ * @param[in] nb_workers The number of threads, 0 for one per processor.
+ * @param[out] withdrawals The winners without each candidate.
+ * @return 0 on success, -1 on failure.
+ */
+int find_withdrawal_winners(ptrMatrix duel, int nb_candidates, int nb_workers,
+                            Withdrawal *withdrawals);
+
+/** @} */ // End of Withdrawal group
+
+#endif // WITHDRAWAL_H
@@ -0,0 +1,238 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation of the Tally Cache
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "cache.h"
+#include "allocator.h"
+#include "first_past_the_post.h"
+#include "stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief First bytes of every entry, to be changed with the layout.
+ */
+static const char CACHE_MAGIC[8] = {'V', 'M', 'T', 'A', 'L', 'L', 'Y', '2'};
+
+ptrTallies init_tallies(void) {
+    ptrTallies tallies = mem_alloc(sizeof(Tallies));
+    if (tallies == NULL)
+        return NULL;
+    tallies->ballots = init_ballots();
+    tallies->duel = init_matrix(true);
+    tallies->histogram = init_histogram();
+    tallies->has_ballots = false;
+    tallies->from_cache = false;
+    memset(tallies->first_choices, 0, sizeof(tallies->first_choices));
+    if (tallies->ballots == NULL || tallies->duel == NULL ||
+        tallies->histogram == NULL) {
+        delete_tallies(tallies);
+        return NULL;
+    }
+    return tallies;
+}
+
+int update_tallies(ptrTallies tallies) {
+    if (tallies == NULL)
+        return -1;
+    STATS_BEGIN(PHASE_TALLIES);
+    FirstChoiceIndex *index = build_first_choice_index(tallies->ballots);
+    if (index == NULL) {
+        STATS_END(PHASE_TALLIES);
+        return -1;
+    }
+    memset(tallies->first_choices, 0, sizeof(tallies->first_choices));
+    memcpy(tallies->first_choices, index->totals,
+           sizeof(int) * tallies->ballots->columns);
+    delete_first_choice_index(index);
+    set_histogram_from_ballots(tallies->histogram, tallies->ballots);
+    STATS_END(PHASE_TALLIES);
+    set_duel_from_ballots(tallies->duel, tallies->ballots);
+    tallies->has_ballots = true;
+    tallies->from_cache = false;
+    return 0;
+}
+
+int append_ballot_to_tallies(ptrTallies tallies, const int *row) {
+    if (tallies == NULL)
+        return -1;
+    ptrBallots ballots = tallies->ballots;
+    uint nb_candidates = ballots->columns;
+    if (add_ballot(ballots, row, nb_candidates) != 0)
+        return -1;
+    // Tallies never counted, or set from a summary of other candidates
+    if (tallies->duel->columns != nb_candidates)
+        return update_tallies(tallies);
+
+    uint ballot = ballots->rows - 1;
+    rank_t best = RANK_NONE;
+    int first = -1;
+    for (uint i = 0; i < nb_candidates; i++) {
+        rank_t rank = get_ballot_rank(ballots, ballot, i);
+        tallies->histogram->counts[i][rank]++;
+        if (rank >= tallies->histogram->columns)
+            tallies->histogram->columns = rank + 1;
+        if (rank == RANK_NONE)
+            continue;
+        if (best == RANK_NONE || rank < best) {
+            best = rank;
+            first = i;
+        } else if (rank == best) {
+            first = -1; // A shared first choice counts for no one
+        }
+        for (uint j = 0; j < nb_candidates; j++) {
+            rank_t other = get_ballot_rank(ballots, ballot, j);
+            if (other != RANK_NONE && rank < other)
+                tallies->duel->data[i][j]++;
+        }
+    }
+    tallies->histogram->ballots++;
+    if (first != -1)
+        tallies->first_choices[first]++;
+    tallies->from_cache = false;
+    return 0;
+}
+
+int set_tallies_from_file(ptrTallies tallies, const char *filename,
+                          int nb_candidates) {
+    if (tallies == NULL ||
+        set_ballots_from_file(tallies->ballots, filename, nb_candidates) != 0)
+        return -1;
+    return update_tallies(tallies);
+}
+
+int get_cache_key(const char *filename, int nb_candidates,
+                  char key[CACHE_KEY_SIZE]) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+        return -1;
+    SHA256_CTX ctx;
+    sha256_init(&ctx);
+    char options[64];
+    int length = snprintf(options, sizeof(options), "%.8s candidates=%d\n",
+                          CACHE_MAGIC, nb_candidates);
+    sha256_update(&ctx, (const BYTE *)options, length);
+    BYTE buffer[1 << 16];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        sha256_update(&ctx, buffer, read);
+    bool failed = ferror(file);
+    fclose(file);
+    if (failed)
+        return -1;
+
+    BYTE hash[SHA256_BLOCK_SIZE];
+    sha256_final(&ctx, hash);
+    for (int i = 0; i < SHA256_BLOCK_SIZE; i++)
+        sprintf(&key[i * 2], "%02x", hash[i]);
+    return 0;
+}
+
+static int write_tallies_to(const Tallies *tallies, FILE *file) {
+    uint columns = tallies->ballots->columns;
+    if (fwrite(CACHE_MAGIC, 1, sizeof(CACHE_MAGIC), file) !=
+            sizeof(CACHE_MAGIC) ||
+        write_ballots(tallies->ballots, file) != 0 ||
+        write_matrix(tallies->duel, file) != 0 ||
+        fwrite(tallies->first_choices, sizeof(int), columns, file) !=
+            columns ||
+        write_histogram(tallies->histogram, file) != 0)
+        return -1;
+    return 0;
+}
+
+int write_tallies(const Tallies *tallies, const char *path) {
+    if (tallies == NULL || path == NULL)
+        return -1;
+    size_t size = strlen(path) + 32;
+    char *temporary = mem_alloc(size);
+    if (temporary == NULL)
+        return -1;
+    snprintf(temporary, size, "%s.%ld.tmp", path, (long)getpid());
+    FILE *file = fopen(temporary, "wb");
+    int status = -1;
+    if (file != NULL) {
+        status = write_tallies_to(tallies, file);
+        if (fclose(file) != 0)
+            status = -1;
+        if (status == 0 && rename(temporary, path) != 0)
+            status = -1;
+        if (status != 0)
+            remove(temporary);
+    }
+    mem_free(temporary);
+    return status;
+}
+
+static int read_tallies_from(ptrTallies tallies, FILE *file) {
+    char magic[sizeof(CACHE_MAGIC)];
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        read_ballots(tallies->ballots, file) != 0)
+        return -1;
+    uint columns = tallies->ballots->columns;
+    if (read_matrix(tallies->duel, file) != 0 ||
+        tallies->duel->columns != columns ||
+        fread(tallies->first_choices, sizeof(int), columns, file) !=
+            columns ||
+        read_histogram(tallies->histogram, file) != 0)
+        return -1;
+    tallies->has_ballots = true;
+    // Anything left means the entry does not have this layout
+    return fgetc(file) == EOF ? 0 : -1;
+}
+
+int read_tallies(ptrTallies tallies, const char *path) {
+    if (tallies == NULL || path == NULL)
+        return -1;
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return -1;
+    int status = read_tallies_from(tallies, file);
+    fclose(file);
+    tallies->from_cache = status == 0;
+    return status;
+}
+
+int load_tallies(ptrTallies tallies, const char *cache_dir,
+                 const char *filename, int nb_candidates) {
+    if (cache_dir == NULL)
+        return set_tallies_from_file(tallies, filename, nb_candidates);
+    char key[CACHE_KEY_SIZE];
+    if (tallies == NULL || get_cache_key(filename, nb_candidates, key) != 0)
+        return -1;
+    size_t size = strlen(cache_dir) + CACHE_KEY_SIZE + 16;
+    char *path = mem_alloc(size);
+    if (path == NULL)
+        return -1;
+    snprintf(path, size, "%s/%s.tallies", cache_dir, key);
+
+    int status = 0;
+    if (read_tallies(tallies, path) != 0) {
+        status = set_tallies_from_file(tallies, filename, nb_candidates);
+        if (status == 0) {
+            mkdir(cache_dir, 0755);
+            write_tallies(tallies, path);
+        }
+    }
+    mem_free(path);
+    return status;
+}
+
+void delete_tallies(ptrTallies tallies) {
+    if (tallies == NULL)
+        return;
+    delete_ballots(tallies->ballots);
+    delete_matrix(tallies->duel);
+    delete_histogram(tallies->histogram);
+    mem_free(tallies);
+}
@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for the Tally Cache
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "ballots.h"
+#include "histogram.h"
+#include "matrix.h"
+#include "sha256.h"
+#include <stdbool.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Cache Tally Cache
+ * @{
+ */
+
+/**
+ * @brief Size of a cache key: the hexadecimal SHA-256 and its terminator.
+ */
+#define CACHE_KEY_SIZE (SHA256_BLOCK_SIZE * 2 + 1)
+
+/**
+ * @brief Everything the methods derive from a ballot file.
+ *
+ * The histogram counts the values of every candidate, read as ranks by
+ * Bucklin and the scoring rules and as grades by Majority Judgement.
+ */
+typedef struct s_tallies {
+    ptrBallots ballots;         /**< The binary ballot store */
+    ptrMatrix duel;             /**< The pairwise matrix */
+    int first_choices[MAX_TAB]; /**< Plurality totals of each candidate */
+    ptrHistogram histogram;     /**< Rank or grade histogram */
+    bool has_ballots;           /**< False when set from a tally summary */
+    bool from_cache;            /**< Whether they were read from the cache */
+} Tallies;
+
+/**
+ * @brief Typedef for a pointer to a Tallies structure.
+ */
+typedef Tallies *ptrTallies;
+
+/**
+ * @brief Allocates empty tallies.
+ *
+ * @return The tallies, or NULL if memory allocation fails.
+ *
+ * @post The returned Tallies must be freed with delete_tallies.
+ */
+ptrTallies init_tallies(void);
+
+/**
+ * @brief Parses a ballot file and derives every tally from it.
+ *
+ * @param[in,out] tallies The tallies to set.
+ * @param[in] filename Path to the CSV file containing voting data.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @return 0 on success, -1 on failure.
+ */
+int set_tallies_from_file(ptrTallies tallies, const char *filename,
+                          int nb_candidates);
+
+/**
+ * @brief Recomputes every tally from the ballot store of the tallies.
+ *
+ * @param[in,out] tallies The tallies, whose ballots are already set.
+ * @return 0 on success, -1 on failure.
+ */
+int update_tallies(ptrTallies tallies);
+
+/**
+ * @brief Adds a ballot to tallies and updates every tally in place.
+ * The duel matrix costs O(n^2) and the other tallies O(n) per ballot,
+ * instead of a recount of every ballot. Tallies set from a summary stay
+ * without ballots.
+ * @param[in,out] tallies The tallies, whose ballots have their candidates.
+ * @param[in] row The rank of each candidate, 0 or less when unranked.
+ * @return 0 on success, -1 on failure.
+ */
+int append_ballot_to_tallies(ptrTallies tallies, const int *row);
+
+/**
+ * @brief Computes the cache key of a ballot file.
+ *
+ * The key is the SHA-256 of the parse options followed by the content of the
+ * file, so the same export read with other options gets another entry.
+ *
+ * @param[in] filename Path to the CSV file containing voting data.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @param[out] key The key, in hexadecimal.
+ * @return 0 on success, -1 if the file cannot be read.
+ */
+int get_cache_key(const char *filename, int nb_candidates,
+                  char key[CACHE_KEY_SIZE]);
+
+/**
+ * @brief Writes tallies to a cache entry.
+ *
+ * The entry is written to a temporary file first and renamed, so a reader
+ * never sees half of it.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int write_tallies(const Tallies *tallies, const char *path);
+
+/**
+ * @brief Reads tallies from a cache entry.
+ *
+ * @return 0 on success, -1 if the entry is missing, truncated or from
+ * another version.
+ */
+int read_tallies(ptrTallies tallies, const char *path);
+
+/**
+ * @brief Sets tallies from the cache, or from the file on a miss.
+ *
+ * On a miss, the file is parsed and the entry is stored for the next run. A
+ * cache that cannot be written only costs the next run a parse.
+ *
+ * @param[in,out] tallies The tallies to set.
+ * @param[in] cache_dir The cache directory, created if missing. NULL
+ *                      disables the cache.
+ * @param[in] filename Path to the CSV file containing voting data.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @return 0 on success, -1 on failure.
+ */
+int load_tallies(ptrTallies tallies, const char *cache_dir,
+                 const char *filename, int nb_candidates);
+
+/**
+ * @brief Frees tallies.
+ *
+ * @param[in] tallies The tallies to free, may be NULL.
+ */
+void delete_tallies(ptrTallies tallies);
+
+/** @} */ // End of Cache group
+
+#endif // CACHE_H
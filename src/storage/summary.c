@@ -0,0 +1,170 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation of Mergeable Tally Summaries
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "summary.h"
+#include "allocator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief First bytes of every summary, to be changed with the layout.
+ */
+static const char SUMMARY_MAGIC[8] = {'V', 'M', 'S', 'U', 'M', 'R', 'Y', '1'};
+
+ptrTallySummary init_tally_summary(void) {
+    ptrTallySummary summary = mem_alloc(sizeof(TallySummary));
+    if (summary == NULL)
+        return NULL;
+    summary->duel = init_matrix(true);
+    summary->histogram = init_histogram();
+    memset(summary->first_choices, 0, sizeof(summary->first_choices));
+    if (summary->duel == NULL || summary->histogram == NULL) {
+        delete_tally_summary(summary);
+        return NULL;
+    }
+    return summary;
+}
+
+/**
+ * @brief Copies a duel matrix with its own tags.
+ */
+static void copy_duel(ptrMatrix duel, const Matrix *other) {
+    clear_matrix(duel);
+    for (uint i = 0; i < other->columns; i++) {
+        const StringBuffer *tag = other->tags[i];
+        duel->tags[i] = tag != NULL ? init_stringbuffer(tag->string, tag->size)
+                                    : init_stringbuffer(NULL, 0);
+        memcpy(duel->data[i], other->data[i], sizeof(int) * other->columns);
+    }
+    duel->rows = other->rows;
+    duel->columns = other->columns;
+}
+
+int set_summary_from_tallies(ptrTallySummary summary, const Tallies *tallies) {
+    if (summary == NULL || tallies == NULL)
+        return -1;
+    copy_duel(summary->duel, tallies->duel);
+    memcpy(summary->first_choices, tallies->first_choices,
+           sizeof(summary->first_choices));
+    *summary->histogram = *tallies->histogram;
+    return 0;
+}
+
+int set_tallies_from_summary(ptrTallies tallies, const TallySummary *summary) {
+    if (tallies == NULL || summary == NULL)
+        return -1;
+    ptrBallots ballots = tallies->ballots;
+    clear_ballots(ballots);
+    ballots->columns = summary->duel->columns;
+    for (uint i = 0; i < ballots->columns; i++) {
+        const StringBuffer *tag = summary->duel->tags[i];
+        ballots->tags[i] = init_stringbuffer(tag->string, tag->size);
+    }
+    copy_duel(tallies->duel, summary->duel);
+    memcpy(tallies->first_choices, summary->first_choices,
+           sizeof(tallies->first_choices));
+    *tallies->histogram = *summary->histogram;
+    tallies->has_ballots = false;
+    tallies->from_cache = false;
+    return 0;
+}
+
+int merge_tally_summaries(ptrTallySummary summary, const TallySummary *other) {
+    if (summary == NULL || other == NULL)
+        return -1;
+    if (other->duel->columns == 0)
+        return 0;
+    if (summary->duel->columns == 0) {
+        copy_duel(summary->duel, other->duel);
+        memcpy(summary->first_choices, other->first_choices,
+               sizeof(summary->first_choices));
+        *summary->histogram = *other->histogram;
+        return 0;
+    }
+
+    // Shards must come from exports with the same header
+    uint columns = summary->duel->columns;
+    if (other->duel->columns != columns ||
+        other->histogram->rows != summary->histogram->rows)
+        return -1;
+    for (uint i = 0; i < columns; i++) {
+        if (strcmp(summary->duel->tags[i]->string,
+                   other->duel->tags[i]->string) != 0)
+            return -1;
+    }
+
+    for (uint i = 0; i < columns; i++) {
+        for (uint j = 0; j < columns; j++)
+            summary->duel->data[i][j] += other->duel->data[i][j];
+        summary->first_choices[i] += other->first_choices[i];
+    }
+    ptrHistogram histogram = summary->histogram;
+    for (uint c = 0; c < histogram->rows; c++) {
+        for (uint v = 0; v < other->histogram->columns; v++)
+            histogram->counts[c][v] += other->histogram->counts[c][v];
+    }
+    if (other->histogram->columns > histogram->columns)
+        histogram->columns = other->histogram->columns;
+    histogram->ballots += other->histogram->ballots;
+    return 0;
+}
+
+int write_tally_summary(const TallySummary *summary, const char *path) {
+    if (summary == NULL || path == NULL)
+        return -1;
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+        return -1;
+    uint columns = summary->duel->columns;
+    int status = 0;
+    if (fwrite(SUMMARY_MAGIC, 1, sizeof(SUMMARY_MAGIC), file) !=
+            sizeof(SUMMARY_MAGIC) ||
+        write_matrix(summary->duel, file) != 0 ||
+        fwrite(summary->first_choices, sizeof(int), columns, file) !=
+            columns ||
+        write_histogram(summary->histogram, file) != 0)
+        status = -1;
+    if (fclose(file) != 0)
+        status = -1;
+    return status;
+}
+
+int read_tally_summary(ptrTallySummary summary, const char *path) {
+    if (summary == NULL || path == NULL)
+        return -1;
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return -1;
+    char magic[sizeof(SUMMARY_MAGIC)];
+    int status = -1;
+    if (fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+        memcmp(magic, SUMMARY_MAGIC, sizeof(magic)) == 0 &&
+        read_matrix(summary->duel, file) == 0 &&
+        summary->duel->rows == summary->duel->columns) {
+        uint columns = summary->duel->columns;
+        memset(summary->first_choices, 0, sizeof(summary->first_choices));
+        if (fread(summary->first_choices, sizeof(int), columns, file) ==
+                columns &&
+            read_histogram(summary->histogram, file) == 0 &&
+            fgetc(file) == EOF)
+            status = 0;
+    }
+    fclose(file);
+    return status;
+}
+
+void delete_tally_summary(ptrTallySummary summary) {
+    if (summary == NULL)
+        return;
+    delete_matrix(summary->duel);
+    delete_histogram(summary->histogram);
+    mem_free(summary);
+}
@@ -0,0 +1,102 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Mergeable Tally Summaries
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef SUMMARY_H
+#define SUMMARY_H
+
+#include "cache.h"
+#include "histogram.h"
+#include "matrix.h"
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Summary Tally Summaries
+ * @{
+ */
+
+/**
+ * @brief The tallies of a set of ballots, without the ballots.
+ *
+ * Every field is a sum over the ballots, so summaries of separate shards
+ * merge into the summary of their union, in any order and grouping. The
+ * histogram serves both as the rank-position histogram and as the grade
+ * histogram of Majority Judgement, and holds the number of ballots. An
+ * empty summary (no candidates) is the identity of the merge.
+ */
+typedef struct s_tally_summary {
+    ptrMatrix duel;             /**< Pairwise matrix, tagged by candidate */
+    int first_choices[MAX_TAB]; /**< Plurality totals of each candidate */
+    ptrHistogram histogram;     /**< Rank or grade histogram */
+} TallySummary;
+
+/**
+ * @brief Typedef for a pointer to a TallySummary structure.
+ */
+typedef TallySummary *ptrTallySummary;
+
+/**
+ * @brief Allocates an empty summary.
+ *
+ * @return The summary, or NULL if memory allocation fails.
+ *
+ * @post The returned TallySummary must be freed with delete_tally_summary.
+ */
+ptrTallySummary init_tally_summary(void);
+
+/**
+ * @brief Sets a summary from the tallies of a ballot file.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int set_summary_from_tallies(ptrTallySummary summary, const Tallies *tallies);
+
+/**
+ * @brief Sets tallies from a summary.
+ *
+ * The ballot store of the tallies only gets the candidates, so the methods
+ * needing every ballot cannot run on them (has_ballots is false).
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int set_tallies_from_summary(ptrTallies tallies, const TallySummary *summary);
+
+/**
+ * @brief Adds a summary to another one.
+ *
+ * @param[in,out] summary The summary receiving the sum.
+ * @param[in] other The summary to add.
+ * @return 0 on success, -1 if both have candidates and they differ.
+ */
+int merge_tally_summaries(ptrTallySummary summary, const TallySummary *other);
+
+/**
+ * @brief Writes a summary to a file.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int write_tally_summary(const TallySummary *summary, const char *path);
+
+/**
+ * @brief Reads a summary written by write_tally_summary.
+ *
+ * @return 0 on success, -1 if the file is missing, truncated or from another
+ * version.
+ */
+int read_tally_summary(ptrTallySummary summary, const char *path);
+
+/**
+ * @brief Frees a summary.
+ *
+ * @param[in] summary The summary to free, may be NULL.
+ */
+void delete_tally_summary(ptrTallySummary summary);
+
+/** @} */ // End of Summary group
+
+#endif // SUMMARY_H
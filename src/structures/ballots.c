@@ -0,0 +1,261 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation of Ballots
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "ballots.h"
+#include "allocator.h"
+#include "miscellaneous.h"
+#include "stats.h"
+#include "stringbuffer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+#define INITIAL_CAPACITY 64
+
+ptrBallots init_ballots(void) {
+    ptrBallots ballots = mem_alloc(sizeof(Ballots));
+    if (ballots == NULL)
+        return NULL;
+    ballots->ranks = NULL;
+    ballots->capacity = 0;
+    ballots->allocated = 0;
+    ballots->rows = 0;
+    ballots->columns = 0;
+    ballots->rejected = 0;
+    memset(ballots->tags, 0, sizeof(ballots->tags));
+    return ballots;
+}
+
+static int reserve_ballots(ptrBallots ballots, uint capacity) {
+    if (capacity <= ballots->capacity)
+        return 0;
+    // An empty store keeps the buffer of its previous file when it fits
+    if (ballots->rows == 0 && ballots->columns > 0 &&
+        (size_t)capacity * ballots->columns <= ballots->allocated) {
+        ballots->capacity = ballots->allocated / ballots->columns;
+        return 0;
+    }
+    uint new_capacity = ballots->capacity ? ballots->capacity : 1;
+    while (new_capacity < capacity)
+        new_capacity *= 2;
+    rank_t *ranks = mem_alloc((size_t)new_capacity * ballots->columns);
+    if (ranks == NULL)
+        return -1;
+    // Columns move to their new stride, the tail of each one stays unused
+    for (uint c = 0; c < ballots->columns && ballots->rows > 0; c++) {
+        memcpy(ranks + (size_t)c * new_capacity,
+               ballots->ranks + (size_t)c * ballots->capacity, ballots->rows);
+    }
+    mem_free(ballots->ranks);
+    ballots->ranks = ranks;
+    ballots->capacity = new_capacity;
+    ballots->allocated = (size_t)new_capacity * ballots->columns;
+    return 0;
+}
+
+/**
+ * @brief Empties a ballot store but keeps its ranks buffer for the next file.
+ */
+static void reset_ballots(ptrBallots ballots) {
+    for (uint i = 0; i < ballots->columns; ++i) {
+        if (ballots->tags[i] != NULL)
+            delete_stringbuffer(ballots->tags[i]);
+        ballots->tags[i] = NULL;
+    }
+    ballots->capacity = 0;
+    ballots->rows = 0;
+    ballots->columns = 0;
+    ballots->rejected = 0;
+}
+
+int add_ballot(ptrBallots ballots, const int *row, uint size) {
+    if (ballots == NULL || row == NULL || size == 0 || size >= MAX_TAB)
+        return -1;
+    if (ballots->columns == 0 && ballots->rows == 0)
+        ballots->columns = size;
+    if (size != ballots->columns)
+        return -1;
+    for (uint c = 0; c < size; c++) {
+        if (row[c] > MAX_RANK)
+            return -1;
+    }
+    if (ballots->rows == ballots->capacity &&
+        reserve_ballots(ballots, ballots->rows < INITIAL_CAPACITY
+                                     ? INITIAL_CAPACITY
+                                     : ballots->rows + 1) != 0)
+        return -1;
+    for (uint c = 0; c < size; c++) {
+        ballots->ranks[(size_t)c * ballots->capacity + ballots->rows] =
+            row[c] > 0 ? (rank_t)row[c] : RANK_NONE;
+    }
+    ballots->rows++;
+    return 0;
+}
+
+/**
+ * @brief Parses the last `nb` fields of a CSV line into `row`.
+ *
+ * @return true if the line holds at least `start_pos + nb` fields.
+ */
+static bool parse_ballot_line(const char *line, int start_pos, int nb,
+                              int *row) {
+    const char *cursor = line;
+    for (int i = 0; i < start_pos; i++) {
+        cursor = strchr(cursor, ',');
+        if (cursor == NULL)
+            return false;
+        cursor++;
+    }
+    for (int i = 0; i < nb; i++) {
+        char *end;
+        row[i] = (int)strtol(cursor, &end, 10);
+        if (end == cursor)
+            return false;
+        cursor = strchr(end, ',');
+        if (cursor == NULL)
+            return i == nb - 1;
+        cursor++;
+    }
+    return true;
+}
+
+int set_ballots_from_file(ptrBallots ballots, const char *filename,
+                          int nb_candidates) {
+    if (ballots == NULL || filename == NULL || nb_candidates <= 0 ||
+        nb_candidates >= MAX_TAB)
+        return -1;
+    reset_ballots(ballots);
+
+    FILE *file = fopen(filename, "r");
+    if (file == NULL)
+        return -1;
+
+    STATS_BEGIN(PHASE_HEADER);
+    char *line = NULL;
+    size_t line_size = 0;
+    ssize_t length = getline(&line, &line_size, file);
+    if (length == -1) {
+        STATS_END(PHASE_HEADER);
+        free(line);
+        fclose(file);
+        return -1;
+    }
+    STATS_ADD(COUNTER_BYTES, length);
+
+    // The ranks are the last nb_candidates columns of the header
+    int total_cols = 1;
+    for (const char *c = line; *c; c++) {
+        if (*c == ',')
+            total_cols++;
+    }
+    int start_pos = total_cols - nb_candidates;
+    if (start_pos < 0) {
+        STATS_END(PHASE_HEADER);
+        free(line);
+        fclose(file);
+        return -1;
+    }
+
+    char *save;
+    char *token = strtok_r(line, ",", &save);
+    for (int i = 0; token != NULL; i++) {
+        if (i >= start_pos) {
+            char *name = extract_column_name(token);
+            ballots->tags[i - start_pos] =
+                init_stringbuffer(name, strlen(name));
+        }
+        token = strtok_r(NULL, ",", &save);
+    }
+    ballots->columns = nb_candidates;
+    STATS_END(PHASE_HEADER);
+
+    STATS_BEGIN(PHASE_ROWS);
+    int row[MAX_TAB];
+    while ((length = getline(&line, &line_size, file)) != -1) {
+        STATS_ADD(COUNTER_BYTES, length);
+        if (strspn(line, " \t\r\n") == strlen(line))
+            continue; // Skip blank lines
+        if (!parse_ballot_line(line, start_pos, nb_candidates, row) ||
+            add_ballot(ballots, row, nb_candidates) != 0) {
+            ballots->rejected++;
+        }
+    }
+    STATS_ADD(COUNTER_BALLOTS, ballots->rows);
+    STATS_ADD(COUNTER_REJECTED, ballots->rejected);
+    STATS_END(PHASE_ROWS);
+
+    free(line);
+    fclose(file);
+    return 0;
+}
+
+int write_ballots(const Ballots *ballots, FILE *file) {
+    if (ballots == NULL || file == NULL)
+        return -1;
+    uint header[3] = {ballots->rows, ballots->columns, ballots->rejected};
+    if (fwrite(header, sizeof(uint), 3, file) != 3)
+        return -1;
+    for (uint c = 0; c < ballots->columns; c++) {
+        if (write_stringbuffer(ballots->tags[c], file) != 0)
+            return -1;
+    }
+    for (uint c = 0; c < ballots->columns && ballots->rows > 0; c++) {
+        if (fwrite(get_ballots_column(ballots, c), sizeof(rank_t),
+                   ballots->rows, file) != ballots->rows)
+            return -1;
+    }
+    return 0;
+}
+
+int read_ballots(ptrBallots ballots, FILE *file) {
+    if (ballots == NULL || file == NULL)
+        return -1;
+    clear_ballots(ballots);
+    uint header[3];
+    if (fread(header, sizeof(uint), 3, file) != 3 || header[1] >= MAX_TAB)
+        return -1;
+    ballots->columns = header[1];
+    for (uint c = 0; c < ballots->columns; c++) {
+        if ((ballots->tags[c] = read_stringbuffer(file)) == NULL) {
+            clear_ballots(ballots);
+            return -1;
+        }
+    }
+    if (reserve_ballots(ballots, header[0]) != 0) {
+        clear_ballots(ballots);
+        return -1;
+    }
+    for (uint c = 0; c < ballots->columns && header[0] > 0; c++) {
+        rank_t *column = ballots->ranks + (size_t)c * ballots->capacity;
+        if (fread(column, sizeof(rank_t), header[0], file) != header[0]) {
+            clear_ballots(ballots);
+            return -1;
+        }
+    }
+    ballots->rows = header[0];
+    ballots->rejected = header[2];
+    return 0;
+}
+
+void clear_ballots(ptrBallots ballots) {
+    if (ballots == NULL)
+        return;
+    reset_ballots(ballots);
+    mem_free(ballots->ranks);
+    ballots->ranks = NULL;
+    ballots->allocated = 0;
+}
+
+void delete_ballots(ptrBallots ballots) {
+    if (ballots == NULL)
+        return;
+    clear_ballots(ballots);
+    mem_free(ballots);
+}
@@ -0,0 +1,168 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Ballots
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef BALLOTS_H
+#define BALLOTS_H
+
+#include "miscellaneous.h"
+#include "stringbuffer.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Ballots Ballot Store
+ * @{
+ */
+
+/**
+ * @brief Rank stored for a candidate the voter left unranked (-1 in files).
+ */
+#define RANK_NONE 0
+
+/**
+ * @brief Largest rank (or grade) value a ballot can hold.
+ */
+#define MAX_RANK 255
+
+/**
+ * @brief Narrow storage type for a single rank or grade.
+ */
+typedef unsigned char rank_t;
+
+/**
+ * @brief Structure for holding every ballot of an election.
+ *
+ * Unlike Matrix, the number of ballots is only bounded by memory. Ranks are
+ * kept column-major (all the ranks given to candidate 0, then candidate 1,
+ * ...) so per-candidate scans read contiguous bytes. The original ranks are
+ * kept untouched, methods that need a reduced view build it on the side.
+ */
+typedef struct s_ballots {
+    StringBuffer *tags[MAX_TAB]; /**< The names of the candidates */
+    rank_t *ranks;               /**< Column c starts at c * capacity */
+    uint capacity;               /**< Number of ballots a column can hold */
+    size_t allocated;            /**< Size of the ranks buffer in bytes */
+    uint rows;                   /**< The number of ballots */
+    uint columns;                /**< The number of candidates */
+    uint rejected;               /**< Rows rejected while parsing */
+} Ballots;
+
+/**
+ * @brief Typedef for a pointer to a Ballots structure.
+ */
+typedef Ballots *ptrBallots;
+
+/**
+ * @brief Returns the rank a ballot gives to a candidate.
+ *
+ * @param[in] ballots The ballot store.
+ * @param[in] ballot Index of the ballot.
+ * @param[in] candidate Index of the candidate.
+ * @return The stored rank, RANK_NONE when the candidate is unranked.
+ */
+static inline rank_t get_ballot_rank(const Ballots *ballots, uint ballot,
+                                     uint candidate) {
+    return ballots->ranks[(size_t)candidate * ballots->capacity + ballot];
+}
+
+/**
+ * @brief Returns the contiguous column of ranks given to a candidate.
+ *
+ * @param[in] ballots The ballot store.
+ * @param[in] candidate Index of the candidate.
+ * @return A pointer to `ballots->rows` ranks.
+ */
+static inline const rank_t *get_ballots_column(const Ballots *ballots,
+                                               uint candidate) {
+    return ballots->ranks + (size_t)candidate * ballots->capacity;
+}
+
+/**
+ * @brief Creates a new, empty ballot store.
+ *
+ * @return A pointer to the newly allocated Ballots, or NULL if memory
+ * allocation fails.
+ *
+ * @post The returned Ballots must be freed by the caller using delete_ballots
+ * to avoid memory leaks.
+ */
+ptrBallots init_ballots(void);
+
+/**
+ * @brief Appends one ballot to the store.
+ *
+ * Values lower than 1 (such as -1) are stored as RANK_NONE.
+ *
+ * @param[in,out] ballots The ballot store.
+ * @param[in] row The ranks of the ballot, one per candidate.
+ * @param[in] size The number of values in row, must match the number of
+ *                 candidates once the first ballot is added.
+ * @return 0 on success, -1 if the row is invalid or memory is exhausted.
+ */
+int add_ballot(ptrBallots ballots, const int *row, uint size);
+
+/**
+ * @brief Sets a ballot store with data from a CSV file.
+ *
+ * Reads the same layout as fetch_data: a header line, then one ballot per
+ * line whose last `nb_candidates` fields hold the ranks. The file is read
+ * once and lines have no length limit. Rows that are too short or hold a
+ * rank above MAX_RANK are counted in `rejected` and skipped.
+ *
+ * @param[in,out] ballots The ballot store to fill, cleared first. Its ranks
+ *                        buffer is kept, so loading file after file into
+ *                        the same store stops allocating once it fits.
+ * @param[in] filename Path to the CSV file containing voting data.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @return 0 on success, -1 on failure.
+ *
+ * @pre nb_candidates must be positive and lower than MAX_TAB.
+ */
+int set_ballots_from_file(ptrBallots ballots, const char *filename,
+                          int nb_candidates);
+
+/**
+ * @brief Writes a ballot store in binary form.
+ *
+ * The counts, the tags and then every column are written as they are held
+ * in memory, so reading them back needs no parsing.
+ *
+ * @param[in] ballots The ballot store.
+ * @param[in] file The stream to write to, opened in binary mode.
+ * @return 0 on success, -1 on failure.
+ */
+int write_ballots(const Ballots *ballots, FILE *file);
+
+/**
+ * @brief Reads a ballot store written by write_ballots.
+ *
+ * @param[in,out] ballots The ballot store to fill, cleared first.
+ * @param[in] file The stream to read from, opened in binary mode.
+ * @return 0 on success, -1 if the data is truncated or invalid.
+ */
+int read_ballots(ptrBallots ballots, FILE *file);
+
+/**
+ * @brief Clears every ballot and tag of a ballot store.
+ *
+ * @param[in,out] ballots The ballot store to clear.
+ */
+void clear_ballots(ptrBallots ballots);
+
+/**
+ * @brief Frees the memory allocated for a ballot store.
+ *
+ * @param[in] ballots The ballot store to free.
+ */
+void delete_ballots(ptrBallots ballots);
+
+/** @} */ // End of Ballots group
+
+#endif // BALLOTS_H
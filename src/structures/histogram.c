@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation of Histograms
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "histogram.h"
+#include "allocator.h"
+#include "ballots.h"
+#include "miscellaneous.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+ptrHistogram init_histogram(void) {
+    ptrHistogram histogram = mem_alloc(sizeof(Histogram));
+    if (histogram == NULL)
+        return NULL;
+    clear_histogram(histogram);
+    return histogram;
+}
+
+void set_histogram_from_ballots(ptrHistogram histogram,
+                                const Ballots *ballots) {
+    if (histogram == NULL || ballots == NULL)
+        return;
+    clear_histogram(histogram);
+    histogram->rows = ballots->columns;
+    histogram->ballots = ballots->rows;
+
+    uint partial[4][MAX_RANK + 1];
+    uint highest = 0;
+    for (uint c = 0; c < ballots->columns; c++) {
+        const rank_t *column = get_ballots_column(ballots, c);
+        memset(partial, 0, sizeof(partial));
+        uint i = 0;
+        for (; i + 4 <= ballots->rows; i += 4) {
+            partial[0][column[i]]++;
+            partial[1][column[i + 1]]++;
+            partial[2][column[i + 2]]++;
+            partial[3][column[i + 3]]++;
+        }
+        for (; i < ballots->rows; i++)
+            partial[0][column[i]]++;
+        for (uint v = 0; v <= MAX_RANK; v++) {
+            histogram->counts[c][v] =
+                partial[0][v] + partial[1][v] + partial[2][v] + partial[3][v];
+            if (histogram->counts[c][v] != 0 && v > highest)
+                highest = v;
+        }
+    }
+    histogram->columns = highest + 1;
+}
+
+uint get_histogram_prefix(const Histogram *histogram, uint candidate,
+                          uint value) {
+    uint total = 0;
+    for (uint v = 1; v <= value && v < histogram->columns; v++)
+        total += histogram->counts[candidate][v];
+    return total;
+}
+
+int write_histogram(const Histogram *histogram, FILE *file) {
+    if (histogram == NULL || file == NULL)
+        return -1;
+    uint header[3] = {histogram->rows, histogram->columns, histogram->ballots};
+    if (fwrite(header, sizeof(uint), 3, file) != 3)
+        return -1;
+    for (uint c = 0; c < histogram->rows; c++) {
+        if (fwrite(histogram->counts[c], sizeof(uint), histogram->columns,
+                   file) != histogram->columns)
+            return -1;
+    }
+    return 0;
+}
+
+int read_histogram(ptrHistogram histogram, FILE *file) {
+    if (histogram == NULL || file == NULL)
+        return -1;
+    clear_histogram(histogram);
+    uint header[3];
+    if (fread(header, sizeof(uint), 3, file) != 3 || header[0] > MAX_TAB ||
+        header[1] > MAX_RANK + 1)
+        return -1;
+    for (uint c = 0; c < header[0]; c++) {
+        if (fread(histogram->counts[c], sizeof(uint), header[1], file) !=
+            header[1]) {
+            clear_histogram(histogram);
+            return -1;
+        }
+    }
+    histogram->rows = header[0];
+    histogram->columns = header[1];
+    histogram->ballots = header[2];
+    return 0;
+}
+
+void clear_histogram(ptrHistogram histogram) {
+    if (histogram == NULL)
+        return;
+    memset(histogram->counts, 0, sizeof(histogram->counts));
+    histogram->rows = 0;
+    histogram->columns = 0;
+    histogram->ballots = 0;
+}
+
+void delete_histogram(ptrHistogram histogram) {
+    mem_free(histogram);
+}
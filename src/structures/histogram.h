@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Histograms
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "ballots.h"
+#include "miscellaneous.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Histogram Histogram Handling
+ * @{
+ */
+
+/**
+ * @brief Structure counting how often each candidate received each value.
+ *
+ * `counts[c][v]` is the number of ballots that gave the value `v` (a rank or
+ * a grade) to candidate `c`, `counts[c][RANK_NONE]` the number of ballots
+ * that left it out. Once built, methods that only depend on those counts no
+ * longer need to read the ballots.
+ */
+typedef struct s_histogram {
+    uint counts[MAX_TAB][MAX_RANK + 1]; /**< The counts of each value */
+    uint rows;                          /**< The number of candidates */
+    uint columns;                       /**< Highest value seen + 1 */
+    uint ballots;                       /**< The number of ballots counted */
+} Histogram;
+
+/**
+ * @brief Typedef for a pointer to a Histogram structure.
+ */
+typedef Histogram *ptrHistogram;
+
+/**
+ * @brief Creates a new, empty histogram.
+ *
+ * @return A pointer to the newly allocated Histogram, or NULL if memory
+ * allocation fails.
+ *
+ * @post The returned Histogram must be freed by the caller using
+ * delete_histogram to avoid memory leaks.
+ */
+ptrHistogram init_histogram(void);
+
+/**
+ * @brief Counts the values of every ballot.
+ *
+ * Each candidate column is read once, in order, into independent partial
+ * counters so consecutive equal values do not serialize on the same counter.
+ *
+ * @param[in,out] histogram The histogram to set, cleared first.
+ * @param[in] ballots The ballots to count.
+ */
+void set_histogram_from_ballots(ptrHistogram histogram,
+                                const Ballots *ballots);
+
+/**
+ * @brief Returns how many ballots gave candidate a value in [1, value].
+ *
+ * @param[in] histogram The histogram.
+ * @param[in] candidate Index of the candidate.
+ * @param[in] value The highest value counted.
+ * @return The number of ballots.
+ */
+uint get_histogram_prefix(const Histogram *histogram, uint candidate,
+                          uint value);
+
+/**
+ * @brief Writes a histogram in binary form, only the values seen.
+ *
+ * @param[in] histogram The histogram to write.
+ * @param[in] file The stream to write to, opened in binary mode.
+ * @return 0 on success, -1 on failure.
+ */
+int write_histogram(const Histogram *histogram, FILE *file);
+
+/**
+ * @brief Reads a histogram written by write_histogram.
+ *
+ * @param[in,out] histogram The histogram to set, cleared first.
+ * @param[in] file The stream to read from, opened in binary mode.
+ * @return 0 on success, -1 if the data is truncated or invalid.
+ */
+int read_histogram(ptrHistogram histogram, FILE *file);
+
+/**
+ * @brief Clears every count of a histogram.
+ *
+ * @param[in,out] histogram The histogram to clear.
+ */
+void clear_histogram(ptrHistogram histogram);
+
+/**
+ * @brief Frees the memory allocated for a Histogram.
+ *
+ * @param[in] histogram The Histogram to free.
+ */
+void delete_histogram(ptrHistogram histogram);
+
+/** @} */ // End of Histogram group
+
+#endif // HISTOGRAM_H
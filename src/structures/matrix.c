@@ -7,7 +7,10 @@
 /*-----------------------------------------------------------------*/
 
 #include "matrix.h"
+#include "allocator.h"
+#include "ballots.h"
 #include "miscellaneous.h"
+#include "stats.h"
 #include "stringbuffer.h"
 #include <math.h>
 #include <stdbool.h>
@@ -18,7 +21,7 @@
 /*-----------------------------------------------------------------*/
 
 ptrMatrix init_matrix(bool is_duel) {
-    ptrMatrix matrix = malloc(sizeof(Matrix));
+    ptrMatrix matrix = mem_alloc(sizeof(Matrix));
     if (matrix == NULL)
         return NULL;
     matrix->is_duel = is_duel;
@@ -27,30 +30,31 @@ ptrMatrix init_matrix(bool is_duel) {
     return matrix;
 }
 
-void set_matrix_from_file(ptrMatrix matrix, char *filename, int nb_candidates) {
+int set_matrix_from_file(ptrMatrix matrix, char *filename, int nb_candidates) {
     if (filename == NULL || nb_candidates <= 0)
-        return;
+        return -1;
     clear_matrix(matrix);
     char **columns_name;
     int **data, rows, cols;
-    fetch_data(filename, nb_candidates, &columns_name, &data, &rows, &cols);
-    matrix->columns = cols;
-    matrix->rows = rows;
-    for (int i = 0; i < cols; ++i) {
+    if (fetch_data(filename, nb_candidates, &columns_name, &data, &rows,
+                   &cols) != 0)
+        return -1;
+    // A matrix holds at most MAX_TAB rows, the last one being kept for the
+    // totals of add_totals_row, larger elections need Ballots
+    bool fits = rows < MAX_TAB && cols <= MAX_TAB;
+    matrix->columns = fits ? cols : 0;
+    matrix->rows = fits ? rows : 0;
+    for (int i = 0; fits && i < cols; ++i) {
         matrix->tags[i] =
             init_stringbuffer(columns_name[i], strlen(columns_name[i]));
     }
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; j++) {
-            matrix->data[i][j] = data[i][j];
-        }
-    }
-    for (int i = 0; i < rows; i++)
-        free(data[i]);
+    for (int i = 0; fits && i < rows; ++i)
+        memcpy(matrix->data[i], data[i], sizeof(int) * cols);
     for (int i = 0; i < cols; i++)
-        free(columns_name[i]);
-    free(columns_name);
-    free(data);
+        mem_free(columns_name[i]);
+    mem_free(columns_name);
+    mem_free(data);
+    return fits ? 0 : -1;
 }
 
 int duel_matrix(ptrMatrix ballot, int first, int second, int nb_candidates) {
@@ -64,11 +68,16 @@ int duel_matrix(ptrMatrix ballot, int first, int second, int nb_candidates) {
     return score;
 }
 
-void set_duel_from_file(ptrMatrix duel, char *filename, int nb_candidates) {
+int set_duel_from_file(ptrMatrix duel, char *filename, int nb_candidates) {
     if (filename == NULL || nb_candidates <= 0)
-        return;
+        return -1;
     ptrMatrix ballot = init_matrix(false);
-    set_matrix_from_file(ballot, filename, nb_candidates);
+    if (ballot == NULL ||
+        set_matrix_from_file(ballot, filename, nb_candidates) != 0) {
+        delete_matrix(ballot);
+        return -1;
+    }
+    STATS_BEGIN(PHASE_PAIRWISE);
     for (int i = 0; i < nb_candidates; i++) {
         duel->tags[i] =
             init_stringbuffer(ballot->tags[i]->string, ballot->tags[i]->size);
@@ -81,7 +90,39 @@ void set_duel_from_file(ptrMatrix duel, char *filename, int nb_candidates) {
         }
     }
     duel->rows = duel->columns = nb_candidates;
+    STATS_END(PHASE_PAIRWISE);
     delete_matrix(ballot);
+    return 0;
+}
+
+void set_duel_from_ballots(ptrMatrix duel, const Ballots *ballots) {
+    if (duel == NULL || ballots == NULL)
+        return;
+    STATS_BEGIN(PHASE_PAIRWISE);
+    clear_matrix(duel);
+    uint nb_candidates = ballots->columns;
+    for (uint i = 0; i < nb_candidates; i++) {
+        const StringBuffer *tag = ballots->tags[i];
+        duel->tags[i] = tag != NULL ? init_stringbuffer(tag->string, tag->size)
+                                    : init_stringbuffer(NULL, 0);
+        duel->data[i][i] = 0;
+    }
+    for (uint i = 0; i < nb_candidates; i++) {
+        const rank_t *first = get_ballots_column(ballots, i);
+        for (uint j = i + 1; j < nb_candidates; j++) {
+            const rank_t *second = get_ballots_column(ballots, j);
+            int wins = 0, losses = 0;
+            for (uint k = 0; k < ballots->rows; k++) {
+                bool ranked = first[k] != RANK_NONE && second[k] != RANK_NONE;
+                wins += ranked && first[k] < second[k];
+                losses += ranked && second[k] < first[k];
+            }
+            duel->data[i][j] = wins;
+            duel->data[j][i] = losses;
+        }
+    }
+    duel->rows = duel->columns = nb_candidates;
+    STATS_END(PHASE_PAIRWISE);
 }
 
 void add_row(ptrMatrix matrix, int row[], uint size) {
@@ -133,10 +174,11 @@ void add_totals_row(ptrMatrix matrix) {
     }
 }
 
-void print_matrix(ptrMatrix matrix, const char *separator) {
-    if (matrix == NULL || matrix->columns == 0 || matrix->rows == 0)
-        return;
-
+/**
+ * @brief Renders a matrix as the aligned text table of print_matrix.
+ */
+static void emit_matrix_text(ptrWriter writer, const Matrix *matrix,
+                             const char *separator) {
     unsigned padding = 0;
     if (matrix->is_duel) {
         for (unsigned i = 0; i < matrix->columns; ++i) {
@@ -144,59 +186,183 @@ void print_matrix(ptrMatrix matrix, const char *separator) {
                 calculate_visual_length(matrix->tags[i]->string);
             padding = padding < visualLength ? visualLength : padding;
         }
-        printf("%s%*s%s", separator, padding, "", separator);
+        write_text(writer, separator);
+        write_repeated(writer, ' ', padding);
+        write_text(writer, separator);
     }
 
     // Calculate the maximum width for each column
-    int *colWidths = (int *)malloc(matrix->columns * sizeof(int));
+    int *colWidths = mem_alloc(matrix->columns * sizeof(int));
     for (uint j = 0; j < matrix->columns; ++j) {
-        unsigned headerLength =
-            calculate_visual_length(matrix->tags[j]->string);
-        colWidths[j] = headerLength;
+        colWidths[j] = calculate_visual_length(matrix->tags[j]->string);
         for (uint i = 0; i < matrix->rows; ++i) {
-            int numDigits = snprintf(NULL, 0, "%d", matrix->data[i][j]);
+            int numDigits = count_digits(matrix->data[i][j]);
             if (numDigits > colWidths[j]) {
                 colWidths[j] = numDigits;
             }
         }
     }
 
-    // Print column names with separators and spaces
+    // Column names, centered within the column width
     for (uint j = 0; j < matrix->columns; ++j) {
         int headerLength = calculate_visual_length(matrix->tags[j]->string);
         int colWidth = colWidths[j];
-        int leftPadding = floor((colWidth - headerLength) / 2.0);
-        int rightPadding = ceil((colWidth - headerLength) / 2.0);
-
-        // Print left padding, header, right padding, and separator
-        printf("%s%*s", separator, leftPadding, "");
-        print_stringbuffer(matrix->tags[j], STDOUT_AS_LIST, "");
-        printf("%*s%s", rightPadding, "", separator);
+        write_text(writer, separator);
+        write_repeated(writer, ' ', floor((colWidth - headerLength) / 2.0));
+        write_text(writer, matrix->tags[j]->string);
+        write_repeated(writer, ' ', ceil((colWidth - headerLength) / 2.0));
+        write_text(writer, separator);
     }
-    printf("\n");
+    write_text(writer, "\n");
 
-    // Print matrix data, center-aligned within the column width
+    // Matrix data, center-aligned within the column width
     for (uint i = 0; i < matrix->rows; ++i) {
         if (matrix->is_duel) {
-            unsigned visualLength =
-                calculate_visual_length(matrix->tags[i]->string);
-            printf("%s%*s", separator, visualLength - matrix->tags[i]->size,
-                   "");
-            printf("%*s%s", padding, matrix->tags[i]->string, separator);
+            // Right-aligned on the visual length of the longest name
+            const StringBuffer *tag = matrix->tags[i];
+            unsigned visualLength = calculate_visual_length(tag->string);
+            write_text(writer, separator);
+            write_repeated(writer, ' ', tag->size - visualLength);
+            if (padding > tag->size)
+                write_repeated(writer, ' ', padding - tag->size);
+            write_text(writer, tag->string);
+            write_text(writer, separator);
         }
         for (uint j = 0; j < matrix->columns; ++j) {
-            int numDigits = snprintf(NULL, 0, "%d", matrix->data[i][j]);
+            int numDigits = count_digits(matrix->data[i][j]);
             int colWidth = colWidths[j];
-            int leftPadding = floor((colWidth - numDigits) / 2.0);
-            int rightPadding = ceil((colWidth - numDigits) / 2.0);
+            write_text(writer, separator);
+            write_repeated(writer, ' ', floor((colWidth - numDigits) / 2.0));
+            write_integer(writer, matrix->data[i][j]);
+            write_repeated(writer, ' ', ceil((colWidth - numDigits) / 2.0));
+            write_text(writer, separator);
+        }
+        write_text(writer, "\n");
+    }
+    mem_free(colWidths);
+}
 
-            // Print left padding, data, right padding, and separator
-            printf("%s%*s%d%*s%s", separator, leftPadding, "",
-                   matrix->data[i][j], rightPadding, "", separator);
+void emit_matrix(ptrWriter writer, const Matrix *matrix,
+                 const char *separator) {
+    if (writer == NULL || matrix == NULL || matrix->columns == 0 ||
+        matrix->rows == 0)
+        return;
+    STATS_BEGIN(PHASE_OUTPUT);
+    switch (writer->format) {
+    case FORMAT_TEXT:
+        emit_matrix_text(writer, matrix, separator);
+        break;
+    case FORMAT_CSV:
+        // Duels name their rows in a first column
+        if (matrix->is_duel)
+            write_text(writer, ",");
+        for (uint j = 0; j < matrix->columns; j++) {
+            if (j > 0)
+                write_text(writer, ",");
+            write_csv_field(writer, matrix->tags[j]->string);
+        }
+        write_text(writer, "\n");
+        for (uint i = 0; i < matrix->rows; i++) {
+            if (matrix->is_duel) {
+                write_csv_field(writer, matrix->tags[i]->string);
+                write_text(writer, ",");
+            }
+            for (uint j = 0; j < matrix->columns; j++) {
+                if (j > 0)
+                    write_text(writer, ",");
+                write_integer(writer, matrix->data[i][j]);
+            }
+            write_text(writer, "\n");
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_JSON:
+        write_text(writer, "{\"type\":\"matrix\",\"duel\":");
+        write_text(writer, matrix->is_duel ? "true" : "false");
+        write_text(writer, ",\"columns\":[");
+        for (uint j = 0; j < matrix->columns; j++) {
+            if (j > 0)
+                write_text(writer, ",");
+            write_json_string(writer, matrix->tags[j]->string);
+        }
+        write_text(writer, "],\"rows\":[");
+        for (uint i = 0; i < matrix->rows; i++) {
+            write_text(writer, i > 0 ? ",[" : "[");
+            for (uint j = 0; j < matrix->columns; j++) {
+                if (j > 0)
+                    write_text(writer, ",");
+                write_integer(writer, matrix->data[i][j]);
+            }
+            write_text(writer, "]");
+        }
+        write_text(writer, "]}\n");
+        break;
+    case FORMAT_BINARY:
+        write_bytes(writer, &(uint8_t){RECORD_MATRIX}, 1);
+        write_u32(writer, matrix->rows);
+        write_u32(writer, matrix->columns);
+        write_bytes(writer, &(uint8_t){matrix->is_duel}, 1);
+        for (uint j = 0; j < matrix->columns; j++)
+            write_binary_string(writer, matrix->tags[j]->string);
+        for (uint i = 0; i < matrix->rows; i++)
+            write_bytes(writer, matrix->data[i], sizeof(int) * matrix->columns);
+        break;
+    }
+    STATS_END(PHASE_OUTPUT);
+}
+
+void print_matrix(ptrMatrix matrix, const char *separator) {
+    ptrWriter writer = open_writer(NULL, FORMAT_TEXT);
+    if (writer == NULL)
+        return;
+    emit_matrix(writer, matrix, separator);
+    close_writer(writer);
+}
+
+int write_matrix(const Matrix *matrix, FILE *file) {
+    if (matrix == NULL || file == NULL)
+        return -1;
+    uint header[3] = {matrix->rows, matrix->columns, matrix->is_duel};
+    if (fwrite(header, sizeof(uint), 3, file) != 3)
+        return -1;
+    for (uint j = 0; j < matrix->columns; j++) {
+        if (write_stringbuffer(matrix->tags[j], file) != 0)
+            return -1;
+    }
+    for (uint i = 0; i < matrix->rows; i++) {
+        if (fwrite(matrix->data[i], sizeof(int), matrix->columns, file) !=
+            matrix->columns)
+            return -1;
+    }
+    return 0;
+}
+
+int read_matrix(ptrMatrix matrix, FILE *file) {
+    if (matrix == NULL || file == NULL)
+        return -1;
+    clear_matrix(matrix);
+    uint header[3];
+    if (fread(header, sizeof(uint), 3, file) != 3 || header[0] > MAX_TAB ||
+        header[1] > MAX_TAB)
+        return -1;
+    matrix->is_duel = header[2];
+    for (uint j = 0; j < header[1]; j++) {
+        if ((matrix->tags[j] = read_stringbuffer(file)) == NULL) {
+            matrix->columns = j;
+            clear_matrix(matrix);
+            return -1;
+        }
+    }
+    matrix->columns = header[1];
+    for (uint i = 0; i < header[0]; i++) {
+        if (fread(matrix->data[i], sizeof(int), matrix->columns, file) !=
+            matrix->columns) {
+            clear_matrix(matrix);
+            return -1;
         }
-        printf("\n");
     }
-    free(colWidths);
+    matrix->rows = header[0];
+    return 0;
 }
 
 void clear_matrix(ptrMatrix matrix) {
@@ -214,5 +380,5 @@ void delete_matrix(ptrMatrix matrix) {
     if (matrix == NULL)
         return;
     clear_matrix(matrix);
-    free(matrix);
+    mem_free(matrix);
 }
@@ -9,8 +9,10 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include "ballots.h"
 #include "miscellaneous.h"
 #include "stringbuffer.h"
+#include "writer.h"
 #include <stdbool.h>
 
 /*-----------------------------------------------------------------*/
@@ -62,6 +64,9 @@ ptrMatrix init_matrix(bool is_duel);
  * @param[in,out] matrix The matrix to be set with data.
  * @param[in] filename Path to the CSV file containing voting data.
  * @param[in] nb_candidates Number of candidates in the election.
+ * @return 0 on success, -1 if the file cannot be read or holds MAX_TAB
+ * rows or more, the matrix being left empty. The last row is kept for the
+ * totals of add_totals_row.
  *
  * @pre
  *   - matrix must be a valid pointer to a ptrMatrix object.
@@ -72,9 +77,30 @@ ptrMatrix init_matrix(bool is_duel);
  *   - The matrix is populated with data from the CSV file.
  *   - The matrix's rows and columns are set according to the data.
  */
-void set_matrix_from_file(ptrMatrix matrix, char *filename, int nb_candidates);
+int set_matrix_from_file(ptrMatrix matrix, char *filename, int nb_candidates);
 
-void set_duel_from_file(ptrMatrix duel, char *filename, int nb_candidates);
+/**
+ * @brief Sets a duel matrix from the ballots of a CSV file.
+ *
+ * @param[in,out] duel The matrix to set.
+ * @param[in] filename Path to the CSV file containing voting data.
+ * @param[in] nb_candidates Number of candidates in the election.
+ * @return 0 on success, -1 if the file cannot be read or does not fit in a
+ * matrix (see set_matrix_from_file), the duel being left untouched.
+ */
+int set_duel_from_file(ptrMatrix duel, char *filename, int nb_candidates);
+
+/**
+ * @brief Sets a duel matrix from a ballot store.
+ *
+ * `duel->data[i][j]` is the number of ballots ranking i strictly better than
+ * j, both being ranked, as in set_duel_from_file. Every pair compares two
+ * contiguous rank columns, so the inner loop reads bytes sequentially.
+ *
+ * @param[in,out] duel The matrix to set, cleared first.
+ * @param[in] ballots The ballots of the election.
+ */
+void set_duel_from_ballots(ptrMatrix duel, const Ballots *ballots);
 
 /**
  * @brief Adds a totals row to a matrix.
@@ -113,6 +139,38 @@ void add_totals_row(ptrMatrix matrix);
  */
 void print_matrix(ptrMatrix matrix, const char *separator);
 
+/**
+ * @brief Writes a matrix as a record of a writer.
+ *
+ * The text format is the table of print_matrix, columns centered and
+ * duels naming their rows. CSV gives a block of rows, JSON a "matrix"
+ * object and the binary format a RECORD_MATRIX.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] matrix The matrix, nothing is written if it is empty.
+ * @param[in] separator The separator of the text columns.
+ */
+void emit_matrix(ptrWriter writer, const Matrix *matrix,
+                 const char *separator);
+
+/**
+ * @brief Writes a Matrix in binary form: its size, its tags, then its rows.
+ *
+ * @param[in] matrix The Matrix to write.
+ * @param[in] file The stream to write to, opened in binary mode.
+ * @return 0 on success, -1 on failure.
+ */
+int write_matrix(const Matrix *matrix, FILE *file);
+
+/**
+ * @brief Reads a Matrix written by write_matrix.
+ *
+ * @param[in,out] matrix The Matrix to set, cleared first.
+ * @param[in] file The stream to read from, opened in binary mode.
+ * @return 0 on success, -1 if the data is truncated or invalid.
+ */
+int read_matrix(ptrMatrix matrix, FILE *file);
+
 /**
  * @brief Clears the data from a Matrix.
  *
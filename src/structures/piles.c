@@ -0,0 +1,165 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation of Ballot Piles
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "piles.h"
+#include "allocator.h"
+#include "ballots.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Key of a rank on the followed side, the highest key being the end
+ * of the ballot that is followed. -1 means the candidate cannot be there.
+ */
+static int side_key(enum PileSide side, rank_t rank) {
+    if (side == PILE_TOP)
+        return rank == RANK_NONE ? -1 : MAX_RANK + 1 - rank;
+    return rank == RANK_NONE ? MAX_RANK + 1 : rank;
+}
+
+static void push_node(ptrPiles piles, int node, int candidate) {
+    piles->watch[node] = candidate;
+    piles->next[node] = piles->heads[candidate];
+    piles->heads[candidate] = node;
+}
+
+/**
+ * @brief Finds the continuing candidates holding the followed end of a
+ * ballot, other than `skip`.
+ *
+ * @return How many candidates hold it (at most 2 are stored in found).
+ */
+static int find_end(const Piles *piles, uint ballot, int skip, int *key,
+                    int found[2]) {
+    int best = -1, nb_found = 0;
+    for (uint c = 0; c < piles->ballots->columns; c++) {
+        if (!piles->continuing[c] || (int)c == skip)
+            continue;
+        int k =
+            side_key(piles->side, get_ballot_rank(piles->ballots, ballot, c));
+        if (k < 0 || k < best)
+            continue;
+        if (k > best) {
+            best = k;
+            nb_found = 0;
+        }
+        if (nb_found < 2)
+            found[nb_found] = c;
+        nb_found++;
+    }
+    *key = best;
+    return nb_found;
+}
+
+/**
+ * @brief Puts a ballot with no live node back into the piles.
+ */
+static void place_ballot(ptrPiles piles, uint ballot) {
+    int key, found[2];
+    int nb_found = find_end(piles, ballot, -1, &key, found);
+    piles->watch[2 * ballot] = piles->watch[2 * ballot + 1] = -1;
+    if (nb_found == 0) {
+        piles->exhausted++;
+    } else if (nb_found == 1) {
+        push_node(piles, 2 * ballot, found[0]);
+        piles->counts[found[0]]++;
+    } else {
+        push_node(piles, 2 * ballot, found[0]);
+        push_node(piles, 2 * ballot + 1, found[1]);
+        piles->tied++;
+    }
+}
+
+ptrPiles init_piles(const Ballots *ballots, enum PileSide side) {
+    if (ballots == NULL)
+        return NULL;
+    ptrPiles piles = mem_alloc(sizeof(Piles));
+    if (piles == NULL)
+        return NULL;
+    piles->ballots = ballots;
+    piles->side = side;
+    piles->tied = piles->exhausted = 0;
+    piles->next = mem_alloc(sizeof(int) * 2 * ballots->rows + 1);
+    piles->watch = mem_alloc(sizeof(short) * 2 * ballots->rows + 1);
+    if (piles->next == NULL || piles->watch == NULL) {
+        delete_piles(piles);
+        return NULL;
+    }
+    for (uint c = 0; c < MAX_TAB; c++) {
+        piles->continuing[c] = c < ballots->columns;
+        piles->counts[c] = 0;
+        piles->heads[c] = -1;
+    }
+    for (uint i = 0; i < ballots->rows; i++)
+        place_ballot(piles, i);
+    return piles;
+}
+
+ptrPiles copy_piles(const Piles *piles) {
+    if (piles == NULL)
+        return NULL;
+    ptrPiles copy = mem_alloc(sizeof(Piles));
+    if (copy == NULL)
+        return NULL;
+    uint rows = piles->ballots->rows;
+    *copy = *piles;
+    copy->next = mem_alloc(sizeof(int) * 2 * rows + 1);
+    copy->watch = mem_alloc(sizeof(short) * 2 * rows + 1);
+    if (copy->next == NULL || copy->watch == NULL) {
+        delete_piles(copy);
+        return NULL;
+    }
+    memcpy(copy->next, piles->next, sizeof(int) * 2 * rows);
+    memcpy(copy->watch, piles->watch, sizeof(short) * 2 * rows);
+    return copy;
+}
+
+void eliminate_from_piles(ptrPiles piles, int candidate) {
+    if (piles == NULL || candidate < 0 || candidate >= MAX_TAB ||
+        !piles->continuing[candidate])
+        return;
+    piles->continuing[candidate] = false;
+    int node = piles->heads[candidate];
+    piles->heads[candidate] = -1;
+    piles->counts[candidate] = 0;
+
+    while (node != -1) {
+        int next = piles->next[node];
+        uint ballot = node / 2;
+        int other = piles->watch[node ^ 1];
+        piles->watch[node] = -1;
+        if (other == -1) {
+            // The ballot counted for the candidate, look for its new end
+            place_ballot(piles, ballot);
+        } else {
+            // The ballot was tied, the other watched candidate still holds
+            // the end: watch a third one or let the other one have it
+            int key, found[2];
+            int nb_found = find_end(piles, ballot, other, &key, found);
+            int other_key = side_key(
+                piles->side, get_ballot_rank(piles->ballots, ballot, other));
+            if (nb_found > 0 && key == other_key) {
+                push_node(piles, node, found[0]);
+            } else {
+                piles->tied--;
+                piles->counts[other]++;
+            }
+        }
+        node = next;
+    }
+}
+
+void delete_piles(ptrPiles piles) {
+    if (piles == NULL)
+        return;
+    mem_free(piles->next);
+    mem_free(piles->watch);
+    mem_free(piles);
+}
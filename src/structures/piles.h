@@ -0,0 +1,94 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Ballot Piles
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef PILES_H
+#define PILES_H
+
+#include "ballots.h"
+#include "miscellaneous.h"
+#include <stdbool.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Piles Ballot Piles
+ * @{
+ */
+
+/**
+ * @brief Which end of the ballots the piles follow.
+ */
+enum PileSide {
+    PILE_TOP,   /**< Best ranked continuing candidate */
+    PILE_BOTTOM /**< Worst ranked continuing candidate, unranked being worst */
+};
+
+/**
+ * @brief Ballots sorted into one pile per continuing candidate.
+ *
+ * A ballot whose top (or bottom) continuing candidate is unique sits in that
+ * candidate's pile and counts for it. A ballot tied between several
+ * continuing candidates counts for nobody and watches two of them, like the
+ * two watched literals of a SAT solver: it is only looked at again once one
+ * of the two is eliminated. Eliminating a candidate therefore only revisits
+ * the ballots of its own pile, never the whole election.
+ */
+typedef struct s_piles {
+    const Ballots *ballots;      /**< The ballots sorted, not owned */
+    enum PileSide side;          /**< The end of the ballots followed */
+    bool continuing[MAX_TAB];    /**< Candidates not eliminated yet */
+    uint counts[MAX_TAB];        /**< Ballots counting for each candidate */
+    int heads[MAX_TAB];          /**< First node of each candidate's pile */
+    int *next;                   /**< Next node, two nodes per ballot */
+    short *watch;                /**< Candidate of each node, -1 if unused */
+    uint tied;                   /**< Ballots tied between candidates */
+    uint exhausted;              /**< Ballots ranking no continuing one */
+} Piles;
+
+/**
+ * @brief Typedef for a pointer to a Piles structure.
+ */
+typedef Piles *ptrPiles;
+
+/**
+ * @brief Sorts every ballot into the pile of its top or bottom candidate.
+ *
+ * @param[in] ballots The ballots to sort, must outlive the piles.
+ * @param[in] side The end of the ballots to follow.
+ * @return The piles, or NULL if memory allocation fails.
+ *
+ * @post The returned Piles must be freed with delete_piles.
+ */
+ptrPiles init_piles(const Ballots *ballots, enum PileSide side);
+
+/**
+ * @brief Duplicates piles, so several counts can start from one sorting.
+ *
+ * @param[in] piles The piles to copy.
+ * @return The copy, or NULL if memory allocation fails.
+ */
+ptrPiles copy_piles(const Piles *piles);
+
+/**
+ * @brief Eliminates a candidate and moves the ballots of its pile.
+ *
+ * @param[in,out] piles The piles.
+ * @param[in] candidate The continuing candidate to eliminate.
+ */
+void eliminate_from_piles(ptrPiles piles, int candidate);
+
+/**
+ * @brief Frees piles.
+ *
+ * @param[in] piles The piles to free, may be NULL.
+ */
+void delete_piles(ptrPiles piles);
+
+/** @} */ // End of Piles group
+
+#endif // PILES_H
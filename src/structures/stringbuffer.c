@@ -7,6 +7,7 @@
 /*-----------------------------------------------------------------*/
 
 #include "stringbuffer.h"
+#include "allocator.h"
 #include "miscellaneous.h"
 #include <assert.h>
 #include <stdio.h>
@@ -17,12 +18,12 @@
 
 ptrStringBuffer init_stringbuffer(const char *initialString, uint size) {
     assert(size < MAX_STRING_SIZE);
-    ptrStringBuffer sb = malloc(sizeof(StringBuffer));
+    ptrStringBuffer sb = mem_alloc(sizeof(StringBuffer));
     if (sb == NULL) {
         return NULL;
     }
 
-    sb->string = calloc(size + 1, sizeof(char));
+    sb->string = mem_calloc(size + 1, sizeof(char));
     if (sb->string == NULL) {
         delete_stringbuffer(sb);
         return NULL;
@@ -45,7 +46,7 @@ void init_stringbuffer_stack(ptrStringBuffer stringBuffer,
 
     memset(stringBuffer, 0, sizeof(StringBuffer));
 
-    stringBuffer->string = calloc(size + 1, sizeof(char));
+    stringBuffer->string = mem_calloc(size + 1, sizeof(char));
     if (stringBuffer->string == NULL)
         return;
 
@@ -69,7 +70,7 @@ int append_string(ptrStringBuffer stringBuffer, const char *str, uint size) {
     if (str == NULL || stringBuffer->size + size >= MAX_STRING_SIZE) {
         return -1;
     }
-    char *temp = realloc(stringBuffer->string,
+    char *temp = mem_realloc(stringBuffer->string,
                          (stringBuffer->size + size + 1) * sizeof(char));
     if (temp == NULL)
         return -1;
@@ -87,7 +88,7 @@ int append_stringbuffer(ptrStringBuffer target, const ptrStringBuffer source) {
     assert(target != NULL && source != NULL);
     if (source->size + target->size >= MAX_STRING_SIZE)
         return -1;
-    char *temp = realloc(target->string,
+    char *temp = mem_realloc(target->string,
                          (target->size + source->size + 1) * sizeof(char));
     if (temp == NULL)
         return -1;
@@ -104,10 +105,28 @@ int append_stringbuffer(ptrStringBuffer target, const ptrStringBuffer source) {
 void clear_stringbuffer(ptrStringBuffer stringBuffer) {
     assert(stringBuffer != NULL);
     if (stringBuffer->string != NULL)
-        free(stringBuffer->string);
+        mem_free(stringBuffer->string);
     stringBuffer->size = 0;
 }
 
+int write_stringbuffer(const StringBuffer *stringBuffer, FILE *file) {
+    uint size = stringBuffer != NULL ? stringBuffer->size : 0;
+    if (fwrite(&size, sizeof(uint), 1, file) != 1 ||
+        (size > 0 && fwrite(stringBuffer->string, 1, size, file) != size))
+        return -1;
+    return 0;
+}
+
+ptrStringBuffer read_stringbuffer(FILE *file) {
+    uint size;
+    char string[MAX_STRING_SIZE];
+    if (fread(&size, sizeof(uint), 1, file) != 1 || size >= MAX_STRING_SIZE ||
+        fread(string, 1, size, file) != size)
+        return NULL;
+    string[size] = '\0';
+    return init_stringbuffer(string, size);
+}
+
 void print_stringbuffer(const ptrStringBuffer stringBuffer, uint outputType,
                         const char *separator) {
     assert(stringBuffer != NULL);
@@ -127,11 +146,11 @@ void print_stringbuffer(const ptrStringBuffer stringBuffer, uint outputType,
 void delete_stringbuffer(ptrStringBuffer stringBuffer) {
     assert(stringBuffer != NULL);
     clear_stringbuffer(stringBuffer);
-    free(stringBuffer);
+    mem_free(stringBuffer);
 }
 
 void delete_stringbuffer_stack(StringBuffer stringBuffer) {
     assert(stringBuffer.string != NULL);
-    free(stringBuffer.string);
+    mem_free(stringBuffer.string);
     stringBuffer.size = 0;
 }
@@ -11,6 +11,7 @@
 
 #include "miscellaneous.h"
 #include <stdbool.h>
+#include <stdio.h>
 
 /*-----------------------------------------------------------------*/
 
@@ -150,6 +151,25 @@ void clear_stringbuffer(ptrStringBuffer stringBuffer);
 void print_stringbuffer(const ptrStringBuffer stringBuffer, uint outputType,
                         const char *separator);
 
+/**
+ * @brief Writes a StringBuffer in binary form, its size then its characters.
+ *
+ * @param[in] stringBuffer The StringBuffer to write, NULL being written as an
+ *                         empty string.
+ * @param[in] file The stream to write to.
+ * @return 0 on success, -1 on failure.
+ */
+int write_stringbuffer(const StringBuffer *stringBuffer, FILE *file);
+
+/**
+ * @brief Reads a StringBuffer written by write_stringbuffer.
+ *
+ * @param[in] file The stream to read from.
+ * @return The StringBuffer, or NULL if the data is truncated or too long.
+ * @post The returned StringBuffer must be deleted with delete_stringbuffer().
+ */
+ptrStringBuffer read_stringbuffer(FILE *file);
+
 /**
  * @brief Deletes a dynamically allocated StringBuffer.
  *
@@ -0,0 +1,216 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Synthetic Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "synthetic.h"
+#include "random.h"
+#include "stringbuffer.h"
+#include <math.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+// The stream of the candidates' positions, no ballot gets that index
+#define CANDIDATES_STREAM UINT64_MAX
+
+static const char *const models[NB_BALLOT_MODELS] = {
+    "ic", "mallows", "pl", "spatial1", "spatial2"};
+
+int parse_ballot_model(const char *name, enum BallotModel *kind) {
+    for (int k = 0; k < NB_BALLOT_MODELS; k++) {
+        if (strcmp(name, models[k]) == 0) {
+            *kind = k;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int init_election_model(ElectionModel *model, enum BallotModel kind,
+                        int nb_candidates, double parameter, uint64_t seed) {
+    static const double defaults[NB_BALLOT_MODELS] = {0, 0.5, 0.8, 0.25,
+                                                      0.25};
+    if (nb_candidates <= 0 || nb_candidates >= MAX_TAB)
+        return -1;
+    if (parameter < 0)
+        parameter = defaults[kind];
+    if ((kind == MODEL_MALLOWS || kind == MODEL_PL) &&
+        (parameter <= 0 || parameter > 1))
+        return -1;
+    model->kind = kind;
+    model->nb_candidates = nb_candidates;
+    model->parameter = parameter;
+    model->truncation = model->unranked = 0;
+    model->seed = seed;
+    RandomStream stream;
+    init_random_stream(&stream, seed, CANDIDATES_STREAM);
+    for (int c = 0; c < nb_candidates; c++)
+        for (int d = 0; d < 2; d++)
+            model->positions[c][d] = next_uniform(&stream);
+    return 0;
+}
+
+// Orders the candidates by decreasing key, there are few of them
+static void sort_by_key(int *order, const double *keys, int n) {
+    for (int i = 1; i < n; i++) {
+        int candidate = order[i], j = i;
+        for (; j > 0 && keys[order[j - 1]] < keys[candidate]; j--)
+            order[j] = order[j - 1];
+        order[j] = candidate;
+    }
+}
+
+// Repeated insertion: candidate i goes j places above the bottom of the
+// first i with a probability proportional to phi^j
+static void draw_mallows(RandomStream *stream, double phi, int *order,
+                         int n) {
+    for (int i = 0; i < n; i++) {
+        double total = 0, weight = 1;
+        for (int j = 0; j <= i; j++, weight *= phi)
+            total += weight;
+        double draw = next_uniform(stream) * total;
+        int j = 0;
+        for (weight = 1; j < i && draw >= weight; j++, weight *= phi)
+            draw -= weight;
+        memmove(&order[i - j + 1], &order[i - j], sizeof(int) * j);
+        order[i - j] = i;
+    }
+}
+
+void draw_ballot(const ElectionModel *model, uint64_t ballot, int *row) {
+    int n = model->nb_candidates, order[MAX_TAB];
+    double keys[MAX_TAB];
+    RandomStream stream;
+    init_random_stream(&stream, model->seed, ballot);
+    for (int c = 0; c < n; c++)
+        order[c] = c;
+
+    switch (model->kind) {
+    case MODEL_IC:
+        for (int c = n - 1; c > 0; c--) {
+            int other = next_below(&stream, c + 1), swap = order[c];
+            order[c] = order[other];
+            order[other] = swap;
+        }
+        break;
+    case MODEL_MALLOWS:
+        draw_mallows(&stream, model->parameter, order, n);
+        break;
+    case MODEL_PL:
+        // Gumbel noise on the log weights ranks as Plackett-Luce draws
+        for (int c = 0; c < n; c++)
+            keys[c] = c * log(model->parameter) -
+                      log(-log(1 - next_uniform(&stream)));
+        sort_by_key(order, keys, n);
+        break;
+    default: {
+        int dimensions = model->kind == MODEL_SPATIAL1 ? 1 : 2;
+        double voter[2];
+        for (int d = 0; d < dimensions; d++)
+            voter[d] = 0.5 + model->parameter * next_gaussian(&stream);
+        for (int c = 0; c < n; c++) {
+            keys[c] = 0;
+            for (int d = 0; d < dimensions; d++) {
+                double gap = voter[d] - model->positions[c][d];
+                keys[c] -= gap * gap;
+            }
+        }
+        sort_by_key(order, keys, n);
+        break;
+    }
+    }
+
+    int ranked = n;
+    if (n > 1 && next_uniform(&stream) < model->truncation)
+        ranked = 1 + next_below(&stream, n - 1);
+    for (int k = 0; k < n; k++)
+        row[order[k]] = k < ranked ? k + 1 : -1;
+    for (int c = 0; c < n && model->unranked > 0; c++)
+        if (next_uniform(&stream) < model->unranked)
+            row[c] = -1;
+}
+
+void write_synthetic_header(FILE *file, const ElectionModel *model,
+                            bool special) {
+    fprintf(file, special ? "Réponse,Soumis le :,Cours,Nom complet"
+                          : "ID votant, Date, Code vote, Hash");
+    for (int c = 1; c <= model->nb_candidates; c++) {
+        if (special)
+            fprintf(file, ",Q00_Vote->%d - Candidate %d", c, c);
+        else
+            fprintf(file, ", Candidate %d", c);
+    }
+    fprintf(file, "\n");
+}
+
+static char *append_text(char *out, const char *text) {
+    while (*text)
+        *out++ = *text++;
+    return out;
+}
+
+static char *append_integer(char *out, long long value) {
+    char digits[24];
+    int n = 0;
+    unsigned long long magnitude = value < 0 ? -(unsigned long long)value
+                                             : (unsigned long long)value;
+    do
+        digits[n++] = '0' + magnitude % 10;
+    while ((magnitude /= 10) != 0);
+    if (value < 0)
+        *out++ = '-';
+    while (n > 0)
+        *out++ = digits[--n];
+    return out;
+}
+
+char *format_synthetic_row(char *out, const ElectionModel *model,
+                           uint64_t ballot, const int *row, bool special) {
+    static const char hex[] = "0123456789abcdef";
+    // Seed and ballot swapped, a stream apart from the ranks
+    RandomStream stream;
+    init_random_stream(&stream, ballot, model->seed);
+    uint64_t hash = next_random(&stream);
+    out = append_integer(out, ballot + 1);
+    out = append_text(out, special
+                               ? ",18/10/2026 00:00:00,Generated,v"
+                               : ", Sun Oct 18 00:00:00 2026, generated, v");
+    for (int shift = 60; shift >= 0; shift -= 4)
+        *out++ = hex[(hash >> shift) & 15];
+    for (int c = 0; c < model->nb_candidates; c++) {
+        out = append_text(out, special ? "," : ", ");
+        out = append_integer(out, row[c]);
+    }
+    *out++ = '\n';
+    return out;
+}
+
+int set_synthetic_tags(ptrBallots ballots, int nb_candidates) {
+    char name[32];
+    for (int c = 0; c < nb_candidates; c++) {
+        snprintf(name, sizeof(name), "Candidate %d", c + 1);
+        ballots->columns = c + 1;
+        ballots->tags[c] = init_stringbuffer(name, strlen(name));
+        if (ballots->tags[c] == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+int generate_ballots(ptrBallots ballots, const ElectionModel *model,
+                     uint nb_ballots) {
+    int row[MAX_TAB];
+    clear_ballots(ballots);
+    if (set_synthetic_tags(ballots, model->nb_candidates) != 0)
+        return -1;
+    for (uint b = 0; b < nb_ballots; b++) {
+        draw_ballot(model, b, row);
+        if (add_ballot(ballots, row, model->nb_candidates) != 0)
+            return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Synthetic Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef SYNTHETIC_H
+#define SYNTHETIC_H
+
+#include "ballots.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Synthetic Synthetic Elections
+ * @{
+ *
+ * Ballots drawn from classic models of preferences. Ballot n only depends
+ * on the seed and on n, so an election can be drawn in any order and by
+ * any number of threads.
+ */
+
+/**
+ * @brief The models of preferences.
+ */
+enum BallotModel {
+    MODEL_IC,       /**< Impartial culture: uniform rankings */
+    MODEL_MALLOWS,  /**< Rankings close to 1, 2, ..., C */
+    MODEL_PL,       /**< Plackett-Luce, candidate c weighs ratio^c */
+    MODEL_SPATIAL1, /**< Voters and candidates on a line */
+    MODEL_SPATIAL2, /**< Voters and candidates on a plane */
+    NB_BALLOT_MODELS
+};
+
+/**
+ * @brief A model of preferences and its parameters.
+ */
+typedef struct s_election_model {
+    enum BallotModel kind;        /**< The model */
+    int nb_candidates;            /**< The number of candidates */
+    double parameter;             /**< Dispersion, ratio or spread */
+    double truncation;            /**< Share of ballots cut short */
+    double unranked;              /**< Share of ranks left at -1 */
+    double positions[MAX_TAB][2]; /**< Of the candidates, spatial models */
+    uint64_t seed;                /**< Of every ballot */
+} ElectionModel;
+
+/**
+ * @brief Size of a buffer holding any CSV row of an election.
+ */
+#define SYNTHETIC_ROW_SIZE(nb_candidates) (96 + 5 * (size_t)(nb_candidates))
+
+/**
+ * @brief Reads the name of a model: ic, mallows, pl, spatial1 or spatial2.
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parse_ballot_model(const char *name, enum BallotModel *kind);
+
+/**
+ * @brief Sets up a model with no truncation and no -1.
+ *
+ * The parameter is the dispersion of Mallows and the weight ratio of
+ * Plackett-Luce, both in (0, 1], or the standard deviation of the voters
+ * of the spatial models, which are around the middle of a unit square.
+ *
+ * @param[out] model The model.
+ * @param[in] kind The model of preferences.
+ * @param[in] nb_candidates The number of candidates, below MAX_TAB.
+ * @param[in] parameter The parameter, negative for the default one.
+ * @param[in] seed The seed.
+ * @return 0 on success, -1 if the parameter or the number of candidates
+ *         is out of range.
+ */
+int init_election_model(ElectionModel *model, enum BallotModel kind,
+                        int nb_candidates, double parameter, uint64_t seed);
+
+/**
+ * @brief Draws a ballot.
+ *
+ * @param[in] model The model.
+ * @param[in] ballot The index of the ballot.
+ * @param[out] row The rank of each candidate, -1 for unranked.
+ */
+void draw_ballot(const ElectionModel *model, uint64_t ballot, int *row);
+
+/**
+ * @brief Writes the CSV header of an election.
+ *
+ * @param[in] file The stream to write to.
+ * @param[in] model The model.
+ * @param[in] special True for Q00_Vote->N - Name columns, false for the
+ *                    bare names.
+ */
+void write_synthetic_header(FILE *file, const ElectionModel *model,
+                            bool special);
+
+/**
+ * @brief Formats the CSV row of a ballot.
+ *
+ * @param[out] out Where to write, with SYNTHETIC_ROW_SIZE bytes free.
+ * @param[in] model The model.
+ * @param[in] ballot The index of the ballot.
+ * @param[in] row Its ranks, from draw_ballot.
+ * @param[in] special As for write_synthetic_header.
+ * @return The end of the row, past its line feed. Nothing terminates it.
+ */
+char *format_synthetic_row(char *out, const ElectionModel *model,
+                           uint64_t ballot, const int *row, bool special);
+
+/**
+ * @brief Names the candidates of a ballot store Candidate 1, Candidate 2...
+ *
+ * @param[in,out] ballots An empty ballot store.
+ * @param[in] nb_candidates The number of candidates.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int set_synthetic_tags(ptrBallots ballots, int nb_candidates);
+
+/**
+ * @brief Fills a ballot store with the first ballots of a model.
+ *
+ * @param[in,out] ballots The ballot store, cleared first.
+ * @param[in] model The model.
+ * @param[in] nb_ballots The number of ballots.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int generate_ballots(ptrBallots ballots, const ElectionModel *model,
+                     uint nb_ballots);
+
+/** @} */ // End of Synthetic group
+
+#endif // SYNTHETIC_H
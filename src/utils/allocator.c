@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Pluggable Memory Allocation
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "allocator.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+static void *system_allocate(void *context, size_t size) {
+    return malloc(size);
+}
+
+static void *system_reallocate(void *context, void *pointer, size_t size) {
+    return realloc(pointer, size);
+}
+
+static void system_release(void *context, void *pointer) { free(pointer); }
+
+static const Allocator system_allocator = {system_allocate, system_reallocate,
+                                           system_release, NULL};
+
+// Each thread counts with its own allocator, so there is no shared state
+static _Thread_local const Allocator *current = &system_allocator;
+static _Thread_local enum MemorySubsystem subsystem = MEM_OTHER;
+
+const Allocator *set_thread_allocator(const Allocator *allocator) {
+    const Allocator *previous = current;
+    current = allocator ? allocator : &system_allocator;
+    return previous;
+}
+
+const Allocator *get_system_allocator(void) { return &system_allocator; }
+
+enum MemorySubsystem get_allocation_subsystem(void) { return subsystem; }
+
+void *mem_alloc_from(enum MemorySubsystem from, size_t size) {
+    subsystem = from;
+    return current->allocate(current->context, size);
+}
+
+void *mem_calloc_from(enum MemorySubsystem from, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+    subsystem = from;
+    void *pointer = current->allocate(current->context, count * size);
+    if (pointer != NULL)
+        memset(pointer, 0, count * size);
+    return pointer;
+}
+
+void *mem_realloc_from(enum MemorySubsystem from, void *pointer,
+                       size_t size) {
+    subsystem = from;
+    return current->reallocate(current->context, pointer, size);
+}
+
+void mem_free(void *pointer) {
+    if (pointer != NULL)
+        current->release(current->context, pointer);
+}
+
+char *mem_strdup_from(enum MemorySubsystem from, const char *string) {
+    size_t size = strlen(string) + 1;
+    subsystem = from;
+    char *copy = current->allocate(current->context, size);
+    if (copy != NULL)
+        memcpy(copy, string, size);
+    return copy;
+}
@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Pluggable Memory Allocation
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef ALLOCATOR_H
+#define ALLOCATOR_H
+
+#include <stddef.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Allocator Memory Allocation
+ * @{
+ */
+
+/**
+ * @brief A set of allocation functions and their context.
+ *
+ * reallocate and release receive pointers that came from the same allocator,
+ * release may receive NULL.
+ */
+typedef struct s_allocator {
+    void *(*allocate)(void *context, size_t size); /**< Like malloc */
+    void *(*reallocate)(void *context, void *pointer,
+                        size_t size);              /**< Like realloc */
+    void (*release)(void *context, void *pointer); /**< Like free */
+    void *context;                                 /**< Passed to each call */
+} Allocator;
+
+/**
+ * @brief The libraries memory is accounted to.
+ *
+ * Each library is compiled with MEM_SUBSYSTEM naming its own, the
+ * executables and the tests default to MEM_OTHER.
+ */
+enum MemorySubsystem {
+    MEM_OTHER,
+    MEM_UTILS,
+    MEM_STRUCTURES,
+    MEM_MODULES,
+    MEM_STORAGE,
+    MEM_SERVICES,
+    MEM_API,
+    NB_MEM_SUBSYSTEMS
+};
+
+#ifndef MEM_SUBSYSTEM
+#define MEM_SUBSYSTEM MEM_OTHER
+#endif
+
+/**
+ * @brief Makes an allocator serve every allocation of the calling thread.
+ *
+ * Every structure must be freed under the allocator that allocated it. The
+ * default allocator is malloc, realloc and free.
+ *
+ * @param[in] allocator The allocator, NULL for the default one. It must
+ *                      outlive its use.
+ * @return The allocator it replaces, to restore it afterwards.
+ */
+const Allocator *set_thread_allocator(const Allocator *allocator);
+
+/**
+ * @brief Gets the default allocator: malloc, realloc and free.
+ */
+const Allocator *get_system_allocator(void);
+
+/**
+ * @brief The subsystem of the allocation being served.
+ *
+ * Allocators that account memory read it from their allocate and
+ * reallocate functions.
+ */
+enum MemorySubsystem get_allocation_subsystem(void);
+
+/**
+ * @brief Allocates memory with the allocator of the calling thread.
+ */
+void *mem_alloc_from(enum MemorySubsystem subsystem, size_t size);
+#define mem_alloc(size) mem_alloc_from(MEM_SUBSYSTEM, size)
+
+/**
+ * @brief Allocates zeroed memory for an array with the allocator of the
+ * calling thread.
+ * @return The memory, or NULL if it fails or count * size overflows.
+ */
+void *mem_calloc_from(enum MemorySubsystem subsystem, size_t count,
+                      size_t size);
+#define mem_calloc(count, size) mem_calloc_from(MEM_SUBSYSTEM, count, size)
+
+/**
+ * @brief Resizes memory with the allocator of the calling thread.
+ */
+void *mem_realloc_from(enum MemorySubsystem subsystem, void *pointer,
+                       size_t size);
+#define mem_realloc(pointer, size)                                             \
+    mem_realloc_from(MEM_SUBSYSTEM, pointer, size)
+
+/**
+ * @brief Frees memory with the allocator of the calling thread.
+ */
+void mem_free(void *pointer);
+
+/**
+ * @brief Duplicates a string with the allocator of the calling thread.
+ */
+char *mem_strdup_from(enum MemorySubsystem subsystem, const char *string);
+#define mem_strdup(string) mem_strdup_from(MEM_SUBSYSTEM, string)
+
+/** @} */ // End of Allocator group
+
+#endif // ALLOCATOR_H
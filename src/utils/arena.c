@@ -0,0 +1,136 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for the Election Arena
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "arena.h"
+#include <stdalign.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-----------------------------------------------------------------*/
+
+// Every allocation is preceded by its size and aligned as malloc aligns
+#define ALIGNMENT alignof(max_align_t)
+#define HEADER_SIZE ALIGNMENT
+#define ROUND_UP(size) (((size) + ALIGNMENT - 1) & ~(ALIGNMENT - 1))
+#define BLOCK_HEADER ROUND_UP(sizeof(ArenaBlock))
+
+static unsigned char *block_bytes(ArenaBlock *block) {
+    return (unsigned char *)block + BLOCK_HEADER;
+}
+
+static size_t allocation_size(const void *pointer) {
+    return *(const size_t *)((const unsigned char *)pointer - HEADER_SIZE);
+}
+
+static ArenaBlock *add_block(ptrArena arena, size_t needed) {
+    size_t size = arena->blocks ? 2 * arena->blocks->size : 0;
+    if (size < needed)
+        size = needed;
+    ArenaBlock *block = malloc(BLOCK_HEADER + size);
+    if (block == NULL)
+        return NULL;
+    block->next = arena->blocks;
+    block->size = size;
+    block->used = 0;
+    arena->blocks = block;
+    return block;
+}
+
+static void *arena_allocate(void *context, size_t size) {
+    ptrArena arena = context;
+    if (size > SIZE_MAX / 2 - HEADER_SIZE - ALIGNMENT)
+        return NULL;
+    size_t needed = HEADER_SIZE + ROUND_UP(size);
+    ArenaBlock *block = arena->blocks;
+    if (block == NULL || block->size - block->used < needed) {
+        if ((block = add_block(arena, needed)) == NULL)
+            return NULL;
+    }
+    unsigned char *start = block_bytes(block) + block->used;
+    *(size_t *)start = size;
+    block->used += needed;
+    arena->allocated += needed;
+    arena->last = start + HEADER_SIZE;
+    return arena->last;
+}
+
+static void *arena_reallocate(void *context, void *pointer, size_t size) {
+    ptrArena arena = context;
+    if (pointer == NULL)
+        return arena_allocate(context, size);
+    size_t old_size = allocation_size(pointer);
+
+    // The latest allocation grows in place while its block has room
+    ArenaBlock *block = arena->blocks;
+    if (pointer == arena->last && size <= SIZE_MAX / 2) {
+        size_t start = (unsigned char *)pointer - block_bytes(block);
+        if (start + ROUND_UP(size) <= block->size) {
+            size_t used = start + ROUND_UP(size);
+            arena->allocated += used - block->used;
+            block->used = used;
+            *(size_t *)((unsigned char *)pointer - HEADER_SIZE) = size;
+            return pointer;
+        }
+    }
+    void *moved = arena_allocate(context, size);
+    if (moved != NULL)
+        memcpy(moved, pointer, old_size < size ? old_size : size);
+    return moved;
+}
+
+static void arena_release(void *context, void *pointer) {}
+
+ptrArena init_arena(size_t block_size) {
+    ptrArena arena = malloc(sizeof(Arena));
+    if (arena == NULL)
+        return NULL;
+    arena->blocks = NULL;
+    arena->last = NULL;
+    arena->allocated = 0;
+    arena->allocator.allocate = arena_allocate;
+    arena->allocator.reallocate = arena_reallocate;
+    arena->allocator.release = arena_release;
+    arena->allocator.context = arena;
+    if (add_block(arena, block_size ? block_size : ARENA_BLOCK_SIZE) == NULL) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+const Allocator *get_arena_allocator(ptrArena arena) {
+    return &arena->allocator;
+}
+
+void reset_arena(ptrArena arena) {
+    if (arena == NULL || arena->blocks == NULL)
+        return;
+    // Blocks double, so the current one is the largest
+    ArenaBlock *block = arena->blocks->next;
+    while (block != NULL) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks->next = NULL;
+    arena->blocks->used = 0;
+    arena->last = NULL;
+    arena->allocated = 0;
+}
+
+void delete_arena(ptrArena arena) {
+    if (arena == NULL)
+        return;
+    while (arena->blocks != NULL) {
+        ArenaBlock *next = arena->blocks->next;
+        free(arena->blocks);
+        arena->blocks = next;
+    }
+    free(arena);
+}
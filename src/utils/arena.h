@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for the Election Arena
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "allocator.h"
+#include <stddef.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Arena Election Arena
+ * @{
+ */
+
+/**
+ * @brief Default size of the first block of an arena.
+ */
+#define ARENA_BLOCK_SIZE (1u << 20)
+
+/**
+ * @brief A block of an arena, followed by its bytes.
+ */
+typedef struct s_arena_block {
+    struct s_arena_block *next; /**< The block filled before this one */
+    size_t size;                /**< The number of bytes of the block */
+    size_t used;                /**< The number of bytes handed out */
+} ArenaBlock;
+
+/**
+ * @brief A bump allocator: allocations take the next bytes of its current
+ * block, releasing them does nothing, and everything is freed at once.
+ */
+typedef struct s_arena {
+    ArenaBlock *blocks;  /**< The current block, then the full ones */
+    void *last;          /**< The latest allocation, resized in place */
+    size_t allocated;    /**< Bytes handed out since the last reset */
+    Allocator allocator; /**< Allocates from this arena */
+} Arena;
+
+/**
+ * @brief Typedef for a pointer to an Arena structure.
+ */
+typedef Arena *ptrArena;
+
+/**
+ * @brief Allocates an arena.
+ *
+ * @param[in] block_size The size of its first block, later ones doubling.
+ * @return The arena, or NULL if memory allocation fails.
+ *
+ * @post The returned Arena must be freed with delete_arena.
+ */
+ptrArena init_arena(size_t block_size);
+
+/**
+ * @brief Gives the allocator of an arena, to install with
+ * set_thread_allocator.
+ */
+const Allocator *get_arena_allocator(ptrArena arena);
+
+/**
+ * @brief Frees every allocation of an arena at once.
+ *
+ * Only its largest block is kept, so an arena reset between elections of
+ * the same size no longer calls malloc.
+ */
+void reset_arena(ptrArena arena);
+
+/**
+ * @brief Frees an arena and every allocation from it.
+ *
+ * @param[in] arena The arena to free, may be NULL.
+ */
+void delete_arena(ptrArena arena);
+
+/** @} */ // End of Arena group
+
+#endif // ARENA_H
@@ -12,6 +12,8 @@
 /*-----------------------------------------------------------------*/
 
 #include "miscellaneous.h"
+#include "allocator.h"
+#include "stats.h"
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -33,20 +35,24 @@ void generate_random_string(char *str, int length) {
 }
 
 int get_start_pos(FILE *file, int nb_candidates) {
-    char line[1024];
+    char *line = NULL;
+    size_t capacity = 0;
 
-    // Read the first line (header)
-    if (!fgets(line, sizeof(line), file)) {
+    // Read the first line (header), however many candidates it names
+    if (getline(&line, &capacity, file) == -1) {
+        free(line);
         return -1; // Error or empty file
     }
 
     // Count total number of columns
     int total_cols = 0;
-    char *token = strtok(line, ",");
+    char *save;
+    char *token = strtok_r(line, ",", &save);
     while (token != NULL) {
         total_cols++;
-        token = strtok(NULL, ",");
+        token = strtok_r(NULL, ",", &save);
     }
+    free(line);
 
     // The start position of the data is the total number of columns minus
     // nb_candidates
@@ -84,103 +90,198 @@ bool is_special_format(const char *token) {
     return strncmp(&token[i], " - ", 3) == 0;
 }
 
-void get_column_names(FILE *file, char ***columns_name, int *cols,
-                      int start_pos) {
-    char line[1024];
+char *extract_column_name(char *token) {
+    // Apply special format handling only if token matches specific pattern
+    if (is_special_format(token)) {
+        token = strstr(token, " - ") + 3; // Skip to the name part
+    }
+
+    // Trim leading and trailing spaces and newline characters
+    char *start = token;
+    while (*start == ' ' || *start == '\n' || *start == '\r')
+        start++;
+    char *end = start + strlen(start) - 1;
+    while (end > start && (*end == ' ' || *end == '\n' || *end == '\r'))
+        end--;
+    *(end + 1) = '\0';
+    return start;
+}
+
+/**
+ * @brief Whether a CSV field holds an integer, surrounding spaces aside.
+ */
+static bool is_integer_field(const char *field) {
+    char *end;
+    strtol(field, &end, 10);
+    if (end == field)
+        return false;
+    while (*end == ' ' || *end == '\n' || *end == '\r')
+        end++;
+    return *end == '\0';
+}
+
+int infer_candidate_count(const char *csvpath) {
+    FILE *file = fopen(csvpath, "r");
+    if (file == NULL)
+        return -1;
+    char *line = NULL;
+    size_t capacity = 0;
+    int count = 0;
+    char *save;
+
+    // Special format headers name the candidates
+    if (getline(&line, &capacity, file) != -1) {
+        for (char *token = strtok_r(line, ",", &save); token != NULL;
+             token = strtok_r(NULL, ",", &save))
+            count += is_special_format(token);
+    }
+
+    // Otherwise count the integers ending the first ballot
+    if (count == 0 && getline(&line, &capacity, file) != -1) {
+        for (char *token = strtok_r(line, ",", &save); token != NULL;
+             token = strtok_r(NULL, ",", &save))
+            count = is_integer_field(token) ? count + 1 : 0;
+    }
+    free(line);
+    fclose(file);
+    return count > 0 ? count : -1;
+}
+
+/**
+ * @brief Frees the first column names of an array, then the array.
+ */
+static void free_column_names(char **columns_name, int cols) {
+    for (int i = 0; i < cols; i++)
+        mem_free(columns_name[i]);
+    mem_free(columns_name);
+}
+
+int get_column_names(FILE *file, char ***columns_name, int *cols,
+                     int start_pos) {
+    char *line = NULL;
+    size_t capacity = 0;
+    *columns_name = NULL;
 
     // Read first line to get column names
-    if (fgets(line, sizeof(line), file)) {
-        // Count total number of columns
-        *cols = 0;
-        char *token = strtok(line, ",");
-        while (token != NULL) {
-            (*cols)++;
-            token = strtok(NULL, ",");
-        }
+    if (getline(&line, &capacity, file) == -1) {
+        free(line);
+        return -1;
+    }
 
-        *cols -= start_pos; // Actual number of data columns
+    // Count total number of columns
+    *cols = 0;
+    char *save;
+    char *token = strtok_r(line, ",", &save);
+    while (token != NULL) {
+        (*cols)++;
+        token = strtok_r(NULL, ",", &save);
+    }
 
-        // Allocate memory for columns_name array
-        *columns_name = calloc(*cols, sizeof(char *));
-        fseek(file, 0, SEEK_SET); // Reset file pointer to beginning
-        fgets(line, sizeof(line),
-              file); // Read first line again for column names
+    *cols -= start_pos; // Actual number of data columns
 
-        token = strtok(line, ",");
-        for (int i = 0; i < start_pos + *cols; ++i) {
-            if (i >= start_pos) {
-                // Apply special format handling only if token matches specific
-                // pattern
-                if (is_special_format(token)) {
-                    token = strstr(token, " - ") + 3; // Skip to the name part
-                }
-
-                // Trim leading and trailing spaces and newline characters
-                char *start = token;
-                while (*start == ' ' || *start == '\n')
-                    start++;
-                char *end = start + strlen(start) - 1;
-                while (end > start && (*end == ' ' || *end == '\n'))
-                    end--;
-                *(end + 1) = '\0';
-
-                (*columns_name)[i - start_pos] = strdup(start);
+    // Allocate memory for columns_name array
+    *columns_name = mem_calloc(*cols, sizeof(char *));
+    if (*columns_name == NULL) {
+        free(line);
+        return -1;
+    }
+    fseek(file, 0, SEEK_SET); // Reset file pointer to beginning
+    // Read first line again for column names
+    getline(&line, &capacity, file);
+
+    token = strtok_r(line, ",", &save);
+    for (int i = 0; i < start_pos + *cols; ++i) {
+        if (i >= start_pos) {
+            char *name = mem_strdup(extract_column_name(token));
+            if (name == NULL) {
+                free_column_names(*columns_name, i - start_pos);
+                *columns_name = NULL;
+                free(line);
+                return -1;
             }
-            token = strtok(NULL, ",");
+            (*columns_name)[i - start_pos] = name;
         }
+        token = strtok_r(NULL, ",", &save);
     }
+    free(line);
+    return 0;
 }
 
-void fetch_data(const char *csvpath, int nb_candidates, char ***columns_name,
-                int ***data, int *rows, int *cols) {
+int fetch_data(const char *csvpath, int nb_candidates, char ***columns_name,
+               int ***data, int *rows, int *cols) {
+    *columns_name = NULL;
+    *data = NULL;
+    *rows = *cols = 0;
     FILE *file = fopen(csvpath, "r");
-    if (file == NULL) {
-        perror("Error opening file");
-        return;
-    }
+    if (file == NULL)
+        return -1;
 
+    STATS_BEGIN(PHASE_HEADER);
     int start_pos = get_start_pos(file, nb_candidates);
-    if (start_pos == -1) {
-        printf("Error determining start position.\n");
+    if (start_pos < 0) {
+        STATS_END(PHASE_HEADER);
         fclose(file);
-        return;
+        return -1;
     }
 
-    get_column_names(file, columns_name, cols, start_pos);
+    int status = get_column_names(file, columns_name, cols, start_pos);
+    STATS_END(PHASE_HEADER);
+    if (status != 0) {
+        *cols = 0;
+        fclose(file);
+        return -1;
+    }
 
     // Count rows and allocate data
-    char line[1024];
-    *rows = 0;
-    while (fgets(line, sizeof(line), file)) {
+    STATS_BEGIN(PHASE_ROWS);
+    char *line = NULL, *save;
+    size_t capacity = 0;
+    ssize_t length;
+    while ((length = getline(&line, &capacity, file)) != -1) {
+        STATS_ADD(COUNTER_BYTES, length);
         // Check for non-empty line
-        if (strtok(line, ",\n") != NULL) {
+        if (strtok_r(line, ",\n", &save) != NULL) {
             (*rows)++;
         }
     }
 
-    // Allocate memory for data matrix
-    *data = calloc(*rows, sizeof(int *));
+    // Allocate the data matrix in one block, the row pointers first
+    *data = mem_calloc(1, *rows * (sizeof(int *) + *cols * sizeof(int)));
+    if (*data == NULL) {
+        STATS_END(PHASE_ROWS);
+        free(line);
+        free_column_names(*columns_name, *cols);
+        *columns_name = NULL;
+        *rows = *cols = 0;
+        fclose(file);
+        return -1;
+    }
     for (int i = 0; i < *rows; ++i) {
-        (*data)[i] = calloc(*cols, sizeof(int));
+        (*data)[i] = (int *)(*data + *rows) + i * *cols;
     }
 
     // Reset file pointer to start of data and read data
     fseek(file, 0, SEEK_SET);
-    fgets(line, sizeof(line), file); // Skip first line (header row)
+    getline(&line, &capacity, file); // Skip first line (header row)
 
     int row = 0;
-    while (fgets(line, sizeof(line), file) && row < *rows) {
-        char *token = strtok(line, ",");
+    while ((length = getline(&line, &capacity, file)) != -1 && row < *rows) {
+        STATS_ADD(COUNTER_BYTES, length);
+        char *token = strtok_r(line, ",", &save);
         for (int i = 0; i < start_pos + *cols; ++i) {
             if (i >= start_pos) {
                 (*data)[row][i - start_pos] = atoi(token);
             }
-            token = strtok(NULL, ",");
+            token = strtok_r(NULL, ",", &save);
         }
         row++;
     }
+    STATS_ADD(COUNTER_BALLOTS, row);
+    STATS_END(PHASE_ROWS);
 
+    free(line);
     fclose(file);
+    return 0;
 }
 
 int min_int(int *array, int size, int nb_candidates) {
@@ -239,7 +340,107 @@ enum Method str_to_enum(const char *method) {
         return CS;
     if (strcmp(method, "jm") == 0)
         return JM;
+    if (strcmp(method, "borda") == 0)
+        return BORDA;
+    if (strcmp(method, "dowdall") == 0)
+        return DOWDALL;
+    if (strcmp(method, "approval") == 0)
+        return APPROVAL;
+    if (strcmp(method, "scoring") == 0)
+        return SCORING;
+    if (strcmp(method, "bucklin") == 0)
+        return BUCKLIN;
+    if (strcmp(method, "median") == 0)
+        return MEDIAN;
+    if (strcmp(method, "baldwin") == 0)
+        return BALDWIN;
+    if (strcmp(method, "nanson") == 0)
+        return NANSON;
+    if (strcmp(method, "coombs") == 0)
+        return COOMBS;
+    if (strcmp(method, "smithirv") == 0)
+        return SMITH_IRV;
+    if (strcmp(method, "tideman") == 0)
+        return TIDEMAN;
+    if (strcmp(method, "woodall") == 0)
+        return WOODALL;
+    if (strcmp(method, "dhondt") == 0)
+        return DHONDT;
+    if (strcmp(method, "saintelague") == 0)
+        return SAINTE_LAGUE;
+    if (strcmp(method, "hare") == 0)
+        return HARE;
+    if (strcmp(method, "droop") == 0)
+        return DROOP;
     if (strcmp(method, "all") == 0)
         return ALL;
     return UNKNOWN;
 }
+
+const char *enum_to_str(enum Method method) {
+    switch (method) {
+    case UNI1:
+        return "uni1";
+    case UNI2:
+        return "uni2";
+    case CM:
+        return "cm";
+    case CP:
+        return "cp";
+    case CS:
+        return "cs";
+    case JM:
+        return "jm";
+    case BORDA:
+        return "borda";
+    case DOWDALL:
+        return "dowdall";
+    case APPROVAL:
+        return "approval";
+    case SCORING:
+        return "scoring";
+    case BUCKLIN:
+        return "bucklin";
+    case MEDIAN:
+        return "median";
+    case BALDWIN:
+        return "baldwin";
+    case NANSON:
+        return "nanson";
+    case COOMBS:
+        return "coombs";
+    case SMITH_IRV:
+        return "smithirv";
+    case TIDEMAN:
+        return "tideman";
+    case WOODALL:
+        return "woodall";
+    case DHONDT:
+        return "dhondt";
+    case SAINTE_LAGUE:
+        return "saintelague";
+    case HARE:
+        return "hare";
+    case DROOP:
+        return "droop";
+    case ALL:
+        return "all";
+    case UNKNOWN:
+        break;
+    }
+    return "unknown";
+}
+
+bool has_single_winner(enum Method method) {
+    switch (method) {
+    case DHONDT:
+    case SAINTE_LAGUE:
+    case HARE:
+    case DROOP:
+    case ALL:
+    case UNKNOWN:
+        return false;
+    default:
+        return true;
+    }
+}
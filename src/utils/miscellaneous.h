@@ -19,7 +19,32 @@ typedef struct {
     int score;
 } CandidateScore;
 
-enum Method { UNI1, UNI2, CM, CP, CS, JM, ALL, UNKNOWN };
+enum Method {
+    UNI1,
+    UNI2,
+    CM,
+    CP,
+    CS,
+    JM,
+    BORDA,
+    DOWDALL,
+    APPROVAL,
+    SCORING,
+    BUCKLIN,
+    MEDIAN,
+    BALDWIN,
+    NANSON,
+    COOMBS,
+    SMITH_IRV,
+    TIDEMAN,
+    WOODALL,
+    DHONDT,
+    SAINTE_LAGUE,
+    HARE,
+    DROOP,
+    ALL,
+    UNKNOWN
+};
 
 /*-----------------------------------------------------------------*/
 
@@ -158,6 +183,32 @@ int get_start_pos(FILE *file, int nb_candidates);
  */
 bool is_special_format(const char *token);
 
+/**
+ * @brief Extracts the candidate name from a single header token.
+ *
+ * Strips the "Q00_Vote-><number> - " prefix when the token follows the
+ * special format, then trims surrounding spaces and line endings.
+ *
+ * @param[in,out] token The header token, modified in place.
+ * @return A pointer inside token to the trimmed name.
+ *
+ * @pre token should not be NULL and should be a valid string.
+ */
+char *extract_column_name(char *token);
+
+/**
+ * @brief Infers the number of candidates of a CSV file from its first lines.
+ *
+ * When the header names candidates in the special format, they are counted.
+ * Otherwise the candidates are the integer fields ending the first ballot,
+ * the fields before them (voter, date, hash...) holding something else.
+ *
+ * @param[in] csvpath Path to the CSV file.
+ * @return The number of candidates, or -1 if the file cannot be read or
+ * holds no ballot.
+ */
+int infer_candidate_count(const char *csvpath);
+
 /**
  * @brief Extracts column names from the first line of a CSV file.
  *
@@ -175,6 +226,8 @@ bool is_special_format(const char *token);
  * @param[out] cols A pointer to store the number of columns.
  * @param[in] start_pos The position in the line from where to start considering
  *                      columns as valid.
+ * @return 0 on success, -1 if the header cannot be read or memory
+ *         allocation fails, nothing being left allocated.
  *
  * @pre
  *   - file should be a valid file pointer, opened in read mode.
@@ -185,8 +238,8 @@ bool is_special_format(const char *token);
  *     special formatting.
  *   - cols reflects the number of columns considered valid and extracted.
  */
-void get_column_names(FILE *file, char ***columns_name, int *cols,
-                      int start_pos);
+int get_column_names(FILE *file, char ***columns_name, int *cols,
+                     int start_pos);
 
 /**
  * @brief Fetches data from a CSV file and stores it in a matrix.
@@ -207,6 +260,9 @@ void get_column_names(FILE *file, char ***columns_name, int *cols,
  *                  stored.
  * @param[out] rows A pointer to store the number of rows in the data.
  * @param[out] cols A pointer to store the number of columns in the data.
+ * @return 0 on success, -1 if the file cannot be read, has fewer columns
+ * than candidates or memory allocation fails, in which case nothing is left
+ * allocated.
  *
  * @pre
  *   - csvpath should be a valid path to a readable CSV file.
@@ -215,11 +271,12 @@ void get_column_names(FILE *file, char ***columns_name, int *cols,
  *
  * @post
  *   - columns_name contains the names of the data columns.
- *   - data points to a 2D array containing the parsed CSV data.
+ *   - data points to a 2D array containing the parsed CSV data, allocated
+ *     as a single block: free data, not its rows.
  *   - rows and cols are set to the dimensions of the data matrix.
  */
-void fetch_data(const char *csvpath, int nb_candidates, char ***columns_name,
-                int ***data, int *rows, int *cols);
+int fetch_data(const char *csvpath, int nb_candidates, char ***columns_name,
+               int ***data, int *rows, int *cols);
 
 /** @} */ // End of CSV_Reader group
 
@@ -291,6 +348,17 @@ unsigned calculate_visual_length(const char *str);
 
 enum Method str_to_enum(const char *method);
 
+/**
+ * @brief Names a method as str_to_enum reads it, "unknown" for UNKNOWN.
+ */
+const char *enum_to_str(enum Method method);
+
+/**
+ * @brief Whether a method elects a single candidate, as the seat
+ * allocations and ALL do not.
+ */
+bool has_single_winner(enum Method method);
+
 /** @} */ // End of Miscellaneous group
 
 #endif // MISCELLANEOUS_H
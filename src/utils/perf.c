@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Hardware Performance Counters
+ **/
+/*-----------------------------------------------------------------*/
+
+// syscall is not part of POSIX
+#define _GNU_SOURCE
+
+#include "perf.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+/*-----------------------------------------------------------------*/
+
+const char *get_perf_event_name(enum PerfEvent event) {
+    static const char *const names[NB_PERF_EVENTS] = {
+        "cycles", "instructions", "L1D misses", "LLC misses",
+        "branch misses"};
+    return names[event];
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Sets the type and config of an event for perf_event_open.
+ */
+static void set_event_config(struct perf_event_attr *attr,
+                             enum PerfEvent event) {
+    static const uint64_t hardware[NB_PERF_EVENTS] = {
+        [PERF_CYCLES] = PERF_COUNT_HW_CPU_CYCLES,
+        [PERF_INSTRUCTIONS] = PERF_COUNT_HW_INSTRUCTIONS,
+        [PERF_LLC_MISSES] = PERF_COUNT_HW_CACHE_MISSES,
+        [PERF_BRANCH_MISSES] = PERF_COUNT_HW_BRANCH_MISSES};
+    if (event == PERF_L1D_MISSES) {
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_L1D |
+                  PERF_COUNT_HW_CACHE_OP_READ << 8 |
+                  PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+    } else {
+        attr->type = PERF_TYPE_HARDWARE;
+        attr->config = hardware[event];
+    }
+}
+
+int open_perf_counters(PerfCounters *perf) {
+    perf->leader = -1;
+    perf->nb_opened = 0;
+    int first_error = 0;
+    for (int e = 0; e < NB_PERF_EVENTS; e++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        set_event_config(&attr, e);
+        attr.read_format = PERF_FORMAT_GROUP |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.disabled = perf->leader < 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        perf->fds[e] = syscall(SYS_perf_event_open, &attr, 0, -1,
+                               perf->leader, 0);
+        perf->slots[e] = -1;
+        if (perf->fds[e] < 0) {
+            first_error = first_error ? first_error : errno;
+            continue;
+        }
+        if (perf->leader < 0)
+            perf->leader = perf->fds[e];
+        perf->slots[e] = perf->nb_opened++;
+    }
+    if (perf->leader < 0) {
+        errno = first_error;
+        return 0;
+    }
+    ioctl(perf->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return perf->nb_opened;
+}
+
+int read_perf_counters(const PerfCounters *perf,
+                       uint64_t values[NB_PERF_EVENTS]) {
+    memset(values, 0, sizeof(uint64_t) * NB_PERF_EVENTS);
+    if (perf->leader < 0)
+        return -1;
+    // The number of events, the times enabled and running, then the counts
+    uint64_t group[3 + NB_PERF_EVENTS];
+    ssize_t size = sizeof(uint64_t) * (3 + perf->nb_opened);
+    if (read(perf->leader, group, size) != size)
+        return -1;
+    double scale = group[2] > 0 && group[2] < group[1]
+                       ? (double)group[1] / group[2]
+                       : 1;
+    for (int e = 0; e < NB_PERF_EVENTS; e++) {
+        if (perf->slots[e] >= 0)
+            values[e] = group[3 + perf->slots[e]] * scale;
+    }
+    return 0;
+}
+
+void close_perf_counters(PerfCounters *perf) {
+    // Members first, the leader last
+    for (int e = NB_PERF_EVENTS - 1; e >= 0; e--) {
+        if (perf->fds[e] >= 0)
+            close(perf->fds[e]);
+        perf->fds[e] = -1;
+    }
+    perf->leader = -1;
+    perf->nb_opened = 0;
+}
+
+#else
+
+int open_perf_counters(PerfCounters *perf) {
+    for (int e = 0; e < NB_PERF_EVENTS; e++)
+        perf->fds[e] = perf->slots[e] = -1;
+    perf->leader = -1;
+    perf->nb_opened = 0;
+    errno = ENOSYS;
+    return 0;
+}
+
+int read_perf_counters(const PerfCounters *perf,
+                       uint64_t values[NB_PERF_EVENTS]) {
+    memset(values, 0, sizeof(uint64_t) * NB_PERF_EVENTS);
+    return -1;
+}
+
+void close_perf_counters(PerfCounters *perf) {}
+
+#endif
@@ -0,0 +1,83 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Hardware Performance Counters
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Perf Hardware Performance Counters
+ * @{
+ *
+ * The counters of the calling thread, in user space, opened as one
+ * perf_event_open group so that they are read together. Events the
+ * processor or the kernel does not provide are left out; on other systems
+ * than Linux none is.
+ */
+
+/**
+ * @brief The hardware events counted.
+ */
+enum PerfEvent {
+    PERF_CYCLES,        /**< CPU cycles */
+    PERF_INSTRUCTIONS,  /**< Instructions retired */
+    PERF_L1D_MISSES,    /**< Level 1 data cache read misses */
+    PERF_LLC_MISSES,    /**< Last level cache misses */
+    PERF_BRANCH_MISSES, /**< Mispredicted branches */
+    NB_PERF_EVENTS
+};
+
+/**
+ * @brief A group of counters.
+ */
+typedef struct s_perf_counters {
+    int fds[NB_PERF_EVENTS];   /**< The counter of each event, -1 if none */
+    int slots[NB_PERF_EVENTS]; /**< Its place in a group read */
+    int leader;                /**< The first counter opened, -1 if none */
+    int nb_opened;             /**< The number of counters opened */
+} PerfCounters;
+
+/**
+ * @brief The name of an event, for reports.
+ */
+const char *get_perf_event_name(enum PerfEvent event);
+
+/**
+ * @brief Opens and starts the counters of the calling thread.
+ *
+ * @param[out] perf The counters.
+ * @return The number of events counted, 0 when none is available, errno
+ * telling why the first one could not be opened.
+ *
+ * @post The counters must be closed with close_perf_counters.
+ */
+int open_perf_counters(PerfCounters *perf);
+
+/**
+ * @brief Reads every counter at once.
+ *
+ * Values are scaled up when the kernel had to multiplex the group.
+ *
+ * @param[in] perf The counters.
+ * @param[out] values The count of each event, 0 for those not counted.
+ * @return 0 on success, -1 if the group cannot be read.
+ */
+int read_perf_counters(const PerfCounters *perf,
+                       uint64_t values[NB_PERF_EVENTS]);
+
+/**
+ * @brief Closes the counters.
+ */
+void close_perf_counters(PerfCounters *perf);
+
+/** @} */ // End of Perf group
+
+#endif // PERF_H
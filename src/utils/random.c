@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Reproducible Random Streams
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "random.h"
+#include <math.h>
+
+/*-----------------------------------------------------------------*/
+
+// The increment and finalizer of SplitMix64
+#define GOLDEN_GAMMA 0x9e3779b97f4a7c15u
+
+#define TWO_PI 6.283185307179586
+
+static uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9u;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebu;
+    return value ^ (value >> 31);
+}
+
+void init_random_stream(RandomStream *stream, uint64_t seed, uint64_t index) {
+    // Mixing twice keeps neighbouring seeds and indices apart
+    stream->key = mix(mix(seed) ^ (index * GOLDEN_GAMMA + GOLDEN_GAMMA));
+    stream->counter = 0;
+}
+
+uint64_t next_random(RandomStream *stream) {
+    return mix(stream->key + ++stream->counter * GOLDEN_GAMMA);
+}
+
+double next_uniform(RandomStream *stream) {
+    // The 53 high bits fill the mantissa
+    return (next_random(stream) >> 11) * 0x1.0p-53;
+}
+
+uint32_t next_below(RandomStream *stream, uint32_t bound) {
+    // Lemire's multiply and reject
+    uint64_t product = (next_random(stream) >> 32) * bound;
+    if ((uint32_t)product < bound) {
+        uint32_t threshold = -bound % bound;
+        while ((uint32_t)product < threshold)
+            product = (next_random(stream) >> 32) * bound;
+    }
+    return product >> 32;
+}
+
+double next_gaussian(RandomStream *stream) {
+    // Box-Muller, 1 - u keeps the logarithm finite
+    double u = 1 - next_uniform(stream), v = next_uniform(stream);
+    return sqrt(-2 * log(u)) * cos(TWO_PI * v);
+}
+
+// log(k!), from Stirling's series past the table
+static double log_factorial(double k) {
+    static const double table[10] = {
+        0,
+        0,
+        0.69314718055994531,
+        1.79175946922805500,
+        3.17805383034794562,
+        4.78749174278204599,
+        6.57925121201010101,
+        8.52516136106541430,
+        10.60460290274525023,
+        12.80182748008146961};
+    if (k < 10)
+        return table[(int)k];
+    double x = k + 1;
+    return (x - 0.5) * log(x) - x + 0.5 * log(TWO_PI) + 1 / (12 * x) -
+           1 / (360 * x * x * x);
+}
+
+uint32_t next_binomial(RandomStream *stream, uint32_t trials, double p) {
+    if (trials == 0 || p <= 0)
+        return 0;
+    if (p >= 1)
+        return trials;
+    // Both methods want p <= 1/2, the failures of 1 - p are the successes
+    if (p > 0.5)
+        return trials - next_binomial(stream, trials, 1 - p);
+    double n = trials, q = 1 - p;
+    if (n * p < 10) {
+        // Inversion, walking up the probabilities of 0, 1, 2... successes
+        double s = p / q, a = (n + 1) * s, r = pow(q, n);
+        double u = next_uniform(stream);
+        uint32_t k = 0;
+        while (u > r && k < trials) {
+            u -= r;
+            k++;
+            r *= a / k - s;
+        }
+        return k;
+    }
+
+    // BTRS, Hormann 1993: a squeeze accepts most draws without a logarithm
+    double spq = sqrt(n * p * q);
+    double b = 1.15 + 2.53 * spq, a = -0.0873 + 0.0248 * b + 0.01 * p;
+    double c = n * p + 0.5, vr = 0.92 - 4.2 / b;
+    double alpha = (2.83 + 5.1 / b) * spq, lpq = log(p / q);
+    double m = floor((n + 1) * p);
+    double h = log_factorial(m) + log_factorial(n - m);
+    while (1) {
+        double u = next_uniform(stream) - 0.5, v = next_uniform(stream);
+        double us = 0.5 - fabs(u);
+        double k = floor((2 * a / us + b) * u + c);
+        if (k < 0 || k > n)
+            continue;
+        if (us >= 0.07 && v <= vr)
+            return k;
+        v = log(v * alpha / (a / (us * us) + b));
+        if (v <= h - log_factorial(k) - log_factorial(n - k) + (k - m) * lpq)
+            return k;
+    }
+}
@@ -0,0 +1,80 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Reproducible Random Streams
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Random Reproducible Random Streams
+ * @{
+ *
+ * Counter-based generator: the n-th number of a stream is a hash of its key
+ * and of n, so any stream is reached directly from a seed and an index
+ * (a ballot, a resample...) without drawing the ones before it. Results do
+ * not depend on how the work is split between threads.
+ */
+
+/**
+ * @brief A stream of random numbers.
+ */
+typedef struct s_random_stream {
+    uint64_t key;     /**< Derived from the seed and the stream index */
+    uint64_t counter; /**< Numbers drawn so far */
+} RandomStream;
+
+/**
+ * @brief Starts a stream.
+ *
+ * @param[out] stream The stream.
+ * @param[in] seed The seed shared by every stream of a run.
+ * @param[in] index Which stream of the run.
+ */
+void init_random_stream(RandomStream *stream, uint64_t seed, uint64_t index);
+
+/**
+ * @brief Draws 64 random bits.
+ */
+uint64_t next_random(RandomStream *stream);
+
+/**
+ * @brief Draws a double uniformly in [0, 1).
+ */
+double next_uniform(RandomStream *stream);
+
+/**
+ * @brief Draws an integer uniformly in [0, bound), without modulo bias.
+ *
+ * @pre bound > 0.
+ */
+uint32_t next_below(RandomStream *stream, uint32_t bound);
+
+/**
+ * @brief Draws from the standard normal distribution.
+ */
+double next_gaussian(RandomStream *stream);
+
+/**
+ * @brief Draws the number of successes of independent trials.
+ *
+ * Exact: inversion when few successes are expected, Hormann's transformed
+ * rejection (BTRS) otherwise, in constant expected time.
+ *
+ * @param[in,out] stream The stream.
+ * @param[in] trials The number of trials.
+ * @param[in] p The probability of success of each trial.
+ * @return A draw from Binomial(trials, p).
+ */
+uint32_t next_binomial(RandomStream *stream, uint32_t trials, double p);
+
+/** @} */ // End of Random group
+
+#endif // RANDOM_H
@@ -0,0 +1,189 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Pipeline Statistics
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "stats.h"
+#include "trace.h"
+#include <string.h>
+#include <time.h>
+
+/*-----------------------------------------------------------------*/
+
+// Batch workers and server clients parse on their own threads
+static _Thread_local ptrStats current = NULL;
+
+static const char *const phases[NB_PHASES] = {
+    "header", "rows", "tallies", "pairwise", "method", "output"};
+
+uint64_t monotonic_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+}
+
+void reset_stats(ptrStats stats) {
+    for (int p = 0; p < NB_PHASES; p++)
+        stats->elapsed[p] = 0;
+    for (int c = 0; c < NB_COUNTERS; c++)
+        stats->counters[c] = 0;
+    memset(stats->events, 0, sizeof(stats->events));
+    stats->perf = NULL;
+    stats->depth = 0;
+    stats->since = stats->started = monotonic_ns();
+}
+
+void attach_perf_counters(ptrStats stats, const PerfCounters *perf) {
+    stats->perf = perf;
+    read_perf_counters(perf, stats->last_events);
+}
+
+/**
+ * @brief Charges the time and events since the last change of phase to the
+ * phase being timed.
+ */
+static void charge_phase(void) {
+    uint64_t now = monotonic_ns();
+    int phase = current->depth > 0 ? current->stack[current->depth - 1] : -1;
+    if (phase >= 0)
+        current->elapsed[phase] += now - current->since;
+    current->since = now;
+    uint64_t events[NB_PERF_EVENTS];
+    if (current->perf == NULL ||
+        read_perf_counters(current->perf, events) != 0)
+        return;
+    for (int e = 0; e < NB_PERF_EVENTS && phase >= 0; e++)
+        current->events[phase][e] += events[e] - current->last_events[e];
+    memcpy(current->last_events, events, sizeof(events));
+}
+
+ptrStats set_thread_stats(ptrStats stats) {
+    ptrStats previous = current;
+    current = stats;
+    return previous;
+}
+
+void begin_phase(enum Phase phase) {
+    begin_trace_span(phases[phase], NULL);
+    if (current == NULL)
+        return;
+    charge_phase();
+    // Deeper phases are merged into the deepest one kept
+    if (current->depth < STATS_MAX_DEPTH)
+        current->stack[current->depth++] = phase;
+}
+
+void end_phase(enum Phase phase) {
+    end_trace_span();
+    if (current == NULL || current->depth == 0)
+        return;
+    charge_phase();
+    if (current->stack[current->depth - 1] == (int)phase)
+        current->depth--;
+}
+
+void add_to_counter(enum Counter counter, uint64_t value) {
+    if (current != NULL)
+        current->counters[counter] += value;
+}
+
+void emit_stats(ptrWriter writer, const Stats *stats) {
+    double total = (monotonic_ns() - stats->started) / 1e6;
+    static const char *const timing[] = {"Phase", "Milliseconds",
+                                         "Share (%)"};
+    begin_table(writer, timing, 3, 3);
+    double other = total;
+    for (int p = 0; p < NB_PHASES; p++) {
+        double milliseconds = stats->elapsed[p] / 1e6;
+        double values[2] = {milliseconds,
+                            total > 0 ? 100 * milliseconds / total : 0};
+        write_table_row(writer, phases[p], values);
+        other -= milliseconds;
+    }
+    // Opening files, the cache and whatever no phase covers
+    double values[2] = {other, total > 0 ? 100 * other / total : 0};
+    write_table_row(writer, "other", values);
+    values[0] = total;
+    values[1] = 100;
+    write_table_row(writer, "total", values);
+    end_table(writer);
+
+    // Rates are over the time spent reading the ballots
+    double parsing = (stats->elapsed[PHASE_HEADER] +
+                      stats->elapsed[PHASE_ROWS]) / 1e9;
+    static const char *const counting[] = {"Counter", "Value"};
+    begin_table(writer, counting, 2, 0);
+    static const char *const counters[NB_COUNTERS] = {"bytes read", "ballots",
+                                                      "rejected rows"};
+    for (int c = 0; c < NB_COUNTERS; c++) {
+        double value = stats->counters[c];
+        write_table_row(writer, counters[c], &value);
+    }
+    double rate = parsing > 0 ? stats->counters[COUNTER_BALLOTS] / parsing : 0;
+    write_table_row(writer, "ballots per second", &rate);
+    rate = parsing > 0 ? stats->counters[COUNTER_BYTES] / parsing : 0;
+    write_table_row(writer, "bytes per second", &rate);
+    end_table(writer);
+}
+
+void emit_perf_stats(ptrWriter writer, const Stats *stats) {
+    // Only the events counted get a column
+    enum PerfEvent counted[NB_PERF_EVENTS];
+    const char *headers[1 + NB_PERF_EVENTS] = {"Phase"};
+    int nb_counted = 0;
+    for (int e = 0; e < NB_PERF_EVENTS; e++) {
+        if (stats->perf != NULL && stats->perf->slots[e] >= 0) {
+            counted[nb_counted] = e;
+            headers[++nb_counted] = get_perf_event_name(e);
+        }
+    }
+    if (nb_counted == 0)
+        return;
+    begin_table(writer, headers, 1 + nb_counted, 0);
+    for (int p = 0; p < NB_PHASES; p++) {
+        double values[NB_PERF_EVENTS];
+        for (int k = 0; k < nb_counted; k++)
+            values[k] = stats->events[p][counted[k]];
+        write_table_row(writer, phases[p], values);
+    }
+    end_table(writer);
+
+    // The cost of each ballot, and how well the processor kept busy when
+    // both of its events were counted
+    const char *ratios[1 + NB_PERF_EVENTS] = {"Phase"};
+    static const char *const per_ballot[NB_PERF_EVENTS] = {
+        [PERF_L1D_MISSES] = "L1D/ballot", [PERF_LLC_MISSES] = "LLC/ballot",
+        [PERF_BRANCH_MISSES] = "branch/ballot"};
+    bool ipc = stats->perf->slots[PERF_CYCLES] >= 0 &&
+               stats->perf->slots[PERF_INSTRUCTIONS] >= 0;
+    int nb_ratios = 0;
+    if (ipc)
+        ratios[++nb_ratios] = "IPC";
+    for (int e = PERF_L1D_MISSES; e < NB_PERF_EVENTS; e++) {
+        if (stats->perf->slots[e] >= 0)
+            ratios[++nb_ratios] = per_ballot[e];
+    }
+    if (nb_ratios == 0)
+        return;
+    double ballots = stats->counters[COUNTER_BALLOTS];
+    begin_table(writer, ratios, 1 + nb_ratios, 3);
+    for (int p = 0; p < NB_PHASES; p++) {
+        const uint64_t *events = stats->events[p];
+        double values[NB_PERF_EVENTS];
+        int k = 0;
+        if (ipc)
+            values[k++] = events[PERF_CYCLES] > 0
+                              ? (double)events[PERF_INSTRUCTIONS] /
+                                    events[PERF_CYCLES]
+                              : 0;
+        for (int e = PERF_L1D_MISSES; e < NB_PERF_EVENTS; e++) {
+            if (stats->perf->slots[e] >= 0)
+                values[k++] = ballots > 0 ? events[e] / ballots : 0;
+        }
+        write_table_row(writer, phases[p], values);
+    }
+    end_table(writer);
+}
@@ -0,0 +1,158 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Pipeline Statistics
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef STATS_H
+#define STATS_H
+
+#include "perf.h"
+#include "writer.h"
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Stats Pipeline Statistics
+ * @{
+ *
+ * The pipeline is instrumented with the STATS_* macros. They record into
+ * the Stats of the calling thread, if any, and expand to nothing unless
+ * VOTING_STATS is defined, which the VOTING_STATS CMake option does.
+ */
+
+/**
+ * @brief The phases of the pipeline.
+ */
+enum Phase {
+    PHASE_HEADER,   /**< Reading the header of a ballot file */
+    PHASE_ROWS,     /**< Parsing the rows into the ballot store */
+    PHASE_TALLIES,  /**< Building the first choices and the histogram */
+    PHASE_PAIRWISE, /**< Building the duel matrix */
+    PHASE_METHOD,   /**< Counting with the method */
+    PHASE_OUTPUT,   /**< Formatting and writing the results */
+    NB_PHASES
+};
+
+/**
+ * @brief The counters of the pipeline.
+ */
+enum Counter {
+    COUNTER_BYTES,    /**< Bytes read from ballot files */
+    COUNTER_BALLOTS,  /**< Ballots parsed */
+    COUNTER_REJECTED, /**< Rows rejected while parsing */
+    NB_COUNTERS
+};
+
+/**
+ * @brief Maximum nesting of phases.
+ */
+#define STATS_MAX_DEPTH 8
+
+/**
+ * @brief Time spent in each phase, counters, and optionally the hardware
+ * events of each phase.
+ *
+ * A phase started within another one pauses it, so each phase only counts
+ * its own time and events.
+ */
+typedef struct s_stats {
+    uint64_t elapsed[NB_PHASES];                /**< Nanoseconds per phase */
+    uint64_t counters[NB_COUNTERS];             /**< The counters */
+    int stack[STATS_MAX_DEPTH];                 /**< The phases being timed */
+    int depth;                                  /**< The number of them */
+    uint64_t since;                             /**< When the last resumed */
+    uint64_t started;                           /**< When reset */
+    const PerfCounters *perf;                   /**< NULL for no events */
+    uint64_t events[NB_PHASES][NB_PERF_EVENTS]; /**< Events per phase */
+    uint64_t last_events[NB_PERF_EVENTS];       /**< Events when resumed */
+} Stats;
+
+/**
+ * @brief Typedef for a pointer to a Stats structure.
+ */
+typedef Stats *ptrStats;
+
+#ifdef VOTING_STATS
+#define STATS_ENABLED 1
+#define STATS_BEGIN(phase) begin_phase(phase)
+#define STATS_END(phase) end_phase(phase)
+#define STATS_ADD(counter, value) add_to_counter(counter, value)
+#else
+#define STATS_ENABLED 0
+#define STATS_BEGIN(phase) ((void)0)
+#define STATS_END(phase) ((void)0)
+#define STATS_ADD(counter, value) ((void)0)
+#endif
+
+/**
+ * @brief Reads the monotonic clock.
+ *
+ * @return Nanoseconds from an arbitrary origin.
+ */
+uint64_t monotonic_ns(void);
+
+/**
+ * @brief Zeroes statistics and starts their clock.
+ */
+void reset_stats(ptrStats stats);
+
+/**
+ * @brief Makes statistics read hardware counters at each change of phase.
+ *
+ * @param[in,out] stats The statistics.
+ * @param[in] perf The open counters, which must outlive their use.
+ */
+void attach_perf_counters(ptrStats stats, const PerfCounters *perf);
+
+/**
+ * @brief Makes statistics record the phases of the calling thread.
+ *
+ * @param[in] stats The statistics, NULL to stop recording.
+ * @return The statistics it replaces.
+ */
+ptrStats set_thread_stats(ptrStats stats);
+
+/**
+ * @brief Starts timing a phase, pausing the current one.
+ *
+ * The phase is also a span of the trace of the calling thread, if any.
+ */
+void begin_phase(enum Phase phase);
+
+/**
+ * @brief Stops timing a phase, resuming the one it paused.
+ */
+void end_phase(enum Phase phase);
+
+/**
+ * @brief Adds to a counter.
+ */
+void add_to_counter(enum Counter counter, uint64_t value);
+
+/**
+ * @brief Writes a table of the phases and one of the counters and rates.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] stats The statistics.
+ */
+void emit_stats(ptrWriter writer, const Stats *stats);
+
+/**
+ * @brief Writes a table of the hardware events of each phase and one of
+ * the instructions per cycle and of the misses per ballot.
+ *
+ * Events that were not counted have no column, nor has the IPC unless
+ * both cycles and instructions were counted.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] stats The statistics, with counters attached.
+ */
+void emit_perf_stats(ptrWriter writer, const Stats *stats);
+
+/** @} */ // End of Stats group
+
+#endif // STATS_H
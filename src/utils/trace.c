@@ -0,0 +1,123 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Trace Events
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "trace.h"
+#include "stats.h"
+#include "writer.h"
+#include <stdlib.h>
+
+/*-----------------------------------------------------------------*/
+
+static _Thread_local TraceBuffer *current = NULL;
+
+void init_trace(ptrTrace trace) {
+    atomic_init(&trace->nb_buffers, 0);
+    trace->origin = monotonic_ns();
+}
+
+int attach_trace_thread(ptrTrace trace, const char *name) {
+    int slot = atomic_fetch_add(&trace->nb_buffers, 1);
+    if (slot >= TRACE_MAX_THREADS)
+        return -1;
+    // Buffers outlive their threads, and with them their allocators
+    TraceBuffer *buffer = malloc(sizeof(TraceBuffer));
+    trace->buffers[slot] = buffer;
+    if (buffer == NULL)
+        return -1;
+    buffer->written = 0;
+    buffer->depth = 0;
+    buffer->name = name;
+    current = buffer;
+    return 0;
+}
+
+void detach_trace_thread(void) { current = NULL; }
+
+void begin_trace_span(const char *name, const char *detail) {
+    if (current == NULL)
+        return;
+    if (current->depth < TRACE_MAX_DEPTH) {
+        TraceEvent *span = &current->open[current->depth];
+        span->name = name;
+        span->detail = detail;
+        span->start = monotonic_ns();
+    }
+    current->depth++;
+}
+
+void end_trace_span(void) {
+    if (current == NULL || current->depth == 0)
+        return;
+    if (--current->depth >= TRACE_MAX_DEPTH)
+        return;
+    TraceEvent *event =
+        &current->events[current->written++ % TRACE_BUFFER_EVENTS];
+    *event = current->open[current->depth];
+    event->duration = monotonic_ns() - event->start;
+}
+
+static void write_microseconds(ptrWriter writer, uint64_t nanoseconds) {
+    write_decimal(writer, nanoseconds / 1e3, 3);
+}
+
+static void write_event(ptrWriter writer, const TraceEvent *event,
+                        uint64_t origin, int thread) {
+    write_text(writer, ",\n{\"name\":");
+    write_json_string(writer, event->name);
+    write_text(writer, ",\"cat\":\"pipeline\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+    write_integer(writer, thread);
+    write_text(writer, ",\"ts\":");
+    write_microseconds(writer, event->start - origin);
+    write_text(writer, ",\"dur\":");
+    write_microseconds(writer, event->duration);
+    if (event->detail != NULL) {
+        write_text(writer, ",\"args\":{\"detail\":");
+        write_json_string(writer, event->detail);
+        write_text(writer, "}");
+    }
+    write_text(writer, "}");
+}
+
+int write_trace(const Trace *trace, const char *path) {
+    ptrWriter writer = open_writer(path, FORMAT_TEXT);
+    if (writer == NULL)
+        return -1;
+    write_text(writer, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                       "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+                       "\"args\":{\"name\":\"voting\"}}");
+    int nb_buffers = atomic_load(&trace->nb_buffers);
+    if (nb_buffers > TRACE_MAX_THREADS)
+        nb_buffers = TRACE_MAX_THREADS;
+    for (int t = 0; t < nb_buffers; t++) {
+        const TraceBuffer *buffer = trace->buffers[t];
+        if (buffer == NULL)
+            continue;
+        write_text(writer, ",\n{\"name\":\"thread_name\",\"ph\":\"M\","
+                           "\"pid\":1,\"tid\":");
+        write_integer(writer, t + 1);
+        write_text(writer, ",\"args\":{\"name\":");
+        write_json_string(writer, buffer->name);
+        write_text(writer, "}}");
+        // Once the ring is full, the oldest event is the next overwritten
+        uint64_t first = buffer->written > TRACE_BUFFER_EVENTS
+                             ? buffer->written - TRACE_BUFFER_EVENTS
+                             : 0;
+        for (uint64_t e = first; e < buffer->written; e++)
+            write_event(writer, &buffer->events[e % TRACE_BUFFER_EVENTS],
+                        trace->origin, t + 1);
+    }
+    write_text(writer, "\n]}\n");
+    return close_writer(writer);
+}
+
+void clear_trace(ptrTrace trace) {
+    int nb_buffers = atomic_load(&trace->nb_buffers);
+    for (int t = 0; t < nb_buffers && t < TRACE_MAX_THREADS; t++)
+        free(trace->buffers[t]);
+    atomic_store(&trace->nb_buffers, 0);
+}
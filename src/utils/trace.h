@@ -0,0 +1,141 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Trace Events
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Trace Trace Events
+ * @{
+ *
+ * Spans of time recorded per thread and written in the trace event format
+ * of chrome://tracing and Perfetto. Every phase of the STATS_* macros is a
+ * span, and the TRACE_* macros add others. Like them, they expand to
+ * nothing unless VOTING_STATS is defined.
+ */
+
+/**
+ * @brief Events kept per thread, the oldest being overwritten past it.
+ */
+#define TRACE_BUFFER_EVENTS 16384
+
+/**
+ * @brief Maximum number of threads traced.
+ */
+#define TRACE_MAX_THREADS 256
+
+/**
+ * @brief Maximum nesting of spans, deeper ones are not recorded.
+ */
+#define TRACE_MAX_DEPTH 8
+
+/**
+ * @brief A span, recorded when it ends.
+ */
+typedef struct s_trace_event {
+    const char *name;   /**< What was done */
+    const char *detail; /**< On what, NULL for nothing */
+    uint64_t start;     /**< Monotonic nanoseconds */
+    uint64_t duration;  /**< Nanoseconds */
+} TraceEvent;
+
+/**
+ * @brief The ring of events of one thread.
+ *
+ * Only its thread writes to it, so recording takes no lock.
+ */
+typedef struct s_trace_buffer {
+    TraceEvent events[TRACE_BUFFER_EVENTS]; /**< The ring */
+    uint64_t written;                       /**< Events ever recorded */
+    TraceEvent open[TRACE_MAX_DEPTH];       /**< Spans not ended yet */
+    int depth;                              /**< Spans begun, not ended */
+    const char *name;                       /**< Of the thread */
+} TraceBuffer;
+
+/**
+ * @brief The buffers of every thread traced.
+ *
+ * Threads claim their buffer with an atomic increment, and the trace is
+ * written once they have been joined.
+ */
+typedef struct s_trace {
+    TraceBuffer *buffers[TRACE_MAX_THREADS]; /**< In the order claimed */
+    atomic_int nb_buffers;                   /**< Claimed, may pass the max */
+    uint64_t origin;                         /**< Time zero of the trace */
+} Trace;
+
+/**
+ * @brief Typedef for a pointer to a Trace structure.
+ */
+typedef Trace *ptrTrace;
+
+#ifdef VOTING_STATS
+#define TRACE_BEGIN(name, detail) begin_trace_span(name, detail)
+#define TRACE_END() end_trace_span()
+#else
+#define TRACE_BEGIN(name, detail) ((void)0)
+#define TRACE_END() ((void)0)
+#endif
+
+/**
+ * @brief Sets up a trace with no thread, starting now.
+ */
+void init_trace(ptrTrace trace);
+
+/**
+ * @brief Makes the calling thread record its spans into the trace.
+ *
+ * @param[in,out] trace The trace, which must outlive the recording.
+ * @param[in] name The name of the thread in the trace.
+ * @return 0 on success, -1 if there are too many threads or the buffer
+ *         cannot be allocated, the thread recording nothing.
+ */
+int attach_trace_thread(ptrTrace trace, const char *name);
+
+/**
+ * @brief Stops recording the spans of the calling thread. Its events stay
+ * in the trace.
+ */
+void detach_trace_thread(void);
+
+/**
+ * @brief Begins a span on the calling thread, if it is traced.
+ *
+ * @param[in] name What is done, which must outlive the trace.
+ * @param[in] detail On what, NULL for nothing, which must also outlive
+ *                   the trace.
+ */
+void begin_trace_span(const char *name, const char *detail);
+
+/**
+ * @brief Ends the latest span begun on the calling thread.
+ */
+void end_trace_span(void);
+
+/**
+ * @brief Writes the events of every thread as a JSON trace.
+ *
+ * @param[in] trace The trace, none of its threads recording anymore.
+ * @param[in] path The file to write.
+ * @return 0 on success, -1 if the file cannot be written.
+ */
+int write_trace(const Trace *trace, const char *path);
+
+/**
+ * @brief Frees the buffers of a trace.
+ */
+void clear_trace(ptrTrace trace);
+
+/** @} */ // End of Trace group
+
+#endif // TRACE_H
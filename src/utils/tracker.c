@@ -0,0 +1,142 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for Memory Accounting
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "tracker.h"
+#include <stdalign.h>
+#include <sys/resource.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Precedes every allocation, keeping it aligned as malloc aligns.
+ */
+typedef union u_tracked_header {
+    struct {
+        size_t size;                    /**< Bytes asked for */
+        enum MemorySubsystem subsystem; /**< Accounted to */
+    } info;
+    max_align_t alignment; /**< Unused */
+} TrackedHeader;
+
+static void account_allocation(MemoryTracker *tracker, TrackedHeader *header) {
+    MemoryUsage *usages[2] = {&tracker->subsystems[header->info.subsystem],
+                              &tracker->total};
+    for (int k = 0; k < 2; k++) {
+        usages[k]->live += header->info.size;
+        usages[k]->allocations++;
+        if (usages[k]->live > usages[k]->peak)
+            usages[k]->peak = usages[k]->live;
+    }
+}
+
+static void account_release(MemoryTracker *tracker, TrackedHeader *header) {
+    MemoryUsage *usages[2] = {&tracker->subsystems[header->info.subsystem],
+                              &tracker->total};
+    for (int k = 0; k < 2; k++) {
+        usages[k]->live -= header->info.size;
+        usages[k]->frees++;
+    }
+}
+
+static void *tracked_allocate(void *context, size_t size) {
+    MemoryTracker *tracker = context;
+    if (size > SIZE_MAX - sizeof(TrackedHeader))
+        return NULL;
+    TrackedHeader *header = tracker->parent->allocate(
+        tracker->parent->context, sizeof(TrackedHeader) + size);
+    if (header == NULL)
+        return NULL;
+    header->info.size = size;
+    header->info.subsystem = get_allocation_subsystem();
+    account_allocation(tracker, header);
+    return header + 1;
+}
+
+static void tracked_release(void *context, void *pointer) {
+    MemoryTracker *tracker = context;
+    if (pointer == NULL)
+        return;
+    TrackedHeader *header = (TrackedHeader *)pointer - 1;
+    account_release(tracker, header);
+    tracker->parent->release(tracker->parent->context, header);
+}
+
+static void *tracked_reallocate(void *context, void *pointer, size_t size) {
+    MemoryTracker *tracker = context;
+    if (pointer == NULL)
+        return tracked_allocate(context, size);
+    if (size > SIZE_MAX - sizeof(TrackedHeader))
+        return NULL;
+    // The memory stays with the subsystem that allocated it
+    TrackedHeader *header = (TrackedHeader *)pointer - 1;
+    TrackedHeader previous = *header;
+    header = tracker->parent->reallocate(tracker->parent->context, header,
+                                         sizeof(TrackedHeader) + size);
+    if (header == NULL)
+        return NULL;
+    account_release(tracker, &previous);
+    header->info.size = size;
+    account_allocation(tracker, header);
+    return header + 1;
+}
+
+void init_memory_tracker(MemoryTracker *tracker, const Allocator *parent) {
+    tracker->allocator.allocate = tracked_allocate;
+    tracker->allocator.reallocate = tracked_reallocate;
+    tracker->allocator.release = tracked_release;
+    tracker->allocator.context = tracker;
+    tracker->parent = parent ? parent : get_system_allocator();
+    for (int s = 0; s < NB_MEM_SUBSYSTEMS; s++)
+        tracker->subsystems[s] = (MemoryUsage){0, 0, 0, 0};
+    tracker->total = (MemoryUsage){0, 0, 0, 0};
+}
+
+const Allocator *get_tracking_allocator(MemoryTracker *tracker) {
+    return &tracker->allocator;
+}
+
+const char *get_subsystem_name(enum MemorySubsystem subsystem) {
+    static const char *const names[NB_MEM_SUBSYSTEMS] = {
+        "other",   "utils",    "structures", "modules",
+        "storage", "services", "api"};
+    return names[subsystem];
+}
+
+size_t get_peak_rss(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    // Linux gives kilobytes
+    return (size_t)usage.ru_maxrss * 1024;
+}
+
+void emit_memory_stats(ptrWriter writer, const MemoryTracker *tracker) {
+    static const char *const headers[] = {"Subsystem", "Live bytes",
+                                          "Peak bytes", "Allocations",
+                                          "Frees"};
+    begin_table(writer, headers, 5, 0);
+    for (int s = 0; s <= NB_MEM_SUBSYSTEMS; s++) {
+        const MemoryUsage *usage =
+            s < NB_MEM_SUBSYSTEMS ? &tracker->subsystems[s] : &tracker->total;
+        if (usage->allocations == 0)
+            continue;
+        double values[4] = {usage->live, usage->peak, usage->allocations,
+                            usage->frees};
+        write_table_row(writer,
+                        s < NB_MEM_SUBSYSTEMS ? get_subsystem_name(s)
+                                              : "total",
+                        values);
+    }
+    end_table(writer);
+
+    static const char *const process[] = {"Process", "Bytes"};
+    begin_table(writer, process, 2, 0);
+    double rss = get_peak_rss();
+    write_table_row(writer, "peak RSS", &rss);
+    end_table(writer);
+}
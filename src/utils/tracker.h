@@ -0,0 +1,86 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for Memory Accounting
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef TRACKER_H
+#define TRACKER_H
+
+#include "allocator.h"
+#include "writer.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Tracker Memory Accounting
+ * @{
+ */
+
+/**
+ * @brief The memory of a subsystem, or of all of them.
+ */
+typedef struct s_memory_usage {
+    size_t live;          /**< Bytes allocated and not freed */
+    size_t peak;          /**< Highest live */
+    uint64_t allocations; /**< Allocations, resizes included */
+    uint64_t frees;       /**< Releases, resizes included */
+} MemoryUsage;
+
+/**
+ * @brief An allocator that accounts the memory of each subsystem before
+ * handing the calls to another one.
+ *
+ * Every allocation is preceded by its size and subsystem, so it must be
+ * freed through the tracker. As for any allocator, the counters belong to
+ * the thread that installed it.
+ */
+typedef struct s_memory_tracker {
+    Allocator allocator;                         /**< To install */
+    const Allocator *parent;                     /**< Serves the memory */
+    MemoryUsage subsystems[NB_MEM_SUBSYSTEMS];   /**< Per subsystem */
+    MemoryUsage total;                           /**< All of them */
+} MemoryTracker;
+
+/**
+ * @brief Sets up a tracker with no memory accounted.
+ *
+ * @param[out] tracker The tracker.
+ * @param[in] parent The allocator serving the memory, NULL for the
+ *                   default one. It must outlive the tracker.
+ */
+void init_memory_tracker(MemoryTracker *tracker, const Allocator *parent);
+
+/**
+ * @brief Gets the allocator to install with set_thread_allocator.
+ */
+const Allocator *get_tracking_allocator(MemoryTracker *tracker);
+
+/**
+ * @brief The name of a subsystem, for reports.
+ */
+const char *get_subsystem_name(enum MemorySubsystem subsystem);
+
+/**
+ * @brief Gets the peak resident set size of the process.
+ *
+ * @return The size in bytes, 0 if the system does not tell.
+ */
+size_t get_peak_rss(void);
+
+/**
+ * @brief Writes a table of the memory of each subsystem and of the total,
+ * then the peak resident set size.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] tracker The tracker.
+ */
+void emit_memory_stats(ptrWriter writer, const MemoryTracker *tracker);
+
+/** @} */ // End of Tracker group
+
+#endif // TRACKER_H
@@ -0,0 +1,447 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Implementation for the Buffered Result Writer
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "writer.h"
+#include "allocator.h"
+#include "stats.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+// Width of the candidate and value columns of text tables
+#define NAME_WIDTH 20
+#define VALUE_WIDTH 12
+
+ptrWriter open_writer(const char *path, enum OutputFormat format) {
+    int fd = STDOUT_FILENO;
+    if (path != NULL &&
+        (fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+        return NULL;
+    ptrWriter writer = mem_alloc(sizeof(Writer));
+    if (writer == NULL) {
+        if (path != NULL)
+            close(fd);
+        return NULL;
+    }
+    writer->fd = fd;
+    writer->owns_fd = path != NULL;
+    writer->failed = false;
+    writer->format = format;
+    writer->nb_columns = writer->decimals = 0;
+    writer->nb_rows = 0;
+    writer->size = 0;
+    return writer;
+}
+
+int parse_output_format(const char *name, enum OutputFormat *format) {
+    static const char *const names[] = {"text", "csv", "json", "binary"};
+    for (int f = FORMAT_TEXT; f <= FORMAT_BINARY; f++) {
+        if (strcmp(name, names[f]) == 0) {
+            *format = f;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int flush_writer(ptrWriter writer) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    if (writer->fd == STDOUT_FILENO)
+        fflush(stdout);
+    const char *bytes = writer->buffer;
+    while (writer->size > 0 && !writer->failed) {
+        ssize_t written = write(writer->fd, bytes, writer->size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0) {
+            writer->failed = true;
+            break;
+        }
+        bytes += written;
+        writer->size -= written;
+    }
+    writer->size = 0;
+    STATS_END(PHASE_OUTPUT);
+    return writer->failed ? -1 : 0;
+}
+
+int close_writer(ptrWriter writer) {
+    if (writer == NULL)
+        return -1;
+    int status = flush_writer(writer);
+    if (writer->owns_fd && close(writer->fd) != 0)
+        status = -1;
+    mem_free(writer);
+    return status;
+}
+
+void write_bytes(ptrWriter writer, const void *bytes, size_t size) {
+    while (writer->size + size > WRITER_BUFFER_SIZE) {
+        // What does not fit fills the buffer, then goes out with it
+        size_t chunk = WRITER_BUFFER_SIZE - writer->size;
+        memcpy(writer->buffer + writer->size, bytes, chunk);
+        writer->size += chunk;
+        flush_writer(writer);
+        bytes = (const char *)bytes + chunk;
+        size -= chunk;
+    }
+    memcpy(writer->buffer + writer->size, bytes, size);
+    writer->size += size;
+}
+
+void write_text(ptrWriter writer, const char *text) {
+    write_bytes(writer, text, strlen(text));
+}
+
+void write_repeated(ptrWriter writer, char c, int count) {
+    char chunk[64];
+    memset(chunk, c, sizeof(chunk));
+    while (count > 0) {
+        int size = count < (int)sizeof(chunk) ? count : (int)sizeof(chunk);
+        write_bytes(writer, chunk, size);
+        count -= size;
+    }
+}
+
+int count_digits(long long value) {
+    int digits = value < 0 ? 2 : 1;
+    unsigned long long magnitude =
+        value < 0 ? -(unsigned long long)value : (unsigned long long)value;
+    while (magnitude >= 10) {
+        magnitude /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+/**
+ * @brief Formats an integer at the end of a buffer.
+ *
+ * @return The first character written, the buffer ending the number.
+ */
+static char *format_integer(char *end, unsigned long long magnitude) {
+    do {
+        *--end = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude != 0);
+    return end;
+}
+
+/**
+ * @brief Formats a number as printf's `%.*f` would.
+ *
+ * The value is scaled and rounded as printf rounds the exact binary value:
+ * the product only tells on which side of a half it falls when fma shows
+ * it was rounded to that half.
+ *
+ * @return The length of the text, written to the start of `text`, or -1
+ * when the number is out of the range of the integers.
+ */
+static int format_decimal(char text[64], double value, int decimals) {
+    double scale = 1;
+    for (int d = 0; d < decimals; d++)
+        scale *= 10;
+    double product = value * scale;
+    if (!isfinite(product) || decimals > 18 || fabs(product) >= 0x1p52)
+        return -1;
+    double rounded = nearbyint(product);
+    double residual = fma(value, scale, -product);
+    if (fabs(product - trunc(product)) == 0.5 && residual != 0)
+        rounded = residual > 0 ? ceil(product) : floor(product);
+
+    unsigned long long magnitude = fabs(rounded);
+    unsigned long long divisor = scale;
+    char digits[24], *end = digits + sizeof(digits);
+    char *start = format_integer(end, magnitude % divisor);
+    int length = 0;
+    if (signbit(value))
+        text[length++] = '-';
+    char *integer = format_integer(start, magnitude / divisor);
+    memcpy(text + length, integer, start - integer);
+    length += start - integer;
+    if (decimals > 0) {
+        text[length++] = '.';
+        memset(text + length, '0', decimals - (end - start));
+        length += decimals - (end - start);
+        memcpy(text + length, start, end - start);
+        length += end - start;
+    }
+    return length;
+}
+
+/**
+ * @brief Formats a signed integer at the start of a buffer.
+ *
+ * @return The length of the text.
+ */
+static int format_signed(char text[24], long long value) {
+    char digits[24], *end = digits + sizeof(digits);
+    char *start = format_integer(end, value < 0 ? -(unsigned long long)value
+                                                : (unsigned long long)value);
+    if (value < 0)
+        *--start = '-';
+    memcpy(text, start, end - start);
+    return end - start;
+}
+
+void write_integer(ptrWriter writer, long long value) {
+    char text[24];
+    write_bytes(writer, text, format_signed(text, value));
+}
+
+/**
+ * @brief Writes through printf the numbers format_decimal cannot handle.
+ *
+ * @return The length of the text.
+ */
+static int write_large_decimal(ptrWriter writer, double value, int decimals) {
+    int length = snprintf(NULL, 0, "%.*f", decimals, value);
+    char *text = mem_alloc(length + 1);
+    if (text == NULL) {
+        writer->failed = true;
+        return length;
+    }
+    snprintf(text, length + 1, "%.*f", decimals, value);
+    write_bytes(writer, text, length);
+    mem_free(text);
+    return length;
+}
+
+void write_decimal(ptrWriter writer, double value, int decimals) {
+    char text[64];
+    int length = format_decimal(text, value, decimals);
+    if (length < 0)
+        write_large_decimal(writer, value, decimals);
+    else
+        write_bytes(writer, text, length);
+}
+
+void write_json_string(ptrWriter writer, const char *string) {
+    static const char hex[] = "0123456789abcdef";
+    write_bytes(writer, "\"", 1);
+    for (const unsigned char *c = (const unsigned char *)string; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            char escaped[2] = {'\\', *c};
+            write_bytes(writer, escaped, 2);
+        } else if (*c < 0x20) {
+            char escaped[6] = {'\\', 'u', '0', '0', hex[*c >> 4],
+                               hex[*c & 15]};
+            write_bytes(writer, escaped, 6);
+        } else {
+            write_bytes(writer, c, 1);
+        }
+    }
+    write_bytes(writer, "\"", 1);
+}
+
+void write_csv_field(ptrWriter writer, const char *string) {
+    if (strpbrk(string, ",\"\r\n") == NULL) {
+        write_text(writer, string);
+        return;
+    }
+    write_bytes(writer, "\"", 1);
+    for (const char *c = string; *c; c++) {
+        if (*c == '"')
+            write_bytes(writer, "\"", 1);
+        write_bytes(writer, c, 1);
+    }
+    write_bytes(writer, "\"", 1);
+}
+
+void write_u32(ptrWriter writer, uint32_t value) {
+    write_bytes(writer, &value, sizeof(value));
+}
+
+void write_binary_string(ptrWriter writer, const char *string) {
+    uint32_t size = strlen(string);
+    write_u32(writer, size);
+    write_bytes(writer, string, size);
+}
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @brief Writes a value of the current table, right-aligned on a width.
+ */
+static void write_value(ptrWriter writer, double value, int width) {
+    char text[64];
+    int length = format_decimal(text, value, writer->decimals);
+    if (length < 0) {
+        length = snprintf(NULL, 0, "%.*f", writer->decimals, value);
+        write_repeated(writer, ' ', width - length);
+        write_large_decimal(writer, value, writer->decimals);
+        return;
+    }
+    write_repeated(writer, ' ', width - length);
+    write_bytes(writer, text, length);
+}
+
+void begin_table(ptrWriter writer, const char *const *headers,
+                 int nb_columns, int decimals) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    writer->nb_columns = nb_columns;
+    writer->decimals = decimals;
+    writer->nb_rows = 0;
+    switch (writer->format) {
+    case FORMAT_TEXT:
+        write_text(writer, "\n");
+        write_repeated(writer, ' ', NAME_WIDTH - (int)strlen(headers[0]));
+        write_text(writer, headers[0]);
+        for (int k = 1; k < nb_columns; k++) {
+            write_text(writer, " | ");
+            write_repeated(writer, ' ', VALUE_WIDTH - (int)strlen(headers[k]));
+            write_text(writer, headers[k]);
+        }
+        write_text(writer, "\n ");
+        write_repeated(writer, '-', NAME_WIDTH - 1);
+        for (int k = 1; k < nb_columns; k++) {
+            write_text(writer, "-|-");
+            write_repeated(writer, '-', VALUE_WIDTH);
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_CSV:
+        for (int k = 0; k < nb_columns; k++) {
+            if (k > 0)
+                write_text(writer, ",");
+            write_csv_field(writer, headers[k]);
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_JSON:
+        write_text(writer, "{\"type\":\"table\",\"columns\":[");
+        for (int k = 0; k < nb_columns; k++) {
+            if (k > 0)
+                write_text(writer, ",");
+            write_json_string(writer, headers[k]);
+        }
+        write_text(writer, "],\"rows\":[");
+        break;
+    case FORMAT_BINARY:
+        write_bytes(writer, &(uint8_t){RECORD_TABLE}, 1);
+        write_u32(writer, nb_columns);
+        for (int k = 0; k < nb_columns; k++)
+            write_binary_string(writer, headers[k]);
+        break;
+    }
+    STATS_END(PHASE_OUTPUT);
+}
+
+void write_table_row(ptrWriter writer, const char *candidate,
+                     const double *values) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    switch (writer->format) {
+    case FORMAT_TEXT:
+        write_repeated(writer, ' ', NAME_WIDTH - (int)strlen(candidate));
+        write_text(writer, candidate);
+        for (int k = 0; k < writer->nb_columns - 1; k++) {
+            write_text(writer, " | ");
+            write_value(writer, values[k], VALUE_WIDTH);
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_CSV:
+        write_csv_field(writer, candidate);
+        for (int k = 0; k < writer->nb_columns - 1; k++) {
+            write_text(writer, ",");
+            write_value(writer, values[k], 0);
+        }
+        write_text(writer, "\n");
+        break;
+    case FORMAT_JSON:
+        write_text(writer, writer->nb_rows > 0 ? ",[" : "[");
+        write_json_string(writer, candidate);
+        for (int k = 0; k < writer->nb_columns - 1; k++) {
+            write_text(writer, ",");
+            write_value(writer, values[k], 0);
+        }
+        write_text(writer, "]");
+        break;
+    case FORMAT_BINARY:
+        write_bytes(writer, &(uint8_t){1}, 1);
+        write_binary_string(writer, candidate);
+        write_bytes(writer, values, sizeof(double) * (writer->nb_columns - 1));
+        break;
+    }
+    writer->nb_rows++;
+    STATS_END(PHASE_OUTPUT);
+}
+
+void end_table(ptrWriter writer) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    switch (writer->format) {
+    case FORMAT_TEXT:
+        break;
+    case FORMAT_CSV:
+        write_text(writer, "\n");
+        break;
+    case FORMAT_JSON:
+        write_text(writer, "]}\n");
+        break;
+    case FORMAT_BINARY:
+        write_bytes(writer, &(uint8_t){0}, 1);
+        break;
+    }
+    STATS_END(PHASE_OUTPUT);
+}
+
+void emit_winner(ptrWriter writer, const char *label, int index,
+                 const char *candidate) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    switch (writer->format) {
+    case FORMAT_TEXT:
+        write_text(writer, "\n");
+        write_text(writer, label);
+        write_text(writer, " winner is candidate : ");
+        write_text(writer, candidate);
+        write_text(writer, "\n");
+        break;
+    case FORMAT_CSV:
+        write_text(writer, "winner,");
+        write_csv_field(writer, label);
+        write_text(writer, ",");
+        write_csv_field(writer, candidate);
+        write_text(writer, "\n\n");
+        break;
+    case FORMAT_JSON:
+        write_text(writer, "{\"type\":\"winner\",\"method\":");
+        write_json_string(writer, label);
+        write_text(writer, ",\"index\":");
+        write_integer(writer, index);
+        write_text(writer, ",\"candidate\":");
+        write_json_string(writer, candidate);
+        write_text(writer, "}\n");
+        break;
+    case FORMAT_BINARY:
+        write_bytes(writer, &(uint8_t){RECORD_WINNER}, 1);
+        write_binary_string(writer, label);
+        write_u32(writer, index);
+        write_binary_string(writer, candidate);
+        break;
+    }
+    STATS_END(PHASE_OUTPUT);
+}
+
+void emit_note(ptrWriter writer, const char *note) {
+    STATS_BEGIN(PHASE_OUTPUT);
+    if (writer->format == FORMAT_TEXT) {
+        write_text(writer, "\n");
+        write_text(writer, note);
+        write_text(writer, "\n");
+    } else if (writer->format == FORMAT_JSON) {
+        write_text(writer, "{\"type\":\"note\",\"text\":");
+        write_json_string(writer, note);
+        write_text(writer, "}\n");
+    }
+    STATS_END(PHASE_OUTPUT);
+}
@@ -0,0 +1,213 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Interface for the Buffered Result Writer
+ **/
+/*-----------------------------------------------------------------*/
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*-----------------------------------------------------------------*/
+
+/**
+ * @defgroup Writer Result Writer
+ * @{
+ *
+ * Results are written as records: tables of candidates, winners, notes and
+ * matrices (see emit_matrix). Each format renders them its own way:
+ *
+ * - FORMAT_TEXT: the aligned tables of VotingMethods.
+ * - FORMAT_CSV: one block of rows per table or matrix, blank lines between
+ *   blocks, winners as `winner,<label>,<candidate>`. Notes are skipped.
+ * - FORMAT_JSON: one JSON object per record and per line, with a "type" of
+ *   "table", "winner", "note" or "matrix".
+ * - FORMAT_BINARY: a RecordType byte per record then its fields, integers
+ *   as native 32-bit values, values as native doubles and strings as a
+ *   32-bit length then their bytes. A table is its column count and
+ *   headers, then each row as a 1 byte, its candidate and values, and a 0
+ *   byte after the last row. A winner is its label,
+ *   index and candidate. A matrix is its row and column counts, a duel
+ *   byte, the tags and then the values. An election of a batch is its
+ *   file and method, then a 1 byte, its candidate, ballot and rejected
+ *   counts, winner index and winner, or a 0 byte and its error. Notes are
+ *   skipped.
+ */
+
+/**
+ * @brief Size of the buffer of a writer.
+ */
+#define WRITER_BUFFER_SIZE (1 << 16)
+
+/**
+ * @brief The output formats.
+ */
+enum OutputFormat { FORMAT_TEXT, FORMAT_CSV, FORMAT_JSON, FORMAT_BINARY };
+
+/**
+ * @brief The records of the binary format.
+ */
+enum RecordType {
+    RECORD_TABLE = 1,
+    RECORD_WINNER,
+    RECORD_MATRIX,
+    RECORD_ELECTION
+};
+
+/**
+ * @brief A buffered output in one of the formats.
+ */
+typedef struct s_writer {
+    int fd;                          /**< Where the buffer is flushed */
+    bool owns_fd;                    /**< Whether closing closes fd */
+    bool failed;                     /**< A write failed */
+    enum OutputFormat format;        /**< The format of the records */
+    int nb_columns;                  /**< Columns of the current table */
+    int decimals;                    /**< Decimals of its values */
+    uint32_t nb_rows;                /**< Rows of the current table */
+    size_t size;                     /**< Bytes in the buffer */
+    char buffer[WRITER_BUFFER_SIZE]; /**< Bytes not written yet */
+} Writer;
+
+/**
+ * @brief Typedef for a pointer to a Writer structure.
+ */
+typedef Writer *ptrWriter;
+
+/**
+ * @brief Opens a writer on a file, or on the standard output.
+ *
+ * @param[in] path The file, truncated, or NULL for the standard output.
+ * @param[in] format The format of the records.
+ * @return The writer, or NULL if the file cannot be opened.
+ *
+ * @post The returned Writer must be closed with close_writer.
+ */
+ptrWriter open_writer(const char *path, enum OutputFormat format);
+
+/**
+ * @brief Reads the name of a format.
+ *
+ * @param[in] name "text", "csv", "json" or "binary".
+ * @param[out] format The format.
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parse_output_format(const char *name, enum OutputFormat *format);
+
+/**
+ * @brief Writes the buffer with a single write.
+ *
+ * The standard output is flushed first, so that printed lines come out
+ * before the records.
+ *
+ * @return 0 on success, -1 if a write failed since the writer was opened.
+ */
+int flush_writer(ptrWriter writer);
+
+/**
+ * @brief Flushes and frees a writer.
+ *
+ * @return 0 on success, -1 if a write failed.
+ */
+int close_writer(ptrWriter writer);
+
+/**
+ * @brief Appends bytes, flushing when the buffer is full.
+ */
+void write_bytes(ptrWriter writer, const void *bytes, size_t size);
+
+/**
+ * @brief Appends a string.
+ */
+void write_text(ptrWriter writer, const char *text);
+
+/**
+ * @brief Appends a character a number of times, nothing if it is negative.
+ */
+void write_repeated(ptrWriter writer, char c, int count);
+
+/**
+ * @brief Appends an integer in decimal.
+ */
+void write_integer(ptrWriter writer, long long value);
+
+/**
+ * @brief Appends a number with a number of decimals, as printf's `%.*f`.
+ */
+void write_decimal(ptrWriter writer, double value, int decimals);
+
+/**
+ * @brief Appends a string between quotes, escaped for JSON.
+ */
+void write_json_string(ptrWriter writer, const char *string);
+
+/**
+ * @brief Appends a string as a CSV field, quoted if needed.
+ */
+void write_csv_field(ptrWriter writer, const char *string);
+
+/**
+ * @brief Appends a 32-bit integer, natively.
+ */
+void write_u32(ptrWriter writer, uint32_t value);
+
+/**
+ * @brief Appends a string as its 32-bit length then its bytes.
+ */
+void write_binary_string(ptrWriter writer, const char *string);
+
+/**
+ * @brief Gives the number of characters of an integer in decimal.
+ */
+int count_digits(long long value);
+
+/**
+ * @brief Starts a table of candidates.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] headers The headers, the first one naming the candidates.
+ * @param[in] nb_columns The number of headers.
+ * @param[in] decimals The decimals of the values, 0 for integers.
+ */
+void begin_table(ptrWriter writer, const char *const *headers,
+                 int nb_columns, int decimals);
+
+/**
+ * @brief Adds a row to the current table.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] candidate The name of the candidate.
+ * @param[in] values Its values, one per header after the first.
+ */
+void write_table_row(ptrWriter writer, const char *candidate,
+                     const double *values);
+
+/**
+ * @brief Ends the current table.
+ */
+void end_table(ptrWriter writer);
+
+/**
+ * @brief Writes the winner of a method.
+ *
+ * @param[in,out] writer The writer.
+ * @param[in] label The method, as in "Schulze winner is candidate".
+ * @param[in] index The index of the winner.
+ * @param[in] candidate Its name.
+ */
+void emit_winner(ptrWriter writer, const char *label, int index,
+                 const char *candidate);
+
+/**
+ * @brief Writes a line of text that is not a result.
+ */
+void emit_note(ptrWriter writer, const char *note);
+
+/** @} */ // End of Writer group
+
+#endif // WRITER_H
@@ -0,0 +1,141 @@
+#include "voting.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NB_THREADS 4
+
+typedef struct {
+    long live;  // Blocks allocated and not released
+    long total; // Blocks allocated
+} Counter;
+
+static void *count_allocate(void *context, size_t size) {
+    Counter *counter = context;
+    counter->live++;
+    counter->total++;
+    return malloc(size);
+}
+
+static void *count_reallocate(void *context, void *pointer, size_t size) {
+    if (pointer == NULL)
+        return count_allocate(context, size);
+    return realloc(pointer, size);
+}
+
+static void count_release(void *context, void *pointer) {
+    ((Counter *)context)->live--;
+    free(pointer);
+}
+
+static void check(bool condition, const char *message) {
+    if (!condition) {
+        fprintf(stderr, "%s\n", message);
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Counts a file with its own allocator, returns the Schulze winner
+static void *count_file(void *path) {
+    Counter counter = {0, 0};
+    VotingAllocator allocator = {count_allocate, count_reallocate,
+                                 count_release, &counter};
+    VotingElection *election = voting_election_create(&allocator);
+    check(election != NULL, "Could not create an election");
+    check(voting_election_load(election, path, 0) == VOTING_OK,
+          "Could not load the election");
+    VotingResult result;
+    check(voting_election_count(election, "cs", NULL, &result) == VOTING_OK,
+          "Could not count the election");
+    voting_election_destroy(election);
+    check(counter.total > 0 && counter.live == 0,
+          "The election did not use or release its allocator");
+    return (void *)(long)result.winner;
+}
+
+static void test_file(const char *path) {
+    VotingElection *election = voting_election_create(NULL);
+    VotingResult result;
+    check(voting_election_load(election, "missing.csv", 0) == VOTING_ERROR_IO,
+          "A missing file must be an I/O error");
+    check(voting_election_count(election, "cs", NULL, &result) ==
+              VOTING_ERROR_ARGUMENT,
+          "An empty election has no winner");
+    check(voting_election_load(election, path, 0) == VOTING_OK,
+          "Could not load the election");
+    check(voting_election_count(election, "nope", NULL, &result) ==
+              VOTING_ERROR_METHOD,
+          "An unknown method must be reported");
+    check(voting_election_count(election, "dhondt", NULL, &result) ==
+              VOTING_ERROR_NO_WINNER,
+          "Seat allocations have no single winner");
+    check(voting_election_count(election, "cm", NULL, &result) == VOTING_OK &&
+              result.ballots > 0 && result.nb_candidates > 0,
+          "Could not count the election");
+
+    int allocated[256], total = 0;
+    check(voting_election_allocate_seats(election, "dhondt", 10, allocated) ==
+              VOTING_OK,
+          "Could not allocate the seats");
+    for (int i = 0; i < result.nb_candidates; i++)
+        total += allocated[i];
+    check(total == 10, "Every seat must be allocated");
+    voting_election_destroy(election);
+}
+
+static void test_ballots(void) {
+    const char *names[] = {"A", "B", "C"};
+    const int ballots[][3] = {{1, 2, 3}, {1, 2, 3}, {1, 2, 3},
+                              {3, 1, 2}, {3, 1, 2}};
+    VotingElection *election = voting_election_create(NULL);
+    check(voting_election_set_candidates(election, names, 3) == VOTING_OK,
+          "Could not set the candidates");
+    for (int i = 0; i < 5; i++)
+        check(voting_election_add_ballot(election, ballots[i]) == VOTING_OK,
+              "Could not add a ballot");
+    int invalid[] = {1, 256, 2};
+    check(voting_election_add_ballot(election, invalid) ==
+              VOTING_ERROR_ARGUMENT,
+          "A rank above 255 must be rejected");
+
+    VotingResult result;
+    check(voting_election_count(election, "cm", NULL, &result) == VOTING_OK &&
+              result.winner == 0 && result.ballots == 5,
+          "A wins every duel");
+    check(strcmp(voting_election_candidate(election, result.winner), "A") == 0,
+          "The winner is A");
+    check(voting_election_candidate(election, 3) == NULL,
+          "There are three candidates");
+
+    // Two more B > C > A ballots make B the Condorcet winner
+    voting_election_add_ballot(election, ballots[3]);
+    voting_election_add_ballot(election, ballots[4]);
+    check(voting_election_count(election, "cm", NULL, &result) == VOTING_OK &&
+              result.winner == 1,
+          "Added ballots must be counted");
+    voting_election_destroy(election);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <Filename>\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    test_file(argv[1]);
+    test_ballots();
+
+    // Elections counted at the same time must not interfere
+    long expected = (long)count_file(argv[1]);
+    pthread_t threads[NB_THREADS];
+    for (int i = 0; i < NB_THREADS; i++)
+        pthread_create(&threads[i], NULL, count_file, argv[1]);
+    for (int i = 0; i < NB_THREADS; i++) {
+        void *winner;
+        pthread_join(threads[i], &winner);
+        check((long)winner == expected, "Threads found different winners");
+    }
+    printf("API tests passed\n");
+    return 0;
+}
@@ -0,0 +1,1003 @@
+#include "bucklin.h"
+#include "cache.h"
+#include "condorcet.h"
+#include "elimination.h"
+#include "first_past_the_post.h"
+#include "majority_judgement.h"
+#include "miscellaneous.h"
+#include "random.h"
+#include "scoring_rules.h"
+#include "smith.h"
+#include "stats.h"
+#include "summary.h"
+#include "synthetic.h"
+#include "tracker.h"
+#include "withdrawal.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// The most ballots a Matrix holds, the reference methods working on Matrix
+#define CHUNK_ROWS (MAX_TAB - 1)
+
+// The most candidates the Smith methods and the withdrawals are recounted
+// for, their references costing O(C^4)
+#define RECOUNT_CANDIDATES 16
+
+// Every election is one of these, in turn
+enum EdgeCase {
+    EDGE_NONE,     /**< Truncated ballots and -1 here and there */
+    EDGE_UNRANKED, /**< Only -1 */
+    EDGE_TIES,     /**< Ranks from 1 to 3, shared by many candidates */
+    EDGE_SINGLE,   /**< A single candidate */
+    EDGE_MAX,      /**< MAX_TAB - 1 candidates */
+    NB_EDGE_CASES
+};
+
+static const char *const edge_cases[NB_EDGE_CASES] = {
+    "random", "unranked", "ties", "single candidate", "most candidates"};
+
+// An election as drawn, then read by the reference and the optimized parsers
+typedef struct s_election {
+    ElectionModel model;
+    enum EdgeCase edge;
+    bool special;       /**< Q00_Vote->N - Name header */
+    uint nb_ballots;
+    int *drawn;         /**< Ranks as written, ballot after ballot */
+    char path[4096];    /**< The CSV file */
+    char **names;       /**< From fetch_data */
+    int **data;         /**< From fetch_data */
+    int rows, cols;     /**< From fetch_data */
+    ptrBallots ballots; /**< From set_ballots_from_file */
+} Election;
+
+typedef bool (*Check)(const Election *election);
+
+/*-----------------------------------------------------------------*/
+
+static int draw_election(Election *election, uint64_t seed, uint64_t index) {
+    RandomStream stream;
+    init_random_stream(&stream, seed, index);
+    enum EdgeCase edge = index % NB_EDGE_CASES;
+    int nb_candidates = edge == EDGE_SINGLE ? 1
+                        : edge == EDGE_MAX  ? MAX_TAB - 1
+                                            : 2 + next_below(&stream, 15);
+    // Below and above what a Matrix holds
+    uint nb_ballots = 1 + next_below(&stream, edge == EDGE_MAX ? 300 : 600);
+    enum BallotModel kind = next_below(&stream, NB_BALLOT_MODELS);
+    election->edge = edge;
+    election->special = next_below(&stream, 2);
+    election->nb_ballots = nb_ballots;
+    init_election_model(&election->model, kind, nb_candidates, -1,
+                        next_random(&stream));
+    election->model.truncation = next_uniform(&stream) / 2;
+    election->model.unranked = next_uniform(&stream) / 4;
+
+    election->drawn = mem_alloc(sizeof(int) * nb_candidates * nb_ballots);
+    if (election->drawn == NULL)
+        return -1;
+    for (uint b = 0; b < nb_ballots; b++) {
+        int *row = &election->drawn[(size_t)b * nb_candidates];
+        draw_ballot(&election->model, b, row);
+        for (int c = 0; c < nb_candidates; c++) {
+            if (edge == EDGE_UNRANKED)
+                row[c] = -1;
+            else if (edge == EDGE_TIES && row[c] != -1)
+                row[c] = 1 + next_below(&stream, 3);
+        }
+    }
+    return 0;
+}
+
+static int write_election(Election *election, const char *directory) {
+    snprintf(election->path, sizeof(election->path),
+             "%s/differential_XXXXXX", directory);
+    int fd = mkstemp(election->path);
+    if (fd < 0)
+        return -1;
+    FILE *file = fdopen(fd, "w");
+    int n = election->model.nb_candidates;
+    char *line = mem_alloc(SYNTHETIC_ROW_SIZE(n));
+    if (file == NULL || line == NULL) {
+        if (file != NULL)
+            fclose(file);
+        else
+            close(fd);
+        mem_free(line);
+        return -1;
+    }
+    write_synthetic_header(file, &election->model, election->special);
+    for (uint b = 0; b < election->nb_ballots; b++) {
+        char *end = format_synthetic_row(line, &election->model, b,
+                                         &election->drawn[(size_t)b * n],
+                                         election->special);
+        fwrite(line, 1, end - line, file);
+    }
+    mem_free(line);
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+static void free_election(Election *election) {
+    for (int i = 0; i < election->cols; i++)
+        mem_free(election->names[i]);
+    mem_free(election->names);
+    mem_free(election->data);
+    mem_free(election->drawn);
+    delete_ballots(election->ballots);
+}
+
+/*-----------------------------------------------------------------*/
+
+// Runs format_votes_with_filter over every ballot, a Matrix at a time. With
+// finalists, the other candidates are left out first, as the two rounds
+// used to be counted. A ballot without a single best rank chooses -1.
+static int reference_first_choices(const Election *election,
+                                   const int *finalists, int nb_finalists,
+                                   int *choices, int *totals) {
+    int n = election->cols;
+    ptrMatrix matrix = init_matrix(false);
+    if (matrix == NULL)
+        return -1;
+    memset(totals, 0, sizeof(int) * n);
+    for (int first = 0; first < election->rows; first += CHUNK_ROWS) {
+        int rows = election->rows - first < CHUNK_ROWS ? election->rows - first
+                                                       : CHUNK_ROWS;
+        matrix->rows = rows;
+        matrix->columns = n;
+        for (int i = 0; i < rows; i++)
+            memcpy(matrix->data[i], election->data[first + i],
+                   sizeof(int) * n);
+        if (finalists != NULL)
+            update_matrix_data(matrix, finalists, nb_finalists);
+        format_votes_with_filter(matrix, n);
+        for (int i = 0; i < rows; i++) {
+            int choice = -1;
+            for (int c = 0; c < n; c++)
+                choice = matrix->data[i][c] == 1 ? c : choice;
+            if (choices != NULL)
+                choices[first + i] = choice;
+            if (choice != -1)
+                totals[choice]++;
+        }
+    }
+    matrix->columns = 0; // No tag to free
+    delete_matrix(matrix);
+    return 0;
+}
+
+static bool same_duels(const Matrix *a, const Matrix *b) {
+    if (a->rows != b->rows || a->columns != b->columns)
+        return false;
+    for (uint i = 0; i < a->rows; i++) {
+        if (memcmp(a->data[i], b->data[i], sizeof(int) * a->columns) != 0)
+            return false;
+    }
+    return true;
+}
+
+static bool same_histograms(const Histogram *a, const Histogram *b) {
+    if (a->rows != b->rows || a->columns != b->columns ||
+        a->ballots != b->ballots)
+        return false;
+    for (uint c = 0; c < a->rows; c++) {
+        if (memcmp(a->counts[c], b->counts[c], sizeof(uint) * a->columns) !=
+            0)
+            return false;
+    }
+    return true;
+}
+
+static bool same_tallies(const Tallies *a, const Tallies *b) {
+    uint columns = a->ballots->columns;
+    if (b->ballots->columns != columns || !same_duels(a->duel, b->duel) ||
+        memcmp(a->first_choices, b->first_choices, sizeof(int) * columns) !=
+            0 ||
+        !same_histograms(a->histogram, b->histogram))
+        return false;
+    for (uint c = 0; c < columns; c++) {
+        if (strcmp(a->ballots->tags[c]->string, b->ballots->tags[c]->string))
+            return false;
+    }
+    if (!a->has_ballots || !b->has_ballots)
+        return true;
+    if (a->ballots->rows != b->ballots->rows)
+        return false;
+    for (uint c = 0; c < columns; c++) {
+        if (memcmp(get_ballots_column(a->ballots, c),
+                   get_ballots_column(b->ballots, c), a->ballots->rows) != 0)
+            return false;
+    }
+    return true;
+}
+
+// Gives tallies the candidates of an election and no ballot
+static void set_candidates(ptrTallies tallies, const Ballots *ballots) {
+    for (uint c = 0; c < ballots->columns; c++) {
+        const StringBuffer *tag = ballots->tags[c];
+        tallies->ballots->tags[c] = init_stringbuffer(tag->string, tag->size);
+    }
+    tallies->ballots->columns = ballots->columns;
+}
+
+// Scores summed in another order only differ by rounding
+static bool same_score(double a, double b) {
+    double difference = a > b ? a - b : b - a;
+    return difference <= 1e-9 * (1 + (b > 0 ? b : -b));
+}
+
+// Counts from scratch the continuing candidate ranked first (alone) and last
+// (alone, unranked being last) on every ballot
+static void count_ends(const Election *election, const bool *continuing,
+                       uint *firsts, uint *lasts, uint *voting) {
+    int n = election->cols;
+    *voting = 0;
+    for (int c = 0; c < n; c++)
+        firsts[c] = lasts[c] = 0;
+    for (int b = 0; b < election->rows; b++) {
+        int top = -1, bottom = -1, best = MAX_RANK + 2, worst = -1;
+        bool top_tied = false, bottom_tied = false;
+        for (int c = 0; c < n; c++) {
+            if (!continuing[c])
+                continue;
+            int rank = election->data[b][c];
+            int key = rank > 0 ? rank : MAX_RANK + 1;
+            if (rank > 0 && key <= best) {
+                top_tied = key == best;
+                top = c;
+                best = key;
+            }
+            if (key >= worst) {
+                bottom_tied = key == worst;
+                bottom = c;
+                worst = key;
+            }
+        }
+        *voting += top != -1;
+        if (top != -1 && !top_tied)
+            firsts[top]++;
+        if (bottom != -1 && !bottom_tied)
+            lasts[bottom]++;
+    }
+}
+
+static int first_standing(const bool *continuing, int nb_candidates) {
+    for (int c = 0; c < nb_candidates; c++) {
+        if (continuing[c])
+            return c;
+    }
+    return -1;
+}
+
+// Borda score over the continuing candidates, summed again from the duels
+static long borda_recount(const Matrix *duel, const bool *continuing,
+                          int candidate) {
+    long score = 0;
+    for (uint c = 0; c < duel->columns; c++) {
+        if (continuing[c] && (int)c != candidate)
+            score += duel->data[candidate][c];
+    }
+    return score;
+}
+
+// Finds the continuing candidates reaching every other continuing one by a
+// path of duels they do not lose
+static void reach_smith_set(const Matrix *duel, const bool *continuing,
+                            bool *smith) {
+    static bool reach[MAX_TAB][MAX_TAB];
+    int n = duel->columns;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++)
+            reach[i][j] = i == j || duel->data[i][j] >= duel->data[j][i];
+    }
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < n && continuing[k]; i++) {
+            for (int j = 0; j < n; j++)
+                reach[i][j] |= reach[i][k] && reach[k][j];
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        smith[i] = continuing[i];
+        for (int j = 0; j < n && smith[i]; j++)
+            smith[i] = !continuing[j] || reach[i][j];
+    }
+}
+
+// Instant-runoff loser over first places recounted from every ballot, the
+// last one among ties
+static int recount_irv_loser(const Election *election,
+                             const bool *continuing) {
+    uint firsts[MAX_TAB], lasts[MAX_TAB], voting;
+    count_ends(election, continuing, firsts, lasts, &voting);
+    int loser = -1;
+    for (int c = 0; c < election->cols; c++) {
+        if (continuing[c] && (loser == -1 || firsts[c] <= firsts[loser]))
+            loser = c;
+    }
+    return loser;
+}
+
+// Continuing candidate with a strict majority of the ballots still ranking
+// someone or left alone, -1 if there is none yet
+static int recount_irv_winner(const Election *election,
+                              const bool *continuing) {
+    uint firsts[MAX_TAB], lasts[MAX_TAB], voting;
+    count_ends(election, continuing, firsts, lasts, &voting);
+    int remaining = 0, last = -1;
+    for (int c = 0; c < election->cols; c++) {
+        if (continuing[c] && firsts[c] * 2 > voting)
+            return c;
+        remaining += continuing[c];
+        last = continuing[c] ? c : last;
+    }
+    return remaining == 1 ? last : -1;
+}
+
+// Schulze winner of the textbook triple loop, the first among ties
+static int reference_schulze(const Matrix *duel) {
+    static int paths[MAX_TAB][MAX_TAB];
+    int n = duel->columns;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            paths[i][j] = i != j && duel->data[i][j] > duel->data[j][i]
+                              ? duel->data[i][j]
+                              : 0;
+        }
+    }
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                int through = paths[i][k] < paths[k][j] ? paths[i][k]
+                                                        : paths[k][j];
+                if (i != j && i != k && j != k && through > paths[i][j])
+                    paths[i][j] = through;
+            }
+        }
+    }
+    int winner = -1, best = -1;
+    for (int i = 0; i < n; i++) {
+        int score = 0;
+        for (int j = 0; j < n; j++)
+            score += paths[i][j] > paths[j][i];
+        if (score > best) {
+            best = score;
+            winner = i;
+        }
+    }
+    return winner;
+}
+
+static int compare_levels(const void *first, const void *second) {
+    return *(const int *)first - *(const int *)second;
+}
+
+/*-----------------------------------------------------------------*/
+
+// Both parsers read back what was drawn
+static bool check_parse(const Election *election) {
+    const Ballots *ballots = election->ballots;
+    int n = election->model.nb_candidates;
+    if (election->rows != (int)election->nb_ballots || election->cols != n ||
+        ballots->rows != election->nb_ballots || ballots->columns != (uint)n ||
+        ballots->rejected != 0)
+        return false;
+    for (int c = 0; c < n; c++) {
+        if (strcmp(election->names[c], ballots->tags[c]->string) != 0)
+            return false;
+    }
+    for (uint b = 0; b < election->nb_ballots; b++) {
+        for (int c = 0; c < n; c++) {
+            int rank = election->drawn[(size_t)b * n + c];
+            if (election->data[b][c] != rank ||
+                get_ballot_rank(ballots, b, c) !=
+                    (rank > 0 ? rank : RANK_NONE))
+                return false;
+        }
+    }
+    return true;
+}
+
+// duel_matrix over every ballot, against the column scans
+static bool check_pairwise(const Election *election) {
+    int n = election->cols;
+    ptrMatrix reference = init_matrix(true);
+    ptrMatrix duel = init_matrix(true);
+    if (reference == NULL || duel == NULL) {
+        delete_matrix(reference);
+        delete_matrix(duel);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int score = 0;
+            for (int b = 0; b < election->rows; b++)
+                score += has_better_score(election->data[b][i],
+                                          election->data[b][j], n);
+            reference->data[i][j] = score;
+        }
+    }
+    reference->rows = reference->columns = n;
+    set_duel_from_ballots(duel, election->ballots);
+    bool same = same_duels(reference, duel);
+
+    // The file is only read back whole while a Matrix holds it
+    if (election->rows < MAX_TAB) {
+        ptrMatrix from_file = init_matrix(true);
+        same &= set_duel_from_file(from_file, (char *)election->path, n) ==
+                    0 &&
+                same_duels(reference, from_file);
+        delete_matrix(from_file);
+    }
+    reference->columns = 0; // No tag to free
+    delete_matrix(reference);
+    delete_matrix(duel);
+    return same;
+}
+
+// format_votes_with_filter against the first choice index
+static bool check_first_choices(const Election *election) {
+    int n = election->cols, totals[MAX_TAB];
+    int *choices = mem_alloc(sizeof(int) * election->rows + 1);
+    FirstChoiceIndex *index = build_first_choice_index(election->ballots);
+    bool same = choices != NULL && index != NULL &&
+                reference_first_choices(election, NULL, 0, choices,
+                                        totals) == 0 &&
+                memcmp(index->totals, totals, sizeof(int) * n) == 0 &&
+                index->offsets[n + 1] == (uint)election->rows;
+    for (int b = 0; same && b < election->rows; b++)
+        same = index->first_choices[b] == choices[b];
+    // Every bucket of the order holds the ballots of its candidate
+    for (int c = 0; same && c <= n; c++) {
+        for (uint k = index->offsets[c]; same && k < index->offsets[c + 1];
+             k++)
+            same = choices[index->order[k]] == (c < n ? c : -1);
+    }
+    if (same && election->rows < MAX_TAB) {
+        ptrMatrix results = first_past_the_post_one_round_results(
+            (char *)election->path, n);
+        same = results != NULL &&
+               memcmp(results->data[election->rows], totals,
+                      sizeof(int) * n) == 0;
+        delete_matrix(results);
+    }
+    delete_first_choice_index(index);
+    mem_free(choices);
+    return same;
+}
+
+// The original two rounds against the runoff on the index
+static bool check_runoff(const Election *election) {
+    int n = election->cols, totals[MAX_TAB], second[MAX_TAB], size;
+    FirstChoiceIndex *index = build_first_choice_index(election->ballots);
+    ptrMatrix results =
+        first_past_the_post_runoff_results(election->ballots, index);
+    if (results == NULL ||
+        reference_first_choices(election, NULL, 0, NULL, totals) != 0 ||
+        memcmp(results->data[0], totals, sizeof(int) * n) != 0) {
+        delete_matrix(results);
+        delete_first_choice_index(index);
+        return false;
+    }
+    int *finalists = get_candidates_for_next_round(totals, n, &size);
+    bool same;
+    if (size != 2 || finalists[1] < 0) {
+        same = results->rows == 1;
+    } else {
+        same = results->rows == 2 &&
+               reference_first_choices(election, finalists, 2, NULL,
+                                       second) == 0 &&
+               memcmp(results->data[1], second, sizeof(int) * n) == 0;
+    }
+    mem_free(finalists);
+    delete_matrix(results);
+    delete_first_choice_index(index);
+    return same;
+}
+
+// Counts of the values read by the reference parser
+static bool check_histogram(const Election *election) {
+    ptrHistogram reference = init_histogram();
+    ptrHistogram histogram = init_histogram();
+    if (reference == NULL || histogram == NULL) {
+        delete_histogram(reference);
+        delete_histogram(histogram);
+        return false;
+    }
+    uint highest = 0;
+    for (int b = 0; b < election->rows; b++) {
+        for (int c = 0; c < election->cols; c++) {
+            uint value = election->data[b][c] > 0 ? election->data[b][c] : 0;
+            reference->counts[c][value]++;
+            highest = value > highest ? value : highest;
+        }
+    }
+    reference->rows = election->cols;
+    reference->columns = highest + 1;
+    reference->ballots = election->rows;
+    set_histogram_from_ballots(histogram, election->ballots);
+    bool same = same_histograms(reference, histogram);
+    delete_histogram(reference);
+    delete_histogram(histogram);
+    return same;
+}
+
+// Tallies counted at once, ballot by ballot, through the cache and merged
+// from two shards
+static bool check_tallies(const Election *election) {
+    char cache[sizeof(election->path) + 16];
+    snprintf(cache, sizeof(cache), "%s.tallies", election->path);
+    ptrTallies whole = init_tallies(), appended = init_tallies();
+    ptrTallies cached = init_tallies(), merged = init_tallies();
+    ptrTallies shards[2] = {init_tallies(), init_tallies()};
+    ptrTallySummary summaries[2] = {init_tally_summary(),
+                                    init_tally_summary()};
+    bool same = whole != NULL && appended != NULL && cached != NULL &&
+                merged != NULL && shards[0] != NULL && shards[1] != NULL &&
+                summaries[0] != NULL && summaries[1] != NULL &&
+                set_tallies_from_file(whole, election->path,
+                                      election->cols) == 0;
+    if (same) {
+        set_candidates(appended, whole->ballots);
+        for (int b = 0; b < election->rows; b++) {
+            append_ballot_to_tallies(appended, election->data[b]);
+            add_ballot(shards[b % 2]->ballots, election->data[b],
+                       election->cols);
+        }
+        for (int k = 0; k < 2; k++) {
+            set_candidates(shards[k], whole->ballots);
+            update_tallies(shards[k]);
+            set_summary_from_tallies(summaries[k], shards[k]);
+        }
+        same = same_tallies(whole, appended) &&
+               write_tallies(whole, cache) == 0 &&
+               read_tallies(cached, cache) == 0 &&
+               same_tallies(whole, cached) &&
+               merge_tally_summaries(summaries[0], summaries[1]) == 0 &&
+               set_tallies_from_summary(merged, summaries[0]) == 0 &&
+               same_tallies(whole, merged);
+    }
+    remove(cache);
+    delete_tallies(whole);
+    delete_tallies(appended);
+    delete_tallies(cached);
+    delete_tallies(merged);
+    for (int k = 0; k < 2; k++) {
+        delete_tallies(shards[k]);
+        delete_tally_summary(summaries[k]);
+    }
+    return same;
+}
+
+// Every scoring rule and truncation policy against a sum ballot by ballot
+static bool check_scoring(const Election *election) {
+    int n = election->cols;
+    ScoringRule rules[3];
+    set_borda_rule(&rules[0], n);
+    set_dowdall_rule(&rules[1], n);
+    set_approval_rule(&rules[2], n, 2);
+    double *scores = mem_alloc(sizeof(double) * 3 * n);
+    double *expected = mem_alloc(sizeof(double) * 3 * n);
+    bool same = scores != NULL && expected != NULL;
+    for (int policy = TRUNCATION_ZERO; same && policy <= TRUNCATION_IGNORE;
+         policy++) {
+        same = compute_scoring_rules(election->ballots, rules, 3, policy,
+                                     scores) == 0;
+        memset(expected, 0, sizeof(double) * 3 * n);
+        for (int b = 0; b < election->rows; b++) {
+            const int *row = election->data[b];
+            int left_out = 0;
+            for (int c = 0; c < n; c++)
+                left_out += row[c] <= 0;
+            if (policy == TRUNCATION_IGNORE && left_out > 0)
+                continue;
+            for (int k = 0; k < 3; k++) {
+                // The candidates left out share the last places
+                double tail = 0;
+                for (int place = n - left_out + 1; place <= n; place++)
+                    tail += rules[k].weights[place];
+                for (int c = 0; c < n; c++) {
+                    if (row[c] > 0)
+                        expected[k * n + c] += rules[k].weights[row[c]];
+                    else if (policy == TRUNCATION_AVERAGE)
+                        expected[k * n + c] += tail / left_out;
+                }
+            }
+        }
+        for (int k = 0; same && k < 3 * n; k++)
+            same = same_score(scores[k], expected[k]);
+    }
+    mem_free(scores);
+    mem_free(expected);
+    return same;
+}
+
+// The Majority Judgement ranking against the grades sorted and their middle
+// removed one at a time
+static bool check_majority_judgement(const Election *election) {
+    int n = election->cols, m = election->rows;
+    CandidateScore *ranking =
+        find_majority_judgement_winner(election->ballots, n);
+    int *sequences = mem_alloc(sizeof(int) * n * m);
+    int *levels = mem_alloc(sizeof(int) * m);
+    bool same = ranking != NULL && sequences != NULL && levels != NULL;
+    for (int c = 0; same && c < n; c++) {
+        // A missing grade is worse than any, 1 is the best
+        for (int b = 0; b < m; b++) {
+            int grade = election->data[b][c];
+            levels[b] = grade > 0 ? MAX_RANK + 1 - grade : 0;
+        }
+        qsort(levels, m, sizeof(int), compare_levels);
+        for (int left = m; left > 0; left--) {
+            int k = (left - 1) / 2;
+            sequences[c * m + m - left] = levels[k];
+            memmove(&levels[k], &levels[k + 1], sizeof(int) * (left - k - 1));
+        }
+    }
+    for (int i = 0; same && i < n; i++) {
+        const int *sequence = &sequences[ranking[i].candidate * m];
+        same = ranking[i].score ==
+               (sequence[0] == 0 ? -1 : MAX_RANK + 1 - sequence[0]);
+        for (int k = 0; same && i + 1 < n && k < m; k++) {
+            int next = sequences[ranking[i + 1].candidate * m + k];
+            if (sequence[k] != next) {
+                same = sequence[k] > next;
+                break;
+            }
+        }
+    }
+    mem_free(ranking);
+    mem_free(sequences);
+    mem_free(levels);
+    return same;
+}
+
+// Bucklin and the median ranks against the ballots rescanned every round
+static bool check_bucklin(const Election *election) {
+    int n = election->cols, round, medians[MAX_TAB];
+    ptrHistogram ranks = init_histogram();
+    if (ranks == NULL)
+        return false;
+    set_histogram_from_ballots(ranks, election->ballots);
+    int winner = find_bucklin_winner(ranks, &round);
+    get_median_ranks(ranks, medians);
+
+    int expected = -1, expected_round = -1, expected_medians[MAX_TAB];
+    int highest = 1;
+    for (int c = 0; c < n; c++) {
+        expected_medians[c] = -1;
+        for (int b = 0; b < election->rows; b++)
+            highest = election->data[b][c] > highest ? election->data[b][c]
+                                                     : highest;
+    }
+    for (int r = 1; r <= highest; r++) {
+        int best = 0, totals[MAX_TAB];
+        for (int c = 0; c < n; c++) {
+            totals[c] = 0;
+            for (int b = 0; b < election->rows; b++) {
+                int rank = election->data[b][c];
+                totals[c] += rank > 0 && rank <= r;
+            }
+            if (totals[c] > totals[best])
+                best = c;
+            if (expected_medians[c] == -1 && totals[c] * 2 > election->rows)
+                expected_medians[c] = r;
+        }
+        // Without a majority, the most ranked candidate wins
+        if (expected_round == -1)
+            expected = best;
+        if (expected_round == -1 && totals[best] * 2 > election->rows)
+            expected_round = r;
+    }
+    bool same = winner == expected && round == expected_round &&
+                memcmp(medians, expected_medians, sizeof(int) * n) == 0;
+    delete_histogram(ranks);
+    return same;
+}
+
+// Baldwin and Nanson summing the Borda scores again from the duels every
+// round, Coombs recounting first and last places from every ballot
+static bool check_elimination(const Election *election) {
+    int n = election->cols;
+    ptrMatrix duel = init_matrix(true);
+    if (duel == NULL)
+        return false;
+    set_duel_from_ballots(duel, election->ballots);
+    long scores[MAX_TAB];
+    bool continuing[MAX_TAB];
+
+    for (int c = 0; c < n; c++)
+        continuing[c] = true;
+    for (int remaining = n; remaining > 1; remaining--) {
+        int loser = -1;
+        for (int c = 0; c < n; c++) {
+            if (!continuing[c])
+                continue;
+            scores[c] = borda_recount(duel, continuing, c);
+            if (loser == -1 || scores[c] <= scores[loser])
+                loser = c;
+        }
+        continuing[loser] = false;
+    }
+    bool same = find_baldwin_winner(duel, n) == first_standing(continuing, n);
+
+    for (int c = 0; c < n; c++)
+        continuing[c] = true;
+    for (int remaining = n, eliminated = 1; remaining > 1 && eliminated > 0;
+         remaining -= eliminated) {
+        long total = 0;
+        for (int c = 0; c < n; c++) {
+            scores[c] = continuing[c] ? borda_recount(duel, continuing, c) : 0;
+            total += scores[c];
+        }
+        eliminated = 0;
+        for (int c = 0; c < n; c++) {
+            if (continuing[c] && scores[c] * remaining < total) {
+                continuing[c] = false;
+                eliminated++;
+            }
+        }
+    }
+    same &= find_nanson_winner(duel, n) == first_standing(continuing, n);
+
+    for (int c = 0; c < n; c++)
+        continuing[c] = true;
+    uint firsts[MAX_TAB], lasts[MAX_TAB], voting;
+    int winner = -1;
+    for (int remaining = n; winner == -1; remaining--) {
+        count_ends(election, continuing, firsts, lasts, &voting);
+        int loser = -1;
+        for (int c = 0; c < n; c++) {
+            if (continuing[c] && winner == -1 &&
+                (remaining == 1 || firsts[c] * 2 > voting))
+                winner = c;
+            if (continuing[c] && (loser == -1 || lasts[c] >= lasts[loser]))
+                loser = c;
+        }
+        if (winner == -1)
+            continuing[loser] = false;
+    }
+    same &= find_coombs_winner(election->ballots) == winner;
+    delete_matrix(duel);
+    return same;
+}
+
+// Smith//IRV, Tideman's Alternative and Woodall against the Smith set found
+// by reachability and first places recounted every round
+static bool check_smith_hybrids(const Election *election) {
+    int n = election->cols;
+    if (n > RECOUNT_CANDIDATES)
+        return true;
+    ptrMatrix duel = init_matrix(true);
+    SmithWinners winners;
+    bool same = duel != NULL;
+    if (same) {
+        set_duel_from_ballots(duel, election->ballots);
+        same = find_smith_hybrid_winners(duel, election->ballots,
+                                         &winners) == 0;
+    }
+    bool all[MAX_TAB], smith[MAX_TAB], continuing[MAX_TAB], kept[MAX_TAB];
+    for (int c = 0; same && c < n; c++)
+        all[c] = true;
+    if (same)
+        reach_smith_set(duel, all, smith);
+
+    int winner = -1;
+    for (int c = 0; same && c < n; c++)
+        continuing[c] = smith[c];
+    while (same && (winner = recount_irv_winner(election, continuing)) == -1)
+        continuing[recount_irv_loser(election, continuing)] = false;
+    same = same && winners.smith_irv == winner;
+
+    for (int c = 0; same && c < n; c++) {
+        continuing[c] = true;
+        kept[c] = smith[c];
+    }
+    for (int remaining = n; same && remaining > 1;) {
+        remaining = 0;
+        for (int c = 0; c < n; c++) {
+            continuing[c] &= kept[c];
+            remaining += continuing[c];
+        }
+        if (remaining > 1) {
+            continuing[recount_irv_loser(election, continuing)] = false;
+            reach_smith_set(duel, continuing, kept);
+        }
+    }
+    same = same && winners.tideman == first_standing(continuing, n);
+
+    int left = 0;
+    for (int c = 0; same && c < n; c++) {
+        continuing[c] = true;
+        left += smith[c];
+    }
+    while (same && left > 1) {
+        int loser = recount_irv_loser(election, continuing);
+        left -= smith[loser];
+        continuing[loser] = false;
+    }
+    for (int c = 0; same && c < n; c++)
+        kept[c] = smith[c] && continuing[c];
+    same = same && winners.woodall == first_standing(kept, n);
+    delete_matrix(duel);
+    return same;
+}
+
+// Schulze against the textbook count, and every withdrawal against the
+// methods counted again on the matrix without that candidate
+static bool check_schulze(const Election *election) {
+    int n = election->cols;
+    ptrMatrix duel = init_matrix(true), reduced = init_matrix(false);
+    if (duel == NULL || reduced == NULL) {
+        delete_matrix(duel);
+        delete_matrix(reduced);
+        return false;
+    }
+    set_duel_from_ballots(duel, election->ballots);
+    bool same = find_schulze_condorcet_winner(duel, n) ==
+                reference_schulze(duel);
+    Withdrawal *withdrawals =
+        n >= 2 && n <= RECOUNT_CANDIDATES ? mem_alloc(sizeof(Withdrawal) * n)
+                                          : NULL;
+    if (withdrawals != NULL)
+        same &= find_withdrawal_winners(duel, n, 2, withdrawals) == 0;
+    for (int w = 0; same && withdrawals != NULL && w < n; w++) {
+        for (int i = 0, r = 0; i < n; i++) {
+            for (int j = 0, k = 0; i != w && j < n; j++) {
+                if (j != w)
+                    reduced->data[r][k++] = duel->data[i][j];
+            }
+            r += i != w;
+        }
+        reduced->rows = reduced->columns = n - 1;
+        // Numbered as in the whole election
+        int condorcet, winners[4];
+        winners[0] =
+            find_condorcet_winner(reduced, n - 1, &condorcet) ? condorcet : -1;
+        winners[1] = find_minimax_condorcet_winner(reduced, n - 1);
+        CandidateScore *ranking =
+            find_ranked_pairs_condorcet_winner(reduced, n - 1);
+        winners[2] = ranking != NULL ? ranking[0].candidate : -1;
+        winners[3] = reference_schulze(reduced);
+        mem_free(ranking);
+        for (int m = 0; m < 4; m++)
+            winners[m] += winners[m] >= w;
+        same = withdrawals[w].condorcet == winners[0] &&
+               withdrawals[w].minimax == winners[1] &&
+               withdrawals[w].ranked_pairs == winners[2] &&
+               withdrawals[w].schulze == winners[3];
+    }
+    mem_free(withdrawals);
+    reduced->columns = 0; // No tag to free
+    delete_matrix(reduced);
+    delete_matrix(duel);
+    return same;
+}
+
+static const struct {
+    const char *name;
+    Check run;
+} checks[] = {{"parsed ballots", check_parse},
+              {"duel matrices", check_pairwise},
+              {"first choices", check_first_choices},
+              {"runoffs", check_runoff},
+              {"histograms", check_histogram},
+              {"tallies", check_tallies},
+              {"scoring rules", check_scoring},
+              {"majority judgements", check_majority_judgement},
+              {"Bucklin counts", check_bucklin},
+              {"elimination winners", check_elimination},
+              {"Smith hybrid winners", check_smith_hybrids},
+              {"Schulze and withdrawal winners", check_schulze}};
+
+#define NB_CHECKS (int)(sizeof(checks) / sizeof(checks[0]))
+
+/*-----------------------------------------------------------------*/
+
+// Draws an election, writes it and runs every check. The file is kept when
+// a check fails.
+static bool run_election(uint64_t seed, uint64_t index,
+                         const char *directory) {
+    Election election = {0};
+    if (draw_election(&election, seed, index) != 0 ||
+        write_election(&election, directory) != 0) {
+        fprintf(stderr, "Could not write election %llu in %s\n",
+                (unsigned long long)index, directory);
+        free_election(&election);
+        return false;
+    }
+    election.ballots = init_ballots();
+    bool same =
+        election.ballots != NULL &&
+        fetch_data(election.path, election.model.nb_candidates,
+                   &election.names, &election.data, &election.rows,
+                   &election.cols) == 0 &&
+        set_ballots_from_file(election.ballots, election.path,
+                              election.model.nb_candidates) == 0;
+    if (!same)
+        fprintf(stderr, "Election %llu cannot be parsed\n",
+                (unsigned long long)index);
+    // The other checks trust the parse
+    for (int k = 0; same && k < NB_CHECKS; k++) {
+        if (!checks[k].run(&election)) {
+            fprintf(stderr,
+                    "Election %llu (%s, %u ballots, %d candidates): the %s "
+                    "differ\n",
+                    (unsigned long long)index, edge_cases[election.edge],
+                    election.nb_ballots, election.model.nb_candidates,
+                    checks[k].name);
+            same = false;
+        }
+    }
+    if (same)
+        remove(election.path);
+    else
+        fprintf(stderr, "Ballots kept in %s\n", election.path);
+    free_election(&election);
+    return same;
+}
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-n elections | -t seconds] [-s seed] "
+            "[-e first election] [-d directory]\n",
+            program);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    long long nb_elections = 100, seconds = 0;
+    uint64_t seed = 1, first = 0;
+    const char *directory = "/tmp";
+    while ((opt = getopt(argc, argv, "n:t:s:e:d:")) != -1) {
+        switch (opt) {
+        case 'n':
+            nb_elections = atoll(optarg);
+            break;
+        case 't':
+            seconds = atoll(optarg);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'e':
+            first = strtoull(optarg, NULL, 10);
+            break;
+        case 'd':
+            directory = optarg;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (nb_elections <= 0 || seconds < 0)
+        usage(argv[0]);
+    // Whatever the libraries allocate must be freed by the end
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    set_thread_allocator(get_tracking_allocator(&tracker));
+
+    // A soak runs until the time is up, the first mismatch stopping it
+    uint64_t deadline = monotonic_ns() + seconds * 1000000000ull;
+    uint64_t index = first;
+    for (; seconds > 0 ? monotonic_ns() < deadline
+                       : index < first + nb_elections;
+         index++) {
+        if (!run_election(seed, index, directory)) {
+            fprintf(stderr, "Replay it with %s -s %llu -e %llu -n 1\n",
+                    argv[0], (unsigned long long)seed,
+                    (unsigned long long)index);
+            return EXIT_FAILURE;
+        }
+    }
+    printf("%llu elections of seed %llu matched\n",
+           (unsigned long long)(index - first), (unsigned long long)seed);
+
+    set_thread_allocator(NULL);
+    if (tracker.total.live != 0) {
+        fprintf(stderr, "%zu bytes were never freed\n", tracker.total.live);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
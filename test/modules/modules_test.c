@@ -1,11 +1,510 @@
+#include "bucklin.h"
 #include "condorcet.h"
+#include "elimination.h"
 #include "first_past_the_post.h"
 #include "majority_judgement.h"
 #include "matrix.h"
+#include "proportional.h"
+#include "scoring_rules.h"
+#include "smith.h"
 #include "stringbuffer.h"
+#include "tracker.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Recounts the second round from every ballot and compares it to the runoff
+static bool check_runoff(const char *filename, int nb_candidates,
+                         ptrMatrix results) {
+    if (results->rows < 2)
+        return true;
+    ptrBallots ballots = init_ballots();
+    set_ballots_from_file(ballots, filename, nb_candidates);
+    int finalists[2], nb_finalists = 0;
+    for (uint c = 0; c < results->columns && nb_finalists < 2; c++) {
+        if (results->data[1][c] != 0)
+            finalists[nb_finalists++] = c;
+    }
+    int expected[2] = {0, 0};
+    for (uint i = 0; i < ballots->rows && nb_finalists == 2; i++) {
+        rank_t a = get_ballot_rank(ballots, i, finalists[0]);
+        rank_t b = get_ballot_rank(ballots, i, finalists[1]);
+        if (a != RANK_NONE && (b == RANK_NONE || a < b))
+            expected[0]++;
+        else if (b != RANK_NONE && (a == RANK_NONE || b < a))
+            expected[1]++;
+    }
+    delete_ballots(ballots);
+    return nb_finalists == 2 &&
+           expected[0] == results->data[1][finalists[0]] &&
+           expected[1] == results->data[1][finalists[1]];
+}
+
+// Scores every ballot one by one and compares it to the histogram engine
+static bool check_scoring(const char *filename, int nb_candidates) {
+    ptrBallots ballots = init_ballots();
+    set_ballots_from_file(ballots, filename, nb_candidates);
+    ScoringRule rules[2];
+    set_borda_rule(&rules[0], nb_candidates);
+    set_approval_rule(&rules[1], nb_candidates, 2);
+    double *scores = calloc(2 * nb_candidates, sizeof(double));
+    compute_scoring_rules(ballots, rules, 2, TRUNCATION_ZERO, scores);
+    bool same = true;
+    for (int k = 0; k < 2; k++) {
+        for (int c = 0; c < nb_candidates; c++) {
+            double expected = 0;
+            for (uint i = 0; i < ballots->rows; i++)
+                expected += rules[k].weights[get_ballot_rank(ballots, i, c)];
+            same &= expected == scores[k * nb_candidates + c];
+        }
+    }
+    free(scores);
+    delete_ballots(ballots);
+
+    // Under AVERAGE, the candidates a ballot leaves out share its last
+    // places, even when the ones it ranks are tied
+    ptrBallots truncated = init_ballots();
+    int tied[3] = {1, 1, 0}, single[3] = {1, 0, 0};
+    add_ballot(truncated, tied, 3);
+    add_ballot(truncated, single, 3);
+    set_borda_rule(&rules[0], 3);
+    double average[3];
+    compute_scoring_rules(truncated, rules, 1, TRUNCATION_AVERAGE, average);
+    same &= average[0] == 4 && average[1] == 2.5 && average[2] == 0.5;
+    delete_ballots(truncated);
+    return same;
+}
+
+// Replays Bucklin by scanning the ballots at every round
+static bool check_bucklin(const char *filename, int nb_candidates) {
+    ptrBallots ballots = init_ballots();
+    ptrHistogram ranks = init_histogram();
+    set_ballots_from_file(ballots, filename, nb_candidates);
+    set_histogram_from_ballots(ranks, ballots);
+    int round, winner = find_bucklin_winner(ranks, &round);
+    CandidateScore *ranking = median_rank_ranking(ranks);
+    int expected = -1, expected_round = -1;
+    for (int r = 1; r <= MAX_RANK && expected == -1; r++) {
+        uint best = 0, best_total = 0;
+        for (int c = 0; c < nb_candidates; c++) {
+            uint total = 0;
+            for (uint i = 0; i < ballots->rows; i++) {
+                rank_t rank = get_ballot_rank(ballots, i, c);
+                total += rank != RANK_NONE && rank <= r;
+            }
+            if (total > best_total) {
+                best = c;
+                best_total = total;
+            }
+        }
+        if (best_total * 2 > ballots->rows) {
+            expected = best;
+            expected_round = r;
+        }
+    }
+    bool same = winner == expected && round == expected_round &&
+                ranking[0].candidate == winner;
+    mem_free(ranking);
+    delete_histogram(ranks);
+    delete_ballots(ballots);
+
+    // Ballots ranking a single candidate each leave no majority, the one
+    // ranked on the most ballots wins without a deciding round
+    ptrBallots truncated = init_ballots();
+    int rows[4][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 0}};
+    for (int i = 0; i < 4; i++)
+        add_ballot(truncated, rows[i], 3);
+    ranks = init_histogram();
+    set_histogram_from_ballots(ranks, truncated);
+    same &= find_bucklin_winner(ranks, &round) == 0 && round == -1;
+    delete_histogram(ranks);
+    delete_ballots(truncated);
+    return same;
+}
+
+// Grade level of a ballot value, the higher the better (missing is worst)
+static int grade_level(rank_t grade) {
+    return grade == RANK_NONE ? 0 : MAX_RANK + 1 - grade;
+}
+
+static int compare_levels(const void *first, const void *second) {
+    return *(const int *)first - *(const int *)second;
+}
+
+// Removes the middle grade one at a time and checks first is not beaten
+static bool check_majority_judgement(const Ballots *ballots, int first,
+                                     int second) {
+    int n = ballots->rows;
+    int *a = malloc(sizeof(int) * n + 1), *b = malloc(sizeof(int) * n + 1);
+    for (int i = 0; i < n; i++) {
+        a[i] = grade_level(get_ballot_rank(ballots, i, first));
+        b[i] = grade_level(get_ballot_rank(ballots, i, second));
+    }
+    qsort(a, n, sizeof(int), compare_levels);
+    qsort(b, n, sizeof(int), compare_levels);
+    int result = 0;
+    for (int m = n; m > 0 && result == 0; m--) {
+        int k = (m - 1) / 2;
+        result = a[k] - b[k];
+        for (int i = k; i + 1 < m; i++) {
+            a[i] = a[i + 1];
+            b[i] = b[i + 1];
+        }
+    }
+    free(a);
+    free(b);
+    return result >= 0;
+}
+
+// Recomputes every quotient for every seat and compares it to the heap, on
+// the totals row of the first round
+static bool check_seats(const char *filename, int nb_candidates,
+                        ptrMatrix results) {
+    ptrBallots ballots = init_ballots();
+    set_ballots_from_file(ballots, filename, nb_candidates);
+    FirstChoiceIndex *index = build_first_choice_index(ballots);
+    const int *votes = results->data[results->rows - 1];
+    int nb_lists = results->columns;
+    bool same = true;
+    for (int i = 0; i < nb_lists; i++)
+        same &= votes[i] == index->totals[i];
+
+    int allocated[MAX_TAB], expected[MAX_TAB];
+    for (int seats = 0; seats <= 3 * nb_lists; seats++) {
+        for (int step = 1; step <= 2; step++) {
+            allocate_seats(votes, nb_lists, seats,
+                           step == 1 ? SEATS_DHONDT : SEATS_SAINTE_LAGUE,
+                           allocated);
+            for (int i = 0; i < nb_lists; i++)
+                expected[i] = 0;
+            for (int seat = 0; seat < seats; seat++) {
+                int best = 0;
+                for (int i = 1; i < nb_lists; i++) {
+                    long left = (long)votes[i] * (step * expected[best] + 1);
+                    long right = (long)votes[best] * (step * expected[i] + 1);
+                    if (left > right ||
+                        (left == right && votes[i] > votes[best]))
+                        best = i;
+                }
+                expected[best]++;
+            }
+            for (int i = 0; i < nb_lists; i++)
+                same &= allocated[i] == expected[i];
+        }
+        for (int method = SEATS_HARE; method <= SEATS_DROOP; method++) {
+            allocate_seats(votes, nb_lists, seats, method, allocated);
+            int total = 0;
+            for (int i = 0; i < nb_lists; i++) {
+                total += allocated[i];
+                same &= votes[i] > 0 || allocated[i] == 0;
+            }
+            same &= total == seats;
+        }
+    }
+    // Three votes leave Droop 7 of 10 seats, for the two lists with votes
+    int few[4] = {2, 1, 0, 0};
+    allocate_seats(few, 4, 10, SEATS_DROOP, allocated);
+    same &= allocated[0] == 6 && allocated[1] == 4 && allocated[2] == 0 &&
+            allocated[3] == 0;
+    delete_first_choice_index(index);
+    delete_ballots(ballots);
+    return same;
+}
+
+// Finds the continuing candidates reaching every other continuing one by a
+// path of duels they do not lose
+static void reach_smith_set(ptrMatrix duel, int nb_candidates,
+                            const bool *continuing, bool *smith) {
+    static bool reach[MAX_TAB][MAX_TAB];
+    for (int i = 0; i < nb_candidates; i++) {
+        for (int j = 0; j < nb_candidates; j++)
+            reach[i][j] = i == j || duel->data[i][j] >= duel->data[j][i];
+    }
+    for (int k = 0; k < nb_candidates; k++) {
+        for (int i = 0; i < nb_candidates && continuing[k]; i++) {
+            for (int j = 0; j < nb_candidates; j++)
+                reach[i][j] |= reach[i][k] && reach[k][j];
+        }
+    }
+    for (int i = 0; i < nb_candidates; i++) {
+        smith[i] = continuing[i];
+        for (int j = 0; j < nb_candidates && smith[i]; j++)
+            smith[i] = !continuing[j] || reach[i][j];
+    }
+}
+
+// Compares the Smith set to the one found by reachability
+static bool check_smith_set(ptrMatrix duel, int nb_candidates) {
+    bool all[MAX_TAB], expected[MAX_TAB], smith[MAX_TAB], same = true;
+    for (int i = 0; i < nb_candidates; i++)
+        all[i] = true;
+    reach_smith_set(duel, nb_candidates, all, expected);
+    find_smith_set(duel, nb_candidates, NULL, smith);
+    for (int i = 0; i < nb_candidates; i++)
+        same &= smith[i] == expected[i];
+    return same;
+}
+
+// The strongest paths and the winner of the Schulze example of Wikipedia,
+// 45 voters over A to E
+static bool check_schulze(void) {
+    static const int duels[5][5] = {{0, 20, 26, 30, 22},
+                                    {25, 0, 16, 33, 18},
+                                    {19, 29, 0, 17, 24},
+                                    {15, 12, 28, 0, 14},
+                                    {23, 27, 21, 31, 0}};
+    static const int strongest[5][5] = {{0, 28, 28, 30, 24},
+                                        {25, 0, 28, 33, 24},
+                                        {25, 29, 0, 29, 24},
+                                        {25, 28, 28, 0, 24},
+                                        {25, 28, 28, 31, 0}};
+    ptrMatrix duel = init_matrix(true);
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++)
+            duel->data[i][j] = duels[i][j];
+    }
+    int paths[5 * 5];
+    init_schulze_paths(duel, 5, paths);
+    widen_schulze_paths(paths, 5, 0, 5);
+    bool same = find_schulze_condorcet_winner(duel, 5) == 4;
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++)
+            same &= paths[i * 5 + j] == strongest[i][j];
+    }
+    delete_matrix(duel);
+    return same;
+}
+
+// Ballots ranking only some of the four candidates, with a tie and a blank
+static ptrBallots truncated_ballots(void) {
+    static const int rows[][4] = {
+        {1, 2, 0, 0}, {1, 2, 0, 0}, {0, 1, 2, 0}, {2, 0, 1, 0},
+        {1, 1, 2, 0}, {3, 1, 2, 0}, {1, 0, 0, 0}, {0, 2, 1, 3},
+        {0, 0, 1, 2}, {1, 1, 0, 0}, {0, 0, 0, 0}, {2, 3, 1, 0}};
+    ptrBallots ballots = init_ballots();
+    for (uint i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+        add_ballot(ballots, rows[i], 4);
+    return ballots;
+}
+
+// Truncated ballots over five candidates whose Smith set is a cycle, so
+// each hybrid method has something to decide
+static ptrBallots cyclic_ballots(void) {
+    static const int rows[][5] = {
+        {3, 4, 2, 1, 0}, {2, 5, 4, 3, 1}, {0, 2, 0, 1, 0}, {4, 3, 1, 2, 0},
+        {0, 1, 2, 0, 0}, {4, 3, 5, 2, 1}, {2, 3, 0, 1, 0}, {2, 3, 0, 1, 4},
+        {0, 0, 3, 2, 1}, {0, 0, 0, 2, 1}, {0, 0, 0, 0, 1}, {0, 3, 0, 2, 1},
+        {1, 2, 4, 3, 5}};
+    ptrBallots ballots = init_ballots();
+    for (uint i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+        add_ballot(ballots, rows[i], 5);
+    return ballots;
+}
+
+// Counts from scratch the continuing candidate ranked first (alone) and last
+// (alone, unranked being last) on every ballot
+static void count_ends(const Ballots *ballots, const bool *continuing,
+                       uint *firsts, uint *lasts, uint *voting) {
+    int nb_candidates = ballots->columns;
+    *voting = 0;
+    for (int c = 0; c < nb_candidates; c++)
+        firsts[c] = lasts[c] = 0;
+    for (uint i = 0; i < ballots->rows; i++) {
+        int top = -1, bottom = -1, best = MAX_RANK + 2, worst = -1;
+        bool top_tied = false, bottom_tied = false;
+        for (int c = 0; c < nb_candidates; c++) {
+            if (!continuing[c])
+                continue;
+            rank_t rank = get_ballot_rank(ballots, i, c);
+            int key = rank == RANK_NONE ? MAX_RANK + 1 : rank;
+            if (rank != RANK_NONE && key <= best) {
+                top_tied = key == best;
+                top = c;
+                best = key;
+            }
+            if (key >= worst) {
+                bottom_tied = key == worst;
+                bottom = c;
+                worst = key;
+            }
+        }
+        *voting += top != -1;
+        if (top != -1 && !top_tied)
+            firsts[top]++;
+        if (bottom != -1 && !bottom_tied)
+            lasts[bottom]++;
+    }
+}
+
+// Borda score over the continuing candidates, recounted from every ballot
+static long borda_recount(const Ballots *ballots, const bool *continuing,
+                          int candidate) {
+    long score = 0;
+    for (uint i = 0; i < ballots->rows; i++) {
+        rank_t rank = get_ballot_rank(ballots, i, candidate);
+        for (uint c = 0; c < ballots->columns && rank != RANK_NONE; c++) {
+            rank_t other = get_ballot_rank(ballots, i, c);
+            score += continuing[c] && other != RANK_NONE && rank < other;
+        }
+    }
+    return score;
+}
+
+static int first_standing(const bool *continuing, int nb_candidates) {
+    for (int c = 0; c < nb_candidates; c++) {
+        if (continuing[c])
+            return c;
+    }
+    return -1;
+}
+
+// Replays Baldwin, Nanson and Coombs with a full recount every round
+static bool check_elimination(const Ballots *ballots) {
+    int nb_candidates = ballots->columns;
+    ptrMatrix duel = init_matrix(true);
+    set_duel_from_ballots(duel, ballots);
+    long scores[MAX_TAB];
+    bool continuing[MAX_TAB];
+
+    for (int c = 0; c < nb_candidates; c++)
+        continuing[c] = true;
+    for (int remaining = nb_candidates; remaining > 1; remaining--) {
+        int loser = -1;
+        for (int c = 0; c < nb_candidates; c++) {
+            if (!continuing[c])
+                continue;
+            scores[c] = borda_recount(ballots, continuing, c);
+            if (loser == -1 || scores[c] <= scores[loser])
+                loser = c;
+        }
+        continuing[loser] = false;
+    }
+    bool same = find_baldwin_winner(duel, nb_candidates) ==
+                first_standing(continuing, nb_candidates);
+
+    for (int c = 0; c < nb_candidates; c++)
+        continuing[c] = true;
+    for (int remaining = nb_candidates, eliminated = 1;
+         remaining > 1 && eliminated > 0; remaining -= eliminated) {
+        long total = 0;
+        for (int c = 0; c < nb_candidates; c++) {
+            scores[c] = continuing[c] ? borda_recount(ballots, continuing, c)
+                                      : 0;
+            total += scores[c];
+        }
+        eliminated = 0;
+        for (int c = 0; c < nb_candidates; c++) {
+            if (continuing[c] && scores[c] * remaining < total) {
+                continuing[c] = false;
+                eliminated++;
+            }
+        }
+    }
+    same &= find_nanson_winner(duel, nb_candidates) ==
+            first_standing(continuing, nb_candidates);
+
+    for (int c = 0; c < nb_candidates; c++)
+        continuing[c] = true;
+    uint firsts[MAX_TAB], lasts[MAX_TAB], voting;
+    int winner = -1;
+    for (int remaining = nb_candidates; winner == -1; remaining--) {
+        count_ends(ballots, continuing, firsts, lasts, &voting);
+        int loser = -1;
+        for (int c = 0; c < nb_candidates; c++) {
+            if (continuing[c] && winner == -1 &&
+                (remaining == 1 || firsts[c] * 2 > voting))
+                winner = c;
+            if (continuing[c] && (loser == -1 || lasts[c] >= lasts[loser]))
+                loser = c;
+        }
+        if (winner == -1)
+            continuing[loser] = false;
+    }
+    same &= find_coombs_winner(ballots) == winner;
+    delete_matrix(duel);
+    return same;
+}
+
+// Instant-runoff loser over first places recounted from every ballot, the
+// last one among ties
+static int recount_irv_loser(const Ballots *ballots, const bool *continuing) {
+    uint firsts[MAX_TAB], lasts[MAX_TAB], voting;
+    count_ends(ballots, continuing, firsts, lasts, &voting);
+    int loser = -1;
+    for (uint c = 0; c < ballots->columns; c++) {
+        if (continuing[c] && (loser == -1 || firsts[c] <= firsts[loser]))
+            loser = c;
+    }
+    return loser;
+}
+
+// Continuing candidate with a strict majority of the ballots still ranking
+// someone or left alone, -1 if there is none yet
+static int recount_irv_winner(const Ballots *ballots, const bool *continuing) {
+    uint firsts[MAX_TAB], lasts[MAX_TAB], voting;
+    count_ends(ballots, continuing, firsts, lasts, &voting);
+    int remaining = 0, last = -1;
+    for (uint c = 0; c < ballots->columns; c++) {
+        if (continuing[c] && firsts[c] * 2 > voting)
+            return c;
+        remaining += continuing[c];
+        last = continuing[c] ? (int)c : last;
+    }
+    return remaining == 1 ? last : -1;
+}
+
+// Replays Smith//IRV, Tideman's Alternative and Woodall, recomputing the
+// Smith set by reachability and the first places from scratch every round
+static bool check_smith_hybrids(const Ballots *ballots) {
+    int nb_candidates = ballots->columns;
+    ptrMatrix duel = init_matrix(true);
+    set_duel_from_ballots(duel, ballots);
+    SmithWinners winners;
+    bool same = find_smith_hybrid_winners(duel, ballots, &winners) == 0;
+    bool all[MAX_TAB], smith[MAX_TAB], continuing[MAX_TAB], kept[MAX_TAB];
+    for (int c = 0; c < nb_candidates; c++)
+        all[c] = true;
+    reach_smith_set(duel, nb_candidates, all, smith);
+
+    int winner;
+    for (int c = 0; c < nb_candidates; c++)
+        continuing[c] = smith[c];
+    while ((winner = recount_irv_winner(ballots, continuing)) == -1)
+        continuing[recount_irv_loser(ballots, continuing)] = false;
+    same &= winners.smith_irv == winner;
+
+    for (int c = 0; c < nb_candidates; c++)
+        continuing[c] = kept[c] = true;
+    reach_smith_set(duel, nb_candidates, continuing, kept);
+    while (true) {
+        int remaining = 0;
+        for (int c = 0; c < nb_candidates; c++) {
+            continuing[c] &= kept[c];
+            remaining += continuing[c];
+        }
+        if (remaining == 1)
+            break;
+        continuing[recount_irv_loser(ballots, continuing)] = false;
+        reach_smith_set(duel, nb_candidates, continuing, kept);
+    }
+    same &= winners.tideman == first_standing(continuing, nb_candidates);
+
+    int left = 0;
+    for (int c = 0; c < nb_candidates; c++) {
+        continuing[c] = true;
+        left += smith[c];
+    }
+    while (left > 1) {
+        int loser = recount_irv_loser(ballots, continuing);
+        left -= smith[loser];
+        continuing[loser] = false;
+    }
+    for (int c = 0; c < nb_candidates; c++)
+        kept[c] = smith[c] && continuing[c];
+    same &= winners.woodall == first_standing(kept, nb_candidates);
+    delete_matrix(duel);
+    return same;
+}
+
 int main(int argc, char **argv) {
     printf("\n");
     if (argc != 4) {
@@ -20,23 +519,46 @@ int main(int argc, char **argv) {
         perror("sscanf failed");
         exit(EXIT_FAILURE);
     }
+    // Whatever the libraries allocate must be freed by the end
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    set_thread_allocator(get_tracking_allocator(&tracker));
 
     // First round results
     Matrix *results =
         first_past_the_post_one_round_results(argv[1], nb_candidates);
     print_matrix(results, " | ");
     printf("\n");
+    if (!check_seats(argv[1], nb_candidates, results)) {
+        fprintf(stderr, "Seat allocation does not match the totals\n");
+        exit(EXIT_FAILURE);
+    }
 
     // Second round results
     delete_matrix(results);
     results = first_past_the_post_two_round_results(argv[1], nb_candidates);
     print_matrix(results, " | ");
     printf("\n");
+    if (!check_runoff(argv[1], nb_candidates, results)) {
+        fprintf(stderr, "Second round does not match the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!check_bucklin(argv[1], nb_candidates)) {
+        fprintf(stderr, "Bucklin does not match the ballots\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!check_scoring(argv[1], nb_candidates)) {
+        fprintf(stderr, "Scoring rules do not match the ballots\n");
+        exit(EXIT_FAILURE);
+    }
 
     if (majority_judgement == 0) {
         // Condorcet winner
         ptrMatrix matrix = init_matrix(true);
-        set_duel_from_file(matrix, argv[1], nb_candidates);
+        if (set_duel_from_file(matrix, argv[1], nb_candidates) != 0) {
+            fprintf(stderr, "Could not read the duels of %s\n", argv[1]);
+            exit(EXIT_FAILURE);
+        }
         int winner;
         bool hasWinner = find_condorcet_winner(matrix, nb_candidates, &winner);
         if (hasWinner) {
@@ -65,6 +587,7 @@ int main(int argc, char **argv) {
                    matrix->tags[ranked_pairs_winners[i].candidate]->string);
             printf(" %d\n", ranked_pairs_winners[i].score);
         }
+        mem_free(ranked_pairs_winners);
 
         // Schulze Condorcet winner
         int schulze_winner =
@@ -72,22 +595,92 @@ int main(int argc, char **argv) {
         printf("\nSchulze Condorcet winner is candidate : ");
         print_stringbuffer(matrix->tags[schulze_winner], STDOUT, "");
         printf("\n");
+
+        // Elimination methods, the duel matrix built from the ballot store
+        // must be the one built from the file
+        ptrBallots ballots = init_ballots();
+        ptrMatrix duel = init_matrix(true);
+        set_ballots_from_file(ballots, argv[1], nb_candidates);
+        set_duel_from_ballots(duel, ballots);
+        for (int i = 0; i < nb_candidates; i++) {
+            for (int j = 0; j < nb_candidates; j++) {
+                if (duel->data[i][j] != matrix->data[i][j]) {
+                    fprintf(stderr, "Duel matrices differ\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+        }
+        printf("\nBaldwin winner is candidate : ");
+        print_stringbuffer(
+            duel->tags[find_baldwin_winner(duel, nb_candidates)], STDOUT, "");
+        printf("\nNanson winner is candidate : ");
+        print_stringbuffer(
+            duel->tags[find_nanson_winner(duel, nb_candidates)], STDOUT, "");
+        printf("\nCoombs winner is candidate : ");
+        print_stringbuffer(ballots->tags[find_coombs_winner(ballots)], STDOUT,
+                           "");
+        ptrBallots truncated = truncated_ballots();
+        if (!check_elimination(ballots) || !check_elimination(truncated)) {
+            fprintf(stderr, "Elimination winners do not match a recount\n");
+            exit(EXIT_FAILURE);
+        }
+        if (!check_smith_set(duel, nb_candidates)) {
+            fprintf(stderr, "Smith set does not match the duels\n");
+            exit(EXIT_FAILURE);
+        }
+        if (!check_schulze()) {
+            fprintf(stderr, "Schulze paths do not match the example\n");
+            exit(EXIT_FAILURE);
+        }
+        SmithWinners smith_winners;
+        find_smith_hybrid_winners(duel, ballots, &smith_winners);
+        printf("\nSmith//IRV winner is candidate : ");
+        print_stringbuffer(duel->tags[smith_winners.smith_irv], STDOUT, "");
+        printf("\nTideman's Alternative winner is candidate : ");
+        print_stringbuffer(duel->tags[smith_winners.tideman], STDOUT, "");
+        printf("\nWoodall winner is candidate : ");
+        print_stringbuffer(duel->tags[smith_winners.woodall], STDOUT, "");
+        ptrBallots cyclic = cyclic_ballots();
+        if (!check_smith_hybrids(ballots) || !check_smith_hybrids(truncated) ||
+            !check_smith_hybrids(cyclic)) {
+            fprintf(stderr, "Smith hybrid winners do not match a recount\n");
+            exit(EXIT_FAILURE);
+        }
+        delete_ballots(cyclic);
+        delete_ballots(truncated);
+        delete_matrix(duel);
+        delete_ballots(ballots);
         delete_matrix(matrix);
     } else {
         // Majority Judgement winner
-        set_matrix_from_file(results, argv[1], nb_candidates);
+        ptrBallots ballots = init_ballots();
+        set_ballots_from_file(ballots, argv[1], nb_candidates);
         CandidateScore *majority_judgement_winners =
-            find_majority_judgement_winner(results, nb_candidates);
-        printf("\n%20s | %s\n", "Candidate", "Score");
+            find_majority_judgement_winner(ballots, nb_candidates);
+        printf("\n%20s | %s\n", "Candidate", "Grade");
         printf("%20s-|-%s\n", "-------------------", "-----");
         for (int i = 0; i < nb_candidates; i++) {
             printf(
                 "%20s | ",
-                results->tags[majority_judgement_winners[i].candidate]->string);
+                ballots->tags[majority_judgement_winners[i].candidate]->string);
             printf(" %d\n", majority_judgement_winners[i].score);
         }
+        for (int i = 0; i + 1 < nb_candidates; i++) {
+            if (!check_majority_judgement(
+                    ballots, majority_judgement_winners[i].candidate,
+                    majority_judgement_winners[i + 1].candidate)) {
+                fprintf(stderr, "Majority Judgement ranking is wrong\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        mem_free(majority_judgement_winners);
+        delete_ballots(ballots);
     }
 
     delete_matrix(results);
+    if (tracker.total.live != 0) {
+        fprintf(stderr, "%zu bytes were never freed\n", tracker.total.live);
+        return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
 }
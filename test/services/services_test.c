@@ -0,0 +1,580 @@
+#include "allocator.h"
+#include "batch.h"
+#include "bootstrap.h"
+#include "condorcet.h"
+#include "majority_judgement.h"
+#include "margin.h"
+#include "server.h"
+#include "withdrawal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Counts a batch and returns its records, NULL if it cannot
+static char *count_batch(const char *path, enum Method method,
+                         int nb_workers) {
+    ElectionOptions options;
+    init_election_options(&options, method);
+    ptrBatch batch = init_batch(&options, "test", NULL);
+    if (batch == NULL || add_batch_path(batch, path) <= 0 ||
+        run_batch(batch, nb_workers) != 0) {
+        delete_batch(batch);
+        return NULL;
+    }
+
+    // Every record must match the same election counted on its own
+    ptrTallies tallies = init_tallies();
+    for (uint i = 0; i < batch->nb_jobs; i++) {
+        const BatchJob *job = &batch->jobs[i];
+        if (job->error != NULL)
+            continue;
+        if (load_tallies(tallies, NULL, job->path, job->nb_candidates) != 0 ||
+            find_election_winner(tallies, &options) != job->winner) {
+            fprintf(stderr, "%s: batch winner differs\n", job->path);
+            exit(EXIT_FAILURE);
+        }
+    }
+    delete_tallies(tallies);
+
+    // The records go through a writer on a file, then are read back
+    char records_path[] = "/tmp/batch_recordsXXXXXX";
+    int fd = mkstemp(records_path);
+    if (fd < 0) {
+        delete_batch(batch);
+        return NULL;
+    }
+    close(fd);
+    ptrWriter writer = open_writer(records_path, FORMAT_JSON);
+    if (writer != NULL)
+        write_batch_records(batch, writer);
+    delete_batch(batch);
+    char *records = NULL;
+    FILE *file = close_writer(writer) == 0 ? fopen(records_path, "r")
+                                           : NULL;
+    if (file != NULL) {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        rewind(file);
+        records = calloc(size + 1, 1);
+        if (records != NULL && fread(records, 1, size, file) != (size_t)size) {
+            free(records);
+            records = NULL;
+        }
+        fclose(file);
+    }
+    unlink(records_path);
+    return records;
+}
+
+static void *run_server(void *socket_path) {
+    return (void *)(long)serve_elections(socket_path);
+}
+
+// Sends a request and returns the status of the reply
+static int query(int fd, Message *request, Message *reply) {
+    if (send_message(fd, request) != 0 || receive_message(fd, reply) != 0) {
+        fprintf(stderr, "The server closed the connection\n");
+        exit(EXIT_FAILURE);
+    }
+    clear_message(request);
+    return (int)get_u32(reply);
+}
+
+static int query_winner(int fd, Message *request, Message *reply,
+                        const char *method, bool *cached) {
+    put_u8(request, REQUEST_WINNER);
+    put_string(request, "test");
+    put_string(request, method);
+    if (query(fd, request, reply) != 0)
+        return -1;
+    int winner = get_u32(reply);
+    char name[MAX_ELECTION_NAME];
+    get_string(reply, name, sizeof(name));
+    *cached = get_u8(reply);
+    return winner;
+}
+
+// Enough duel matrices to fill the socket of a client that does not read
+#define SLOW_REQUESTS 2000
+
+// A resident election answers as the file counted on its own, from the
+// cache until ballots are appended
+static bool test_server(const char *path) {
+    char socket_path[] = "services_test.sock";
+    pthread_t server;
+    pthread_create(&server, NULL, run_server, socket_path);
+    int fd = -1;
+    for (int attempt = 0; attempt < 100 && fd < 0; attempt++) {
+        fd = connect_to_server(socket_path);
+        if (fd < 0)
+            nanosleep(&(struct timespec){0, 10000000}, NULL);
+    }
+    if (fd < 0)
+        return false;
+
+    Message request, reply;
+    init_message(&request);
+    init_message(&reply);
+    int nb_candidates = infer_candidate_count(path);
+    put_u8(&request, REQUEST_OPEN);
+    put_string(&request, "test");
+    put_string(&request, path);
+    put_u32(&request, 0);
+    bool passed = query(fd, &request, &reply) == 0 &&
+                  (int)get_u32(&reply) == nb_candidates;
+
+    ptrTallies tallies = init_tallies();
+    ElectionOptions options;
+    init_election_options(&options, CS);
+    load_tallies(tallies, NULL, path, nb_candidates);
+    bool cached;
+    passed &= query_winner(fd, &request, &reply, "cs", &cached) ==
+                  find_election_winner(tallies, &options) &&
+              !cached;
+    passed &= query_winner(fd, &request, &reply, "cs", &cached) >= 0 && cached;
+
+    // A client that does not read its replies, more than its socket holds,
+    // does not hold up the others, and gets them all once it reads
+    int slow = connect_to_server(socket_path);
+    Message burst;
+    init_message(&burst);
+    put_u8(&request, REQUEST_DUEL);
+    put_string(&request, "test");
+    for (int i = 0; i < SLOW_REQUESTS; i++)
+        put_frame(&burst, &request);
+    clear_message(&request);
+    // In one go, as the server reads no more of a client it owes replies
+    while (slow >= 0 && burst.offset < burst.size) {
+        ssize_t sent = write(slow, burst.data + burst.offset,
+                             burst.size - burst.offset);
+        if (sent <= 0)
+            break;
+        burst.offset += sent;
+    }
+    passed &= burst.offset == burst.size;
+    release_message(&burst);
+    nanosleep(&(struct timespec){0, 50000000}, NULL);
+    passed &= slow >= 0 &&
+              query_winner(fd, &request, &reply, "cs", &cached) >= 0 &&
+              cached;
+    for (int i = 0; i < SLOW_REQUESTS && passed; i++)
+        passed &= receive_message(slow, &reply) == 0 &&
+                  get_u32(&reply) == 0 &&
+                  (int)get_u32(&reply) == nb_candidates;
+    close(slow);
+
+    // Append the same ballot a hundred times, ranking the last candidate
+    // first and nobody else
+    int row[MAX_TAB] = {0};
+    row[nb_candidates - 1] = 1;
+    put_u8(&request, REQUEST_APPEND);
+    put_string(&request, "test");
+    put_u32(&request, 100);
+    for (int i = 0; i < 100; i++) {
+        for (int c = 0; c < nb_candidates; c++)
+            put_u8(&request, row[c]);
+        append_ballot_to_tallies(tallies, row);
+    }
+    passed &= query(fd, &request, &reply) == 0 &&
+              get_u32(&reply) == tallies->ballots->rows;
+    // A truncated append adds none of the ballots it holds
+    put_u8(&request, REQUEST_APPEND);
+    put_string(&request, "test");
+    put_u32(&request, 3);
+    for (int c = 0; c < 2 * nb_candidates; c++)
+        put_u8(&request, row[c % nb_candidates]);
+    passed &= query(fd, &request, &reply) == -1;
+    put_u8(&request, REQUEST_APPEND);
+    put_string(&request, "test");
+    put_u32(&request, 0);
+    passed &= query(fd, &request, &reply) == 0 &&
+              get_u32(&reply) == tallies->ballots->rows;
+    init_election_options(&options, BORDA);
+    passed &= query_winner(fd, &request, &reply, "borda", &cached) ==
+                  find_election_winner(tallies, &options) &&
+              !cached;
+    passed &= query_winner(fd, &request, &reply, "nope", &cached) == -1;
+
+    // The ranking counts the appended ballots too
+    CandidateScore *ranking = majority_judgement_ranking(tallies->histogram);
+    put_u8(&request, REQUEST_RANKING);
+    put_string(&request, "test");
+    passed &= ranking != NULL && query(fd, &request, &reply) == 0 &&
+              (int)get_u32(&reply) == nb_candidates;
+    for (int c = 0; c < nb_candidates && passed; c++) {
+        char name[MAX_ELECTION_NAME];
+        passed &= (int)get_u32(&reply) == ranking[c].candidate &&
+                  (int)get_u32(&reply) == ranking[c].score &&
+                  get_string(&reply, name, sizeof(name)) &&
+                  strcmp(name, tallies->ballots->tags[ranking[c].candidate]
+                                   ->string) == 0;
+    }
+    mem_free(ranking);
+
+    put_u8(&request, REQUEST_STOP);
+    passed &= query(fd, &request, &reply) == 0;
+    void *status;
+    pthread_join(server, &status);
+    passed &= status == NULL;
+    close(fd);
+    release_message(&request);
+    release_message(&reply);
+    delete_tallies(tallies);
+    return passed;
+}
+
+// Resamples do not depend on the number of workers, and an election where
+// everybody agrees has the same winner in every resample
+static bool test_bootstrap(const char *path) {
+    ptrTallies tallies = init_tallies();
+    int nb_candidates = infer_candidate_count(path);
+    if (load_tallies(tallies, NULL, path, nb_candidates) != 0)
+        return false;
+    BallotProfile *profile = init_ballot_profile(tallies->ballots);
+    uint voters = 0;
+    for (uint d = 0; d < profile->nb_distinct; d++) {
+        voters += profile->counts[d];
+        for (uint e = 0; e < d; e++) {
+            if (memcmp(&profile->ranks[d * nb_candidates],
+                       &profile->ranks[e * nb_candidates],
+                       nb_candidates) == 0)
+                return false;
+        }
+    }
+    bool passed = voters == tallies->ballots->rows;
+    delete_ballot_profile(profile);
+
+    uint sequential[MAX_TAB], parallel[MAX_TAB];
+    enum Method methods[] = {UNI2, CS, JM, BORDA};
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        ElectionOptions options;
+        init_election_options(&options, methods[i]);
+        int undecided =
+            run_bootstrap(tallies, &options, 500, 3, 1, sequential);
+        passed &= undecided >= 0 &&
+                  run_bootstrap(tallies, &options, 500, 3, 4, parallel) ==
+                      undecided &&
+                  memcmp(sequential, parallel,
+                         sizeof(uint) * nb_candidates) == 0;
+        for (int c = 0; c < nb_candidates; c++)
+            undecided += sequential[c];
+        passed &= undecided == 500;
+    }
+    ElectionOptions options;
+    init_election_options(&options, COOMBS);
+    passed &= run_bootstrap(tallies, &options, 10, 3, 1, sequential) == -1;
+
+    ptrTallies unanimous = init_tallies();
+    for (int c = 0; c < nb_candidates; c++) {
+        const StringBuffer *tag = tallies->ballots->tags[c];
+        unanimous->ballots->tags[c] = init_stringbuffer(tag->string, tag->size);
+    }
+    unanimous->ballots->columns = nb_candidates;
+    int row[MAX_TAB];
+    for (int c = 0; c < nb_candidates; c++)
+        row[c] = (c + 2) % nb_candidates + 1;
+    for (int i = 0; i < 50; i++)
+        append_ballot_to_tallies(unanimous, row);
+    init_election_options(&options, CS);
+    int winner = find_election_winner(unanimous, &options);
+    passed &= run_bootstrap(unanimous, &options, 100, 5, 2, sequential) == 0 &&
+              sequential[winner] == 100;
+    delete_tallies(unanimous);
+    delete_tallies(tallies);
+    return passed;
+}
+
+// Tiny elections, where every ballot can be rewritten into every full
+// ranking or into a ballot ranking a single candidate
+#define MARGIN_BALLOTS 5
+#define MARGIN_CANDIDATES 3
+#define MARGIN_REWRITES 10
+
+// The unique best ranked continuing candidate, -1 if tied, -2 if none
+static int top_of(const int *row, const bool *continuing) {
+    int top = -2, best = 0;
+    for (int c = 0; c < MARGIN_CANDIDATES; c++) {
+        if (!continuing[c] || row[c] <= 0)
+            continue;
+        if (best == 0 || row[c] < best) {
+            best = row[c];
+            top = c;
+        } else if (row[c] == best) {
+            top = -1;
+        }
+    }
+    return top;
+}
+
+// The winners of counts meeting no tie that decides anything, -1 otherwise
+static void count_strictly(int rows[][MARGIN_CANDIDATES], int *winners) {
+    bool continuing[MARGIN_CANDIDATES] = {true, true, true};
+    int totals[MARGIN_CANDIDATES] = {0}, total = 0;
+    for (int b = 0; b < MARGIN_BALLOTS; b++) {
+        int top = top_of(rows[b], continuing);
+        if (top >= 0) {
+            totals[top]++;
+            total++;
+        }
+    }
+    int order[MARGIN_CANDIDATES] = {0, 1, 2};
+    for (int i = 0; i < MARGIN_CANDIDATES; i++) {
+        for (int j = i + 1; j < MARGIN_CANDIDATES; j++) {
+            if (totals[order[j]] > totals[order[i]]) {
+                int swap = order[i];
+                order[i] = order[j];
+                order[j] = swap;
+            }
+        }
+    }
+    winners[0] = total > 0 && totals[order[0]] > totals[order[1]]
+                     ? order[0]
+                     : -1;
+    winners[1] = -1;
+    if (total > 0 && 2 * totals[order[0]] > total) {
+        winners[1] = order[0];
+    } else if (total > 0 && totals[order[1]] > totals[order[2]]) {
+        int a = order[0], b = order[1], gap = 0;
+        for (int k = 0; k < MARGIN_BALLOTS; k++) {
+            int x = rows[k][a], y = rows[k][b];
+            gap += x > 0 && (y <= 0 || x < y);
+            gap -= y > 0 && (x <= 0 || y < x);
+        }
+        winners[1] = gap > 0 ? a : gap < 0 ? b : -1;
+    }
+
+    // Ties for last place only pass when they move no ballot
+    winners[2] = -1;
+    for (int left = MARGIN_CANDIDATES; left > 1; left--) {
+        int tallies[MARGIN_CANDIDATES] = {0}, tied = 0, loser = -1, ties = 0;
+        for (int b = 0; b < MARGIN_BALLOTS; b++) {
+            int top = top_of(rows[b], continuing);
+            if (top >= 0)
+                tallies[top]++;
+            tied += top == -1;
+        }
+        for (int c = 0; c < MARGIN_CANDIDATES; c++) {
+            if (!continuing[c])
+                continue;
+            if (loser == -1 || tallies[c] < tallies[loser]) {
+                loser = c;
+                ties = 1;
+            } else if (tallies[c] == tallies[loser]) {
+                ties++;
+            }
+        }
+        if (ties > 1 && (tallies[loser] > 0 || tied > 0 || ties == left))
+            return;
+        continuing[loser] = false;
+    }
+    for (int c = 0; c < MARGIN_CANDIDATES; c++) {
+        if (continuing[c])
+            winners[2] = c;
+    }
+}
+
+// Tries every rewrite of the ballots, keeping the fewest electing another
+static void find_brute_margins(int rows[][MARGIN_CANDIDATES],
+                               const int *winners, int *margins) {
+    static const int rewrites[MARGIN_REWRITES][MARGIN_CANDIDATES] = {
+        {1, 2, 3}, {1, 3, 2}, {2, 1, 3}, {2, 3, 1}, {3, 1, 2},
+        {3, 2, 1}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    int changed[MARGIN_BALLOTS][MARGIN_CANDIDATES], choices[MARGIN_BALLOTS];
+    for (int i = 0; i < 3; i++)
+        margins[i] = -1;
+    int nb_configurations = 1;
+    for (int b = 0; b < MARGIN_BALLOTS; b++)
+        nb_configurations *= MARGIN_REWRITES;
+    for (int k = 0; k < nb_configurations; k++) {
+        int rewritten = 0, rest = k, found[3];
+        for (int b = 0; b < MARGIN_BALLOTS; b++) {
+            choices[b] = rest % MARGIN_REWRITES;
+            rest /= MARGIN_REWRITES;
+            rewritten += choices[b] != MARGIN_REWRITES - 1;
+            memcpy(changed[b],
+                   choices[b] == MARGIN_REWRITES - 1 ? rows[b]
+                                                      : rewrites[choices[b]],
+                   sizeof(changed[b]));
+        }
+        count_strictly(changed, found);
+        for (int i = 0; i < 3; i++) {
+            if (found[i] >= 0 && found[i] != winners[i] &&
+                (margins[i] < 0 || rewritten < margins[i]))
+                margins[i] = rewritten;
+        }
+    }
+}
+
+// The margins match an exhaustive search, the instant-runoff one between
+// its bounds
+static bool test_margins(void) {
+    srand(11);
+    bool passed = true;
+    for (int election = 0; election < 30 && passed; election++) {
+        int rows[MARGIN_BALLOTS][MARGIN_CANDIDATES];
+        ptrBallots ballots = init_ballots();
+        for (int b = 0; b < MARGIN_BALLOTS; b++) {
+            for (int c = 0; c < MARGIN_CANDIDATES; c++)
+                rows[b][c] = rand() % (MARGIN_CANDIDATES + 1);
+            add_ballot(ballots, rows[b], MARGIN_CANDIDATES);
+        }
+        FirstChoiceIndex *index = build_first_choice_index(ballots);
+        Margins margins;
+        passed = find_margins(ballots, index, 2, &margins) == 0;
+        int winners[3] = {margins.plurality_winner, margins.two_round_winner,
+                          margins.irv_winner};
+        int brute[3];
+        find_brute_margins(rows, winners, brute);
+        passed &= margins.plurality == brute[0] &&
+                  margins.two_round == brute[1] && margins.irv_lower >= 0 &&
+                  margins.irv_lower <= brute[2] &&
+                  brute[2] <= margins.irv_upper;
+        if (!passed)
+            fprintf(stderr,
+                    "Election %d: %d %d, %d %d, [%d, %d] %d\n", election,
+                    margins.plurality, brute[0], margins.two_round, brute[1],
+                    margins.irv_lower, margins.irv_upper, brute[2]);
+        delete_first_choice_index(index);
+        delete_ballots(ballots);
+    }
+    return passed;
+}
+
+// Beyond the exhaustive search, a known margin is found and the bounds do
+// not depend on the number of workers
+static bool test_larger_margins(void) {
+    // Ballots ranking a single candidate, 100 for A down to 30 for E: B
+    // needs 21 of A's ballots in every count, and so does every order
+    static const int supporters[] = {100, 60, 50, 40, 30};
+    ptrBallots ballots = init_ballots();
+    for (int c = 0; c < 5; c++) {
+        int row[5] = {0};
+        row[c] = 1;
+        for (int b = 0; b < supporters[c]; b++)
+            add_ballot(ballots, row, 5);
+    }
+    FirstChoiceIndex *index = build_first_choice_index(ballots);
+    Margins margins, parallel;
+    bool passed = find_margins(ballots, index, 2, &margins) == 0 &&
+                  margins.irv_winner == 0 && margins.plurality == 21 &&
+                  margins.two_round == 21 && margins.irv_lower == 21 &&
+                  margins.irv_upper == 21;
+    delete_first_choice_index(index);
+    delete_ballots(ballots);
+
+    srand(17);
+    ballots = init_ballots();
+    for (int b = 0; b < 400; b++) {
+        int row[8];
+        for (int c = 0; c < 8; c++)
+            row[c] = c + 1;
+        for (int c = 7; c > 0; c--) {
+            int other = rand() % (c + 1), rank = row[c];
+            row[c] = row[other];
+            row[other] = rank;
+        }
+        add_ballot(ballots, row, 8);
+    }
+    index = build_first_choice_index(ballots);
+    passed &= find_margins(ballots, index, 1, &margins) == 0 &&
+              find_margins(ballots, index, 3, &parallel) == 0 &&
+              memcmp(&margins, &parallel, sizeof(Margins)) == 0 &&
+              margins.irv_lower >= 0 &&
+              margins.irv_lower <= margins.irv_upper;
+    delete_first_choice_index(index);
+    delete_ballots(ballots);
+    return passed;
+}
+
+// Every withdrawal matches a count of the duel matrix without the
+// withdrawn candidate, whatever the number of workers
+static bool test_withdrawals(void) {
+    srand(5);
+    ptrMatrix duel = init_matrix(true), remaining = init_matrix(true);
+    Withdrawal sequential[MAX_TAB], parallel[MAX_TAB];
+    bool passed = duel != NULL && remaining != NULL;
+    for (int n = 2; n <= 12 && passed; n++) {
+        // Few voters leave ties between duels and between paths
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < i; j++) {
+                duel->data[i][j] = rand() % 8;
+                duel->data[j][i] = 7 - duel->data[i][j];
+            }
+            duel->data[i][i] = 0;
+        }
+        passed = find_withdrawal_winners(duel, n, 1, sequential) == 0 &&
+                 find_withdrawal_winners(duel, n, 3, parallel) == 0 &&
+                 memcmp(sequential, parallel, sizeof(Withdrawal) * n) == 0;
+        for (int w = 0; w < n && passed; w++) {
+            for (int i = 0; i < n - 1; i++) {
+                for (int j = 0; j < n - 1; j++)
+                    remaining->data[i][j] =
+                        duel->data[i + (i >= w)][j + (j >= w)];
+            }
+            int expected[4], found[4] = {sequential[w].condorcet,
+                                         sequential[w].minimax,
+                                         sequential[w].ranked_pairs,
+                                         sequential[w].schulze};
+            if (!find_condorcet_winner(remaining, n - 1, &expected[0]))
+                expected[0] = -1;
+            expected[1] = find_minimax_condorcet_winner(remaining, n - 1);
+            CandidateScore *ranking =
+                find_ranked_pairs_condorcet_winner(remaining, n - 1);
+            expected[2] = ranking[0].candidate;
+            mem_free(ranking);
+            expected[3] = find_schulze_condorcet_winner(remaining, n - 1);
+            for (int m = 0; m < 4; m++) {
+                int index = expected[m] >= w ? expected[m] + 1 : expected[m];
+                passed &= found[m] == index;
+            }
+        }
+    }
+    delete_matrix(duel);
+    delete_matrix(remaining);
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <Directory>\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    enum Method methods[] = {UNI1, CM, CS, JM, BORDA, BUCKLIN, COOMBS, TIDEMAN};
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        char *sequential = count_batch(argv[1], methods[i], 1);
+        char *parallel = count_batch(argv[1], methods[i], 4);
+        if (sequential == NULL || parallel == NULL ||
+            strcmp(sequential, parallel) != 0) {
+            fprintf(stderr, "Batch records depend on the number of workers\n");
+            exit(EXIT_FAILURE);
+        }
+        free(sequential);
+        free(parallel);
+    }
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/VoteCondorcet.csv", argv[1]);
+    if (!test_server(path)) {
+        fprintf(stderr, "The server does not answer as a direct count\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!test_bootstrap(path)) {
+        fprintf(stderr, "The resamples depend on the number of workers\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!test_margins()) {
+        fprintf(stderr, "The margins differ from an exhaustive search\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!test_larger_margins()) {
+        fprintf(stderr, "The margins of larger elections are wrong\n");
+        exit(EXIT_FAILURE);
+    }
+    if (!test_withdrawals()) {
+        fprintf(stderr, "The withdrawals differ from a count without them\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("Batch, server, bootstrap, margin and withdrawal tests passed\n");
+    return 0;
+}
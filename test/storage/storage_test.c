@@ -0,0 +1,152 @@
+#include "cache.h"
+#include "summary.h"
+#include "tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NB_SHARDS 3
+
+static bool same_summaries(const TallySummary *a, const TallySummary *b) {
+    uint columns = a->duel->columns;
+    if (b->duel->columns != columns ||
+        a->histogram->ballots != b->histogram->ballots ||
+        a->histogram->columns != b->histogram->columns)
+        return false;
+    for (uint i = 0; i < columns; i++) {
+        if (strcmp(a->duel->tags[i]->string, b->duel->tags[i]->string) != 0 ||
+            a->first_choices[i] != b->first_choices[i] ||
+            memcmp(a->duel->data[i], b->duel->data[i],
+                   sizeof(int) * columns) != 0 ||
+            memcmp(a->histogram->counts[i], b->histogram->counts[i],
+                   sizeof(uint) * a->histogram->columns) != 0)
+            return false;
+    }
+    return true;
+}
+
+// Appends the ballots of a file one by one to tallies that only know the
+// candidates
+static void set_appended(ptrTallies appended, const Ballots *ballots) {
+    for (uint c = 0; c < ballots->columns; c++) {
+        const StringBuffer *tag = ballots->tags[c];
+        appended->ballots->tags[c] = init_stringbuffer(tag->string, tag->size);
+    }
+    appended->ballots->columns = ballots->columns;
+    int row[MAX_TAB];
+    for (uint i = 0; i < ballots->rows; i++) {
+        for (uint c = 0; c < ballots->columns; c++)
+            row[c] = get_ballot_rank(ballots, i, c);
+        append_ballot_to_tallies(appended, row);
+    }
+}
+
+// Splits the ballots of a file into shards, one ballot out of NB_SHARDS each
+static void set_shard(ptrTallies shard, const Ballots *ballots, uint index) {
+    for (uint c = 0; c < ballots->columns; c++) {
+        const StringBuffer *tag = ballots->tags[c];
+        shard->ballots->tags[c] = init_stringbuffer(tag->string, tag->size);
+    }
+    int row[MAX_TAB];
+    for (uint i = index; i < ballots->rows; i += NB_SHARDS) {
+        for (uint c = 0; c < ballots->columns; c++) {
+            rank_t rank = get_ballot_rank(ballots, i, c);
+            row[c] = rank == RANK_NONE ? -1 : rank;
+        }
+        add_ballot(shard->ballots, row, ballots->columns);
+    }
+    shard->ballots->columns = ballots->columns;
+    update_tallies(shard);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <Filename> <Number Of Candidates>\n",
+                argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    int nb_candidates;
+    if (sscanf(argv[2], "%d", &nb_candidates) != 1) {
+        perror("sscanf failed");
+        exit(EXIT_FAILURE);
+    }
+    // Whatever the libraries allocate must be freed by the end
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    set_thread_allocator(get_tracking_allocator(&tracker));
+
+    ptrTallies whole = init_tallies();
+    ptrTallySummary expected = init_tally_summary();
+    if (set_tallies_from_file(whole, argv[1], nb_candidates) != 0) {
+        fprintf(stderr, "Could not read the ballots of %s\n", argv[1]);
+        exit(EXIT_FAILURE);
+    }
+    set_summary_from_tallies(expected, whole);
+
+    ptrTallySummary shards[NB_SHARDS];
+    for (uint k = 0; k < NB_SHARDS; k++) {
+        ptrTallies shard = init_tallies();
+        shards[k] = init_tally_summary();
+        set_shard(shard, whole->ballots, k);
+        set_summary_from_tallies(shards[k], shard);
+        delete_tallies(shard);
+    }
+
+    // (A + B) + C, A + (B + C) and C + A + B all give the whole election,
+    // and an empty summary changes nothing
+    ptrTallySummary left = init_tally_summary();
+    ptrTallySummary right = init_tally_summary();
+    ptrTallySummary rotated = init_tally_summary();
+    ptrTallySummary empty = init_tally_summary();
+    merge_tally_summaries(left, shards[0]);
+    merge_tally_summaries(left, shards[1]);
+    merge_tally_summaries(left, shards[2]);
+    merge_tally_summaries(rotated, shards[2]);
+    merge_tally_summaries(rotated, shards[0]);
+    bool same = !same_summaries(rotated, expected);
+    merge_tally_summaries(rotated, shards[1]);
+    merge_tally_summaries(right, shards[1]);
+    merge_tally_summaries(right, shards[2]);
+    merge_tally_summaries(right, empty);
+    merge_tally_summaries(shards[0], right);
+    same &= same_summaries(left, expected) &&
+            same_summaries(shards[0], expected) &&
+            same_summaries(rotated, expected);
+
+    // Ballots appended one by one give the whole election
+    ptrTallies appended = init_tallies();
+    ptrTallySummary incremental = init_tally_summary();
+    set_appended(appended, whole->ballots);
+    same &= set_summary_from_tallies(incremental, appended) == 0 &&
+            same_summaries(incremental, expected);
+    delete_tally_summary(incremental);
+    delete_tallies(appended);
+
+    // A summary reads back as written
+    char path[] = "storage_test.summary";
+    ptrTallySummary read = init_tally_summary();
+    same &= write_tally_summary(expected, path) == 0 &&
+            read_tally_summary(read, path) == 0 &&
+            same_summaries(read, expected);
+    remove(path);
+
+    for (uint k = 0; k < NB_SHARDS; k++)
+        delete_tally_summary(shards[k]);
+    delete_tally_summary(left);
+    delete_tally_summary(right);
+    delete_tally_summary(rotated);
+    delete_tally_summary(empty);
+    delete_tally_summary(read);
+    delete_tally_summary(expected);
+    delete_tallies(whole);
+    if (!same) {
+        fprintf(stderr, "Merged summaries do not match the whole election\n");
+        return EXIT_FAILURE;
+    }
+    printf("Tally summaries merge into the whole election\n");
+    if (tracker.total.live != 0) {
+        fprintf(stderr, "%zu bytes were never freed\n", tracker.total.live);
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include "matrix.h"
+#include "test_structure.h"
+#include "tracker.h"
 #include <stdlib.h>
 
 int main(int argc, char **argv) {
@@ -12,9 +14,37 @@ int main(int argc, char **argv) {
         perror("sscanf failed");
         exit(EXIT_FAILURE);
     }
+    // Whatever the libraries allocate must be freed by the end
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    set_thread_allocator(get_tracking_allocator(&tracker));
     Matrix *matrix = init_matrix(false);
     set_matrix_from_file(matrix, argv[1], nb_candidates);
     print_matrix(matrix, " | ");
     delete_matrix(matrix);
+    int status = test_matrix_capacity();
+    if (status != SUCCESS) {
+        fprintf(stderr, "Matrix capacity test failed with code %d\n", status);
+        return status;
+    }
+
+    ptrBallots ballots = init_ballots();
+    set_ballots_from_file(ballots, argv[1], nb_candidates);
+    status = test_piles(ballots);
+    if (status != SUCCESS) {
+        fprintf(stderr, "Piles test failed with code %d\n", status);
+        delete_ballots(ballots);
+        return status;
+    }
+    status = test_ballots_round_trip(ballots);
+    delete_ballots(ballots);
+    if (status != SUCCESS) {
+        fprintf(stderr, "Ballots round trip failed with code %d\n", status);
+        return status;
+    }
+    if (tracker.total.live != 0) {
+        fprintf(stderr, "%zu bytes were never freed\n", tracker.total.live);
+        return EXIT_FAILURE;
+    }
     return 0;
 }
\ No newline at end of file
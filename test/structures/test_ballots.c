@@ -0,0 +1,53 @@
+#include "ballots.h"
+#include "test_structure.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Writes the ballots to a temporary stream and checks they read back equal
+int test_ballots_round_trip(const Ballots *ballots) {
+    FILE *file = tmpfile();
+    if (file == NULL)
+        return PERMISSION_DENIED_ERROR;
+    ptrBallots copy = init_ballots();
+    if (copy == NULL) {
+        fclose(file);
+        return MEMORY_ALLOCATION_ERROR;
+    }
+    int status = SUCCESS;
+    if (write_ballots(ballots, file) != 0 || fseek(file, 0, SEEK_SET) != 0 ||
+        read_ballots(copy, file) != 0)
+        status = FAILURE;
+    if (status == SUCCESS &&
+        (copy->rows != ballots->rows || copy->columns != ballots->columns ||
+         copy->rejected != ballots->rejected))
+        status = MATRIX_DIMENSION_ERROR;
+    for (uint c = 0; c < ballots->columns && status == SUCCESS; c++) {
+        if (strcmp(copy->tags[c]->string, ballots->tags[c]->string) != 0)
+            status = UNEXPECTED_BEHAVIOR_ERROR;
+        for (uint i = 0; i < ballots->rows; i++) {
+            if (get_ballot_rank(copy, i, c) != get_ballot_rank(ballots, i, c))
+                status = UNEXPECTED_BEHAVIOR_ERROR;
+        }
+    }
+
+    // A truncated stream must be refused
+    if (status == SUCCESS && ballots->rows > 0) {
+        long size = ftell(file);
+        FILE *truncated = tmpfile();
+        char *buffer = malloc(size);
+        if (truncated == NULL || buffer == NULL)
+            status = MEMORY_ALLOCATION_ERROR;
+        else if (fseek(file, 0, SEEK_SET) != 0 ||
+                 fread(buffer, 1, size, file) != (size_t)size ||
+                 fwrite(buffer, 1, size - 1, truncated) != (size_t)size - 1 ||
+                 fseek(truncated, 0, SEEK_SET) != 0 ||
+                 read_ballots(copy, truncated) == 0 || copy->rows != 0)
+            status = UNEXPECTED_BEHAVIOR_ERROR;
+        free(buffer);
+        if (truncated != NULL)
+            fclose(truncated);
+    }
+    delete_ballots(copy);
+    fclose(file);
+    return status;
+}
@@ -0,0 +1,44 @@
+#include "test_structure.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+// Writes a file of identical ballots ranking 4 candidates
+static int write_ballot_file(char *path, int rows) {
+    int fd = mkstemp(path);
+    FILE *file = fd >= 0 ? fdopen(fd, "w") : NULL;
+    if (file == NULL)
+        return -1;
+    fprintf(file, "Id,Date,Course,Name,A,B,C,D\n");
+    for (int i = 0; i < rows; i++)
+        fprintf(file, "%d,18/10/2026,Test,v%d,1,2,3,4\n", i + 1, i);
+    return fclose(file);
+}
+
+// A matrix keeps its last row for the totals: MAX_TAB - 1 ballots fit, one
+// more is refused instead of having the totals overwrite the matrix
+int test_matrix_capacity(void) {
+    int status = SUCCESS;
+    for (int rows = MAX_TAB - 1; rows <= MAX_TAB; rows++) {
+        char path[] = "/tmp/matrix_capacityXXXXXX";
+        if (write_ballot_file(path, rows) != 0)
+            return FAILURE;
+        bool fits = rows < MAX_TAB;
+        ptrMatrix matrix = init_matrix(false);
+        ptrMatrix duel = init_matrix(true);
+        if ((set_matrix_from_file(matrix, path, 4) == 0) != fits ||
+            (set_duel_from_file(duel, path, 4) == 0) != fits) {
+            status = MATRIX_DIMENSION_ERROR;
+        } else if (fits) {
+            add_totals_row(matrix);
+            if (matrix->rows != MAX_TAB || matrix->columns != 4 ||
+                matrix->data[rows][0] != rows || duel->data[0][1] != rows)
+                status = MATRIX_DIMENSION_ERROR;
+        } else if (matrix->rows != 0 || duel->rows != 0) {
+            status = MATRIX_DIMENSION_ERROR;
+        }
+        delete_matrix(matrix);
+        delete_matrix(duel);
+        unlink(path);
+    }
+    return status;
+}
@@ -0,0 +1,53 @@
+#include "piles.h"
+#include "test_structure.h"
+#include <stdbool.h>
+
+// Counts the ballots holding a candidate alone at one end, from scratch
+static uint naive_count(const Piles *piles, int candidate) {
+    const Ballots *ballots = piles->ballots;
+    uint count = 0;
+    for (uint i = 0; i < ballots->rows; i++) {
+        int holder = -1, holders = 0;
+        int best = -1;
+        for (uint c = 0; c < ballots->columns; c++) {
+            if (!piles->continuing[c])
+                continue;
+            rank_t rank = get_ballot_rank(ballots, i, c);
+            int key = piles->side == PILE_TOP
+                          ? (rank == RANK_NONE ? -1 : MAX_RANK + 1 - rank)
+                          : (rank == RANK_NONE ? MAX_RANK + 1 : rank);
+            if (key < 0 || key < best)
+                continue;
+            if (key > best) {
+                best = key;
+                holders = 0;
+            }
+            holder = c;
+            holders++;
+        }
+        count += holders == 1 && holder == candidate;
+    }
+    return count;
+}
+
+int test_piles(const Ballots *ballots) {
+    for (int side = PILE_TOP; side <= PILE_BOTTOM; side++) {
+        ptrPiles piles = init_piles(ballots, side);
+        if (piles == NULL)
+            return MEMORY_ALLOCATION_ERROR;
+        // Eliminate candidates in turn and check every pile each time
+        for (uint eliminated = 0; eliminated < ballots->columns;
+             eliminated++) {
+            for (uint c = 0; c < ballots->columns; c++) {
+                if (piles->continuing[c] &&
+                    piles->counts[c] != naive_count(piles, c)) {
+                    delete_piles(piles);
+                    return UNEXPECTED_BEHAVIOR_ERROR;
+                }
+            }
+            eliminate_from_piles(piles, (eliminated * 7) % ballots->columns);
+        }
+        delete_piles(piles);
+    }
+    return SUCCESS;
+}
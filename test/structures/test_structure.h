@@ -1,6 +1,7 @@
 #ifndef TEST_CODE_H
 #define TEST_CODE_H
 
+#include "ballots.h"
 #include "matrix.h"
 #include "miscellaneous.h"
 #include "stringbuffer.h"
@@ -31,4 +32,8 @@
 #define TIMEOUT_ERROR 52
 #define PERMISSION_DENIED_ERROR 53
 
+int test_piles(const Ballots *ballots);
+int test_ballots_round_trip(const Ballots *ballots);
+int test_matrix_capacity(void);
+
 #endif /* TEST_CODE_H */
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Allocations are aligned, keep their content when resized, and a reset
+// arena serves the same bytes again
+bool test_arena(void) {
+    ptrArena arena = init_arena(256);
+    if (arena == NULL)
+        return false;
+    const Allocator *previous =
+        set_thread_allocator(get_arena_allocator(arena));
+    bool passed = true;
+    char *first = mem_alloc(3);
+    long *second = mem_alloc(sizeof(long));
+    passed &= first != NULL && second != NULL &&
+              (uintptr_t)second % _Alignof(max_align_t) == 0;
+
+    // The latest allocation grows in place, others move
+    int *grown = mem_alloc(4 * sizeof(int));
+    for (int i = 0; i < 4; i++)
+        grown[i] = i;
+    int *same = mem_realloc(grown, 8 * sizeof(int));
+    passed &= same == grown;
+    strcpy(first, "ab");
+    char *moved = mem_realloc(first, 1000);
+    passed &= moved != first && strcmp(moved, "ab") == 0;
+    for (int i = 0; i < 4; i++)
+        passed &= same[i] == i;
+    mem_free(moved);
+
+    // Blocks are added past the first one, and only the last is kept
+    for (int i = 0; i < 100; i++)
+        passed &= mem_calloc(64, 1) != NULL;
+    passed &= arena->blocks->next != NULL;
+    reset_arena(arena);
+    passed &= arena->blocks->next == NULL && arena->allocated == 0;
+    void *again = mem_alloc(16);
+    reset_arena(arena);
+    passed &= mem_alloc(16) == again;
+
+    set_thread_allocator(previous);
+    delete_arena(arena);
+    return passed;
+}
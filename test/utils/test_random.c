@@ -0,0 +1,64 @@
+#include "random.h"
+#include <math.h>
+#include <stdbool.h>
+
+// A stream is the same however it is reached, streams differ from each
+// other, and the draws have the expected distributions
+bool test_random(void) {
+    RandomStream first, again, other;
+    init_random_stream(&first, 42, 7);
+    init_random_stream(&again, 42, 7);
+    init_random_stream(&other, 42, 8);
+    bool passed = true;
+    int same = 0;
+    for (int i = 0; i < 100; i++) {
+        uint64_t value = next_random(&first);
+        passed &= value == next_random(&again);
+        same += value == next_random(&other);
+    }
+    passed &= same == 0;
+
+    int counts[6] = {0};
+    double sum = 0, squares = 0, uniform = 0;
+    int n = 600000;
+    for (int i = 0; i < n; i++) {
+        uint32_t face = next_below(&first, 6);
+        if (face >= 6)
+            return false;
+        counts[face]++;
+        double u = next_uniform(&first);
+        passed &= u >= 0 && u < 1;
+        uniform += u;
+        double g = next_gaussian(&first);
+        sum += g;
+        squares += g * g;
+    }
+    for (int f = 0; f < 6; f++)
+        passed &= fabs(counts[f] - n / 6.0) < 0.01 * n;
+    passed &= fabs(uniform / n - 0.5) < 0.01;
+    passed &= fabs(sum / n) < 0.01 && fabs(squares / n - 1) < 0.01;
+
+    // Both samplers of the binomial, and its symmetry
+    static const struct {
+        uint32_t trials;
+        double p;
+    } binomials[] = {{20, 0.1}, {1000, 0.3}, {1000000, 0.5}, {50, 0.95}};
+    for (int b = 0; b < 4; b++) {
+        double mean = binomials[b].trials * binomials[b].p;
+        double variance = mean * (1 - binomials[b].p);
+        sum = squares = 0;
+        for (int i = 0; i < 100000; i++) {
+            uint32_t k = next_binomial(&first, binomials[b].trials,
+                                       binomials[b].p);
+            passed &= k <= binomials[b].trials;
+            sum += k;
+            squares += (k - mean) * (k - mean);
+        }
+        passed &= fabs(sum / 100000 - mean) < 0.02 * sqrt(variance) + 1e-9;
+        passed &= fabs(squares / 100000 / variance - 1) < 0.03;
+    }
+    passed &= next_binomial(&first, 10, 0) == 0 &&
+              next_binomial(&first, 10, 1) == 10 &&
+              next_binomial(&first, 0, 0.5) == 0;
+    return passed;
+}
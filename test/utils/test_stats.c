@@ -0,0 +1,80 @@
+#include "stats.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void spin(long nanoseconds) {
+    uint64_t until = monotonic_ns() + nanoseconds;
+    while (monotonic_ns() < until)
+        ;
+}
+
+// A nested phase pauses the outer one, and nothing is recorded without
+// thread statistics
+bool test_stats(void) {
+    Stats stats;
+    reset_stats(&stats);
+    add_to_counter(COUNTER_BALLOTS, 5);
+    bool passed = stats.counters[COUNTER_BALLOTS] == 0;
+
+    set_thread_stats(&stats);
+    begin_phase(PHASE_ROWS);
+    spin(200000);
+    begin_phase(PHASE_PAIRWISE);
+    spin(2000000);
+    end_phase(PHASE_PAIRWISE);
+    end_phase(PHASE_ROWS);
+    add_to_counter(COUNTER_BALLOTS, 5);
+    set_thread_stats(NULL);
+
+    passed &= stats.depth == 0 && stats.counters[COUNTER_BALLOTS] == 5;
+    passed &= stats.elapsed[PHASE_ROWS] >= 200000 &&
+              stats.elapsed[PHASE_PAIRWISE] >= 2000000 &&
+              stats.elapsed[PHASE_ROWS] < stats.elapsed[PHASE_PAIRWISE];
+    passed &= stats.elapsed[PHASE_HEADER] == 0;
+    return passed;
+}
+
+// Only the events counted are reported, with their ratios
+bool test_perf_stats(void) {
+    Stats stats;
+    reset_stats(&stats);
+    PerfCounters perf = {.leader = -1};
+    for (int e = 0; e < NB_PERF_EVENTS; e++)
+        perf.fds[e] = perf.slots[e] = -1;
+    perf.slots[PERF_CYCLES] = 0;
+    perf.slots[PERF_INSTRUCTIONS] = 1;
+    perf.slots[PERF_BRANCH_MISSES] = 2;
+    stats.perf = &perf;
+    stats.counters[COUNTER_BALLOTS] = 4;
+    stats.events[PHASE_ROWS][PERF_CYCLES] = 1000;
+    stats.events[PHASE_ROWS][PERF_INSTRUCTIONS] = 2500;
+    stats.events[PHASE_ROWS][PERF_BRANCH_MISSES] = 10;
+
+    char path[] = "/tmp/perf_testXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return false;
+    close(fd);
+    ptrWriter writer = open_writer(path, FORMAT_CSV);
+    if (writer == NULL)
+        return false;
+    emit_perf_stats(writer, &stats);
+    close_writer(writer);
+
+    char content[1024] = "";
+    FILE *file = fopen(path, "r");
+    bool passed = file != NULL;
+    if (file != NULL) {
+        passed = fread(content, 1, sizeof(content) - 1, file) > 0;
+        fclose(file);
+    }
+    unlink(path);
+    return passed &&
+           strstr(content, "Phase,cycles,instructions,branch misses\n") &&
+           strstr(content, "rows,1000,2500,10\n") &&
+           strstr(content, "Phase,IPC,branch/ballot\n") &&
+           strstr(content, "rows,2.500,2.500\n");
+}
@@ -0,0 +1,62 @@
+#include "trace.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Spans are recorded when they end, the ring keeps the latest ones, and a
+// thread that is not attached records nothing
+bool test_trace(void) {
+    Trace trace;
+    init_trace(&trace);
+    begin_trace_span("ignored", NULL);
+    end_trace_span();
+    if (attach_trace_thread(&trace, "main") != 0)
+        return false;
+    TraceBuffer *buffer = trace.buffers[0];
+    begin_trace_span("election", "vote \"10\".csv");
+    begin_trace_span("rows", NULL);
+    end_trace_span();
+    end_trace_span();
+    bool passed = buffer->written == 2 && buffer->depth == 0 &&
+                  strcmp(buffer->events[0].name, "rows") == 0 &&
+                  buffer->events[1].start <= buffer->events[0].start &&
+                  buffer->events[1].duration >= buffer->events[0].duration;
+
+    // Too deep to be kept, but still ended in order
+    for (int d = 0; d <= TRACE_MAX_DEPTH; d++)
+        begin_trace_span("deep", NULL);
+    for (int d = 0; d <= TRACE_MAX_DEPTH; d++)
+        end_trace_span();
+    passed &= buffer->written == 2 + TRACE_MAX_DEPTH && buffer->depth == 0;
+    for (int e = 0; e < TRACE_BUFFER_EVENTS; e++) {
+        begin_trace_span("method", NULL);
+        end_trace_span();
+    }
+    detach_trace_thread();
+    begin_trace_span("ignored", NULL);
+    end_trace_span();
+    passed &= buffer->written == 2 + TRACE_MAX_DEPTH + TRACE_BUFFER_EVENTS;
+
+    // Only the latest spans are written, the election has been overwritten
+    char path[] = "/tmp/test_traceXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || write_trace(&trace, path) != 0) {
+        clear_trace(&trace);
+        return false;
+    }
+    FILE *file = fdopen(fd, "r");
+    char line[256];
+    int methods = 0, threads = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        methods += strstr(line, "\"name\":\"method\"") != NULL;
+        threads += strstr(line, "\"thread_name\"") != NULL;
+        passed &= strstr(line, "election") == NULL &&
+                  strstr(line, "ignored") == NULL;
+    }
+    fclose(file);
+    remove(path);
+    passed &= methods == TRACE_BUFFER_EVENTS && threads == 1;
+    clear_trace(&trace);
+    return passed;
+}
@@ -0,0 +1,37 @@
+#include "tracker.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Each subsystem is charged its own bytes, a resize stays with the one that
+// allocated, and the peak outlives the frees
+bool test_tracker(void) {
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    const Allocator *previous =
+        set_thread_allocator(get_tracking_allocator(&tracker));
+    char *name = mem_strdup_from(MEM_STRUCTURES, "Veggie Burger");
+    long *scores = mem_alloc_from(MEM_MODULES, 4 * sizeof(long));
+    bool passed = name != NULL && scores != NULL &&
+                  (uintptr_t)scores % _Alignof(max_align_t) == 0;
+    passed &= tracker.subsystems[MEM_STRUCTURES].live == 14 &&
+              tracker.subsystems[MEM_MODULES].live == 4 * sizeof(long) &&
+              tracker.total.live == 14 + 4 * sizeof(long);
+
+    scores = mem_realloc_from(MEM_UTILS, scores, 8 * sizeof(long));
+    passed &= tracker.subsystems[MEM_MODULES].live == 8 * sizeof(long) &&
+              tracker.subsystems[MEM_UTILS].allocations == 0 &&
+              strcmp(name, "Veggie Burger") == 0;
+    mem_free(scores);
+    mem_free(name);
+    passed &= tracker.total.live == 0 && tracker.total.frees == 3 &&
+              tracker.total.allocations == 3 &&
+              tracker.subsystems[MEM_MODULES].peak == 8 * sizeof(long) &&
+              tracker.total.peak == 14 + 8 * sizeof(long);
+
+    // Without an explicit subsystem, the test is charged as an executable
+    mem_free(mem_calloc(2, 8));
+    passed &= tracker.subsystems[MEM_OTHER].allocations == 1;
+    set_thread_allocator(previous);
+    return passed;
+}
@@ -1,4 +1,6 @@
 #include "miscellaneous.h"
+#include "test_utils.h"
+#include "tracker.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -12,6 +14,10 @@ int main(int argc, char **argv) {
         perror("sscanf failed");
         exit(EXIT_FAILURE);
     }
+    // Whatever the libraries allocate must be freed by the end
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    set_thread_allocator(get_tracking_allocator(&tracker));
     char **column;
     fetch_data(argv[1], nb_candidates, &column, &data, &rows, &cols);
     for (int i = 0; i < cols; i++) {
@@ -25,10 +31,40 @@ int main(int argc, char **argv) {
         printf("\n");
     }
     for (int i = 0; i < cols; i++)
-        free(column[i]);
-    for (int i = 0; i < rows; i++)
-        free(data[i]);
-    free(column);
-    free(data);
+        mem_free(column[i]);
+    mem_free(column);
+    mem_free(data);
+    if (!test_arena()) {
+        fprintf(stderr, "The arena does not behave as an allocator\n");
+        return EXIT_FAILURE;
+    }
+    if (!test_writer()) {
+        fprintf(stderr, "The writer does not write what printf would\n");
+        return EXIT_FAILURE;
+    }
+    if (!test_stats()) {
+        fprintf(stderr, "The phases are not timed on their own\n");
+        return EXIT_FAILURE;
+    }
+    if (!test_perf_stats()) {
+        fprintf(stderr, "The hardware events are not reported\n");
+        return EXIT_FAILURE;
+    }
+    if (!test_tracker()) {
+        fprintf(stderr, "The tracker does not account the memory\n");
+        return EXIT_FAILURE;
+    }
+    if (!test_trace()) {
+        fprintf(stderr, "The trace does not keep the latest spans\n");
+        return EXIT_FAILURE;
+    }
+    if (!test_random()) {
+        fprintf(stderr, "The random streams are not reproducible\n");
+        return EXIT_FAILURE;
+    }
+    if (tracker.total.live != 0) {
+        fprintf(stderr, "%zu bytes were never freed\n", tracker.total.live);
+        return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include <stdbool.h>
+
+bool test_arena(void);
+bool test_writer(void);
+bool test_stats(void);
+bool test_perf_stats(void);
+bool test_tracker(void);
+bool test_trace(void);
+bool test_random(void);
+
+#endif // TEST_UTILS_H
@@ -0,0 +1,90 @@
+#include "writer.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Reads back what a writer left in a file.
+ */
+static char *read_back(const char *path, long *size) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    rewind(file);
+    char *content = malloc(*size + 1);
+    if (content != NULL && fread(content, 1, *size, file) == (size_t)*size)
+        content[*size] = '\0';
+    fclose(file);
+    return content;
+}
+
+// Numbers come out as printf would write them, records in their format,
+// and what overflows the buffer is written in order
+bool test_writer(void) {
+    static const double decimals[] = {0,     -0.001, 0.005,  1.255, 2.5,
+                                      -2.5,  12.96,  199.999, -7.04,
+                                      1e17,  1e300};
+    static const long long integers[] = {0, 7, -7, 10, 123456789,
+                                         -9223372036854775807LL};
+    char path[] = "/tmp/writer_testXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return false;
+    close(fd);
+
+    ptrWriter writer = open_writer(path, FORMAT_TEXT);
+    if (writer == NULL)
+        return false;
+    char expected[1 << 12] = "";
+    size_t length = 0;
+    for (size_t i = 0; i < sizeof(decimals) / sizeof(*decimals); i++) {
+        write_decimal(writer, decimals[i], 2);
+        write_text(writer, " ");
+        length += snprintf(expected + length, sizeof(expected) - length,
+                           "%.2f ", decimals[i]);
+    }
+    for (size_t i = 0; i < sizeof(integers) / sizeof(*integers); i++) {
+        write_integer(writer, integers[i]);
+        write_text(writer, " ");
+        length += snprintf(expected + length, sizeof(expected) - length,
+                           "%lld ", integers[i]);
+    }
+    static const char *const headers[] = {"Candidate", "Votes"};
+    begin_table(writer, headers, 2, 0);
+    write_table_row(writer, "Alice", &(double){42});
+    end_table(writer);
+    length += snprintf(expected + length, sizeof(expected) - length,
+                       "\n%20s | %12s\n %s-|-%s\n%20s | %12d\n", "Candidate",
+                       "Votes", "-------------------", "------------",
+                       "Alice", 42);
+    emit_winner(writer, "Borda", 0, "Alice");
+    length += snprintf(expected + length, sizeof(expected) - length,
+                       "\nBorda winner is candidate : Alice\n");
+    writer->format = FORMAT_CSV;
+    write_csv_field(writer, "a,\"b\"");
+    write_text(writer, " ");
+    writer->format = FORMAT_JSON;
+    write_json_string(writer, "\"\\\n");
+    length += snprintf(expected + length, sizeof(expected) - length,
+                       "\"a,\"\"b\"\"\" \"\\\"\\\\\\u000a\"");
+
+    // Three buffers and a half of a repeated pattern
+    for (int i = 0; i < 7 * WRITER_BUFFER_SIZE / 2 / 8; i++)
+        write_bytes(writer, "01234567", 8);
+    bool passed = close_writer(writer) == 0;
+
+    long size;
+    char *content = read_back(path, &size);
+    passed &= content != NULL &&
+              (size_t)size == length + 7 * WRITER_BUFFER_SIZE / 2 &&
+              memcmp(content, expected, length) == 0;
+    for (long i = length; passed && i < size; i++)
+        passed &= content[i] == '0' + (i - (long)length) % 8;
+    free(content);
+    unlink(path);
+    return passed;
+}
@@ -0,0 +1,298 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Benchmarks the Methods over Synthetic Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "condorcet.h"
+#include "first_past_the_post.h"
+#include "majority_judgement.h"
+#include "matrix.h"
+#include "stats.h"
+#include "synthetic.h"
+#include "tracker.h"
+#include "writer.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+#define MAX_GRID 16
+#define MAX_REPETITIONS 1000
+
+/**
+ * @brief What the kernels of one point of the grid work on.
+ */
+typedef struct s_bench_election {
+    const char *path;   /**< The ballots as a CSV file */
+    ptrBallots ballots; /**< The ballots in memory */
+    ptrMatrix duel;     /**< Their duel matrix */
+    int nb_candidates;
+} BenchElection;
+
+typedef void (*Kernel)(const BenchElection *election);
+
+static void run_parse(const BenchElection *election) {
+    ptrBallots ballots = init_ballots();
+    set_ballots_from_file(ballots, election->path, election->nb_candidates);
+    delete_ballots(ballots);
+}
+
+static void run_pairwise(const BenchElection *election) {
+    set_duel_from_ballots(election->duel, election->ballots);
+}
+
+static void run_condorcet(const BenchElection *election) {
+    int winner;
+    find_condorcet_winner(election->duel, election->nb_candidates, &winner);
+}
+
+static void run_minimax(const BenchElection *election) {
+    find_minimax_condorcet_winner(election->duel, election->nb_candidates);
+}
+
+static void run_schulze(const BenchElection *election) {
+    find_schulze_condorcet_winner(election->duel, election->nb_candidates);
+}
+
+static void run_ranked_pairs(const BenchElection *election) {
+    mem_free(find_ranked_pairs_condorcet_winner(election->duel,
+                                                election->nb_candidates));
+}
+
+static void run_one_round(const BenchElection *election) {
+    delete_first_choice_index(build_first_choice_index(election->ballots));
+}
+
+static void run_two_rounds(const BenchElection *election) {
+    FirstChoiceIndex *index = build_first_choice_index(election->ballots);
+    delete_matrix(first_past_the_post_runoff_results(election->ballots, index));
+    delete_first_choice_index(index);
+}
+
+static void run_majority_judgement(const BenchElection *election) {
+    mem_free(find_majority_judgement_winner(election->ballots,
+                                            election->nb_candidates));
+}
+
+static const struct {
+    const char *name;
+    Kernel run;
+} kernels[] = {{"parse", run_parse},
+               {"pairwise", run_pairwise},
+               {"condorcet", run_condorcet},
+               {"minimax", run_minimax},
+               {"schulze", run_schulze},
+               {"ranked pairs", run_ranked_pairs},
+               {"one round", run_one_round},
+               {"two rounds", run_two_rounds},
+               {"majority judgement", run_majority_judgement}};
+
+#define NB_KERNELS (int)(sizeof(kernels) / sizeof(kernels[0]))
+
+/*-----------------------------------------------------------------*/
+
+static int compare_times(const void *first, const void *second) {
+    uint64_t a = *(const uint64_t *)first, b = *(const uint64_t *)second;
+    return (a > b) - (a < b);
+}
+
+// Nearest rank of sorted times, in microseconds
+static double percentile(const uint64_t *times, int n, int percent) {
+    int rank = (percent * n + 99) / 100;
+    return times[rank > 0 ? rank - 1 : 0] / 1e3;
+}
+
+static int write_election_file(const ElectionModel *model, uint nb_ballots,
+                               const char *path) {
+    FILE *file = fopen(path, "w");
+    char *line = mem_alloc(SYNTHETIC_ROW_SIZE(model->nb_candidates));
+    if (file == NULL || line == NULL) {
+        if (file != NULL)
+            fclose(file);
+        mem_free(line);
+        return -1;
+    }
+    int row[MAX_TAB];
+    write_synthetic_header(file, model, true);
+    for (uint b = 0; b < nb_ballots; b++) {
+        draw_ballot(model, b, row);
+        char *end = format_synthetic_row(line, model, b, row, true);
+        fwrite(line, 1, end - line, file);
+    }
+    mem_free(line);
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+// Times every kernel, the memory it allocates above what was live before
+// being its peak
+static void bench_election(ptrWriter out, MemoryTracker *tracker,
+                           const BenchElection *election, uint nb_ballots,
+                           int warmup, int repetitions) {
+    uint64_t times[MAX_REPETITIONS];
+    for (int k = 0; k < NB_KERNELS; k++) {
+        for (int w = 0; w < warmup; w++)
+            kernels[k].run(election);
+        size_t live = tracker->total.live;
+        tracker->total.peak = live;
+        for (int r = 0; r < repetitions; r++) {
+            uint64_t start = monotonic_ns();
+            kernels[k].run(election);
+            times[r] = monotonic_ns() - start;
+        }
+        qsort(times, repetitions, sizeof(uint64_t), compare_times);
+        double median = percentile(times, repetitions, 50);
+        double values[7] = {nb_ballots,
+                            election->nb_candidates,
+                            median,
+                            percentile(times, repetitions, 10),
+                            percentile(times, repetitions, 90),
+                            median > 0 ? nb_ballots / (median / 1e6) : 0,
+                            tracker->total.peak - live};
+        write_table_row(out, kernels[k].name, values);
+        flush_writer(out);
+    }
+}
+
+/*-----------------------------------------------------------------*/
+
+// Reads a comma-separated list of counts, 1e6 being a count
+static int parse_grid(const char *list, double *grid, double low,
+                      double high) {
+    int n = 0;
+    const char *c = list;
+    while (*c != '\0' && n < MAX_GRID) {
+        char *end;
+        grid[n] = strtod(c, &end);
+        if (end == c || grid[n] < low || grid[n] > high ||
+            (*end != ',' && *end != '\0'))
+            return -1;
+        n++;
+        c = *end == ',' ? end + 1 : end;
+    }
+    return *c == '\0' ? n : -1;
+}
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-n ballots,...] [-c candidates,...] "
+            "[-m ic|mallows|pl|spatial1|spatial2] [-s seed] [-w warmup] "
+            "[-r repetitions] [-d directory] [-o outputfile] "
+            "[-f text|csv|json|binary]\n",
+            program);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    double ballot_grid[MAX_GRID] = {1e3, 1e4, 1e5};
+    double candidate_grid[MAX_GRID] = {3, 10, 50};
+    int nb_ballot_counts = 3, nb_candidate_counts = 3;
+    int warmup = 1, repetitions = 5;
+    enum BallotModel kind = MODEL_IC;
+    uint64_t seed = 1;
+    const char *directory = "/tmp";
+    char *outputFile = NULL;
+    enum OutputFormat format = FORMAT_TEXT;
+    while ((opt = getopt(argc, argv, "n:c:m:s:w:r:d:o:f:")) != -1) {
+        switch (opt) {
+        case 'n':
+            nb_ballot_counts = parse_grid(optarg, ballot_grid, 1, UINT32_MAX);
+            if (nb_ballot_counts <= 0)
+                usage(argv[0]);
+            break;
+        case 'c':
+            nb_candidate_counts =
+                parse_grid(optarg, candidate_grid, 1, MAX_TAB - 1);
+            if (nb_candidate_counts <= 0)
+                usage(argv[0]);
+            break;
+        case 'm':
+            if (parse_ballot_model(optarg, &kind) != 0)
+                usage(argv[0]);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'r':
+            repetitions = atoi(optarg);
+            break;
+        case 'd':
+            directory = optarg;
+            break;
+        case 'o':
+            outputFile = optarg;
+            break;
+        case 'f':
+            if (parse_output_format(optarg, &format) != 0)
+                usage(argv[0]);
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (warmup < 0 || repetitions <= 0 || repetitions > MAX_REPETITIONS)
+        usage(argv[0]);
+
+    // Every allocation is accounted, for the memory of the kernels
+    MemoryTracker tracker;
+    init_memory_tracker(&tracker, NULL);
+    set_thread_allocator(get_tracking_allocator(&tracker));
+    ptrWriter out = open_writer(outputFile, format);
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/bench_XXXXXX", directory);
+    int fd = mkstemp(path);
+    if (out == NULL || fd < 0) {
+        perror("Could not open the output files");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+
+    static const char *const headers[] = {
+        "Kernel", "Ballots",   "Candidates", "Median us",
+        "P10 us", "P90 us",    "Ballots/s",  "Peak bytes"};
+    begin_table(out, headers, 8, 3);
+    for (int n = 0; n < nb_ballot_counts; n++) {
+        for (int c = 0; c < nb_candidate_counts; c++) {
+            uint nb_ballots = ballot_grid[n];
+            ElectionModel model;
+            init_election_model(&model, kind, candidate_grid[c], -1, seed);
+            BenchElection election = {path, init_ballots(), init_matrix(true),
+                                      model.nb_candidates};
+            if (election.ballots == NULL || election.duel == NULL ||
+                generate_ballots(election.ballots, &model, nb_ballots) != 0 ||
+                write_election_file(&model, nb_ballots, path) != 0) {
+                fprintf(stderr, "Could not generate %u ballots\n",
+                        nb_ballots);
+                remove(path);
+                exit(EXIT_FAILURE);
+            }
+            set_duel_from_ballots(election.duel, election.ballots);
+            bench_election(out, &tracker, &election, nb_ballots, warmup,
+                           repetitions);
+            delete_matrix(election.duel);
+            delete_ballots(election.ballots);
+        }
+    }
+    end_table(out);
+    remove(path);
+
+    static const char *const process[] = {"Process", "Bytes"};
+    begin_table(out, process, 2, 0);
+    double rss = get_peak_rss();
+    write_table_row(out, "peak RSS", &rss);
+    end_table(out);
+    if (close_writer(out) != 0) {
+        perror("Could not write the results");
+        exit(EXIT_FAILURE);
+    }
+    set_thread_allocator(NULL);
+    return 0;
+}
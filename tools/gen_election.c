@@ -0,0 +1,266 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Generates Synthetic Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "allocator.h"
+#include "synthetic.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+// Ballots generated by a worker before it waits for its turn to write
+#define CHUNK_BALLOTS 65536
+
+typedef struct s_generator {
+    const ElectionModel *model;
+    uint64_t nb_ballots;
+    uint64_t nb_chunks;
+    int nb_workers;
+    bool special;         /**< Q00_Vote->N - Name header */
+    FILE *file;           /**< CSV output, NULL for binary */
+    rank_t *ranks;        /**< Binary output, column-major */
+    pthread_mutex_t lock; /**< Protects the fields below */
+    pthread_cond_t turn;  /**< Signalled when a chunk is written */
+    uint64_t next_write;  /**< The chunk whose turn it is */
+    bool failed;
+} Generator;
+
+typedef struct s_worker {
+    Generator *generator;
+    int index;
+} Worker;
+
+/*-----------------------------------------------------------------*/
+
+// Chunks are dealt round robin and written in order, each worker formatting
+// its next chunk while the others write theirs
+static void *run_worker(void *argument) {
+    Worker *worker = argument;
+    Generator *generator = worker->generator;
+    int n = generator->model->nb_candidates, row[MAX_TAB];
+    char *text = NULL;
+    if (generator->file != NULL &&
+        (text = mem_alloc(SYNTHETIC_ROW_SIZE(n) * CHUNK_BALLOTS)) == NULL) {
+        pthread_mutex_lock(&generator->lock);
+        generator->failed = true;
+        pthread_cond_broadcast(&generator->turn);
+        pthread_mutex_unlock(&generator->lock);
+        return NULL;
+    }
+    for (uint64_t chunk = worker->index; chunk < generator->nb_chunks;
+         chunk += generator->nb_workers) {
+        uint64_t first = chunk * CHUNK_BALLOTS;
+        uint64_t last = first + CHUNK_BALLOTS < generator->nb_ballots
+                            ? first + CHUNK_BALLOTS
+                            : generator->nb_ballots;
+        char *end = text;
+        for (uint64_t b = first; b < last; b++) {
+            draw_ballot(generator->model, b, row);
+            if (text != NULL) {
+                end = format_synthetic_row(end, generator->model, b, row,
+                                           generator->special);
+                continue;
+            }
+            for (int c = 0; c < n; c++)
+                generator->ranks[(size_t)c * generator->nb_ballots + b] =
+                    row[c] == -1 ? RANK_NONE : row[c];
+        }
+        if (text == NULL)
+            continue;
+        pthread_mutex_lock(&generator->lock);
+        while (generator->next_write != chunk && !generator->failed)
+            pthread_cond_wait(&generator->turn, &generator->lock);
+        if (!generator->failed &&
+            fwrite(text, 1, end - text, generator->file) !=
+                (size_t)(end - text))
+            generator->failed = true;
+        generator->next_write++;
+        pthread_cond_broadcast(&generator->turn);
+        pthread_mutex_unlock(&generator->lock);
+    }
+    mem_free(text);
+    return NULL;
+}
+
+static int run_generator(Generator *generator) {
+    Worker *workers = mem_alloc(sizeof(Worker) * generator->nb_workers);
+    pthread_t *threads = mem_alloc(sizeof(pthread_t) * generator->nb_workers);
+    if (workers == NULL || threads == NULL) {
+        mem_free(workers);
+        mem_free(threads);
+        return -1;
+    }
+    pthread_mutex_init(&generator->lock, NULL);
+    pthread_cond_init(&generator->turn, NULL);
+    generator->next_write = 0;
+    generator->failed = false;
+    generator->nb_chunks =
+        (generator->nb_ballots + CHUNK_BALLOTS - 1) / CHUNK_BALLOTS;
+    int started = 0;
+    for (; started < generator->nb_workers; started++) {
+        workers[started] = (Worker){generator, started};
+        if (pthread_create(&threads[started], NULL, run_worker,
+                           &workers[started]) != 0)
+            break;
+    }
+    // A missing worker would leave its chunks unwritten
+    if (started < generator->nb_workers) {
+        pthread_mutex_lock(&generator->lock);
+        generator->failed = true;
+        pthread_cond_broadcast(&generator->turn);
+        pthread_mutex_unlock(&generator->lock);
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    pthread_cond_destroy(&generator->turn);
+    pthread_mutex_destroy(&generator->lock);
+    mem_free(workers);
+    mem_free(threads);
+    return generator->failed ? -1 : 0;
+}
+
+static int write_binary(const Generator *generator, FILE *file) {
+    int n = generator->model->nb_candidates;
+    ptrBallots ballots = init_ballots();
+    if (ballots == NULL)
+        return -1;
+    int status = set_synthetic_tags(ballots, n);
+    // The store borrows the ranks, they are returned before it is freed
+    ballots->ranks = generator->ranks;
+    ballots->capacity = ballots->rows = generator->nb_ballots;
+    if (status == 0)
+        status = write_ballots(ballots, file);
+    ballots->ranks = NULL;
+    ballots->capacity = ballots->rows = 0;
+    delete_ballots(ballots);
+    return status;
+}
+
+/*-----------------------------------------------------------------*/
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s -o output -n ballots -c candidates "
+            "[-m ic|mallows|pl|spatial1|spatial2] [-p parameter] "
+            "[-t truncation] [-u unranked] [-s seed] [-j workers] "
+            "[-l special|plain] [-f csv|binary]\n",
+            program);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    char *outputFile = NULL;
+    long long nb_ballots = 0;
+    int nb_workers = 0;
+    bool binary = false, special = true;
+    int nb_candidates = 0;
+    double parameter = -1, truncation = 0, unranked = 0;
+    uint64_t seed = 1;
+    enum BallotModel kind = MODEL_IC;
+    ElectionModel model;
+    while ((opt = getopt(argc, argv, "o:n:c:m:p:t:u:s:j:l:f:")) != -1) {
+        switch (opt) {
+        case 'o':
+            outputFile = optarg;
+            break;
+        case 'n':
+            nb_ballots = atoll(optarg);
+            break;
+        case 'c':
+            nb_candidates = atoi(optarg);
+            break;
+        case 'm':
+            if (parse_ballot_model(optarg, &kind) != 0)
+                usage(argv[0]);
+            break;
+        case 'p':
+            parameter = atof(optarg);
+            break;
+        case 't':
+            truncation = atof(optarg);
+            break;
+        case 'u':
+            unranked = atof(optarg);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'j':
+            nb_workers = atoi(optarg);
+            break;
+        case 'l':
+            if (strcmp(optarg, "special") != 0 && strcmp(optarg, "plain") != 0)
+                usage(argv[0]);
+            special = strcmp(optarg, "special") == 0;
+            break;
+        case 'f':
+            if (strcmp(optarg, "csv") != 0 && strcmp(optarg, "binary") != 0)
+                usage(argv[0]);
+            binary = strcmp(optarg, "binary") == 0;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (outputFile == NULL || nb_ballots <= 0 || nb_candidates <= 0 ||
+        nb_candidates >= MAX_TAB)
+        usage(argv[0]);
+    if (binary && nb_ballots > UINT32_MAX) {
+        fprintf(stderr, "The binary format holds at most %u ballots\n",
+                UINT32_MAX);
+        exit(EXIT_FAILURE);
+    }
+
+    if (init_election_model(&model, kind, nb_candidates, parameter, seed) !=
+        0) {
+        fprintf(stderr, "The parameter must be in (0, 1]\n");
+        exit(EXIT_FAILURE);
+    }
+    model.truncation = truncation;
+    model.unranked = unranked;
+
+    if (nb_workers <= 0)
+        nb_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_workers <= 0)
+        nb_workers = 1;
+    FILE *file = fopen(outputFile, binary ? "wb" : "w");
+    if (file == NULL) {
+        perror("Could not open the output file");
+        exit(EXIT_FAILURE);
+    }
+    Generator generator = {.model = &model,
+                           .nb_ballots = nb_ballots,
+                           .nb_workers = nb_workers,
+                           .special = special,
+                           .file = binary ? NULL : file};
+    if (binary) {
+        generator.ranks = mem_alloc((size_t)model.nb_candidates * nb_ballots);
+        if (generator.ranks == NULL) {
+            fprintf(stderr, "Could not allocate the ballots\n");
+            exit(EXIT_FAILURE);
+        }
+    } else {
+        write_synthetic_header(file, &model, special);
+    }
+    if (run_generator(&generator) != 0 ||
+        (binary && write_binary(&generator, file) != 0) ||
+        fclose(file) != 0) {
+        fprintf(stderr, "Could not write %s\n", outputFile);
+        exit(EXIT_FAILURE);
+    }
+    mem_free(generator.ranks);
+    fprintf(stderr, "%s: %lld ballots, %d candidates\n", outputFile,
+            nb_ballots, model.nb_candidates);
+    return 0;
+}
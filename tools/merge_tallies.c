@@ -0,0 +1,59 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Merges Tally Summaries of Separate Ballot Exports
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "summary.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char **argv) {
+    int opt;
+    char *outputFile = NULL;
+    while ((opt = getopt(argc, argv, "o:")) != -1) {
+        switch (opt) {
+        case 'o':
+            outputFile = optarg;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s -o output summary...\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (outputFile == NULL || optind == argc) {
+        fprintf(stderr, "Usage: %s -o output summary...\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    ptrTallySummary total = init_tally_summary();
+    ptrTallySummary shard = init_tally_summary();
+    if (total == NULL || shard == NULL) {
+        fprintf(stderr, "Could not allocate the summaries\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = optind; i < argc; i++) {
+        if (read_tally_summary(shard, argv[i]) != 0) {
+            fprintf(stderr, "Could not read the tally summary %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+        if (merge_tally_summaries(total, shard) != 0) {
+            fprintf(stderr, "%s does not have the same candidates\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+        printf("%s: %u ballots\n", argv[i], shard->histogram->ballots);
+    }
+    if (write_tally_summary(total, outputFile) != 0) {
+        fprintf(stderr, "Could not write the tally summary %s\n", outputFile);
+        exit(EXIT_FAILURE);
+    }
+    printf("%s: %u ballots from %d summaries\n", outputFile,
+           total->histogram->ballots, argc - optind);
+
+    delete_tally_summary(shard);
+    delete_tally_summary(total);
+    return 0;
+}
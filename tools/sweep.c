@@ -0,0 +1,314 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Compares Every Method over Many Elections
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "arena.h"
+#include "batch.h"
+#include "condorcet.h"
+#include "random.h"
+#include "synthetic.h"
+#include "writer.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*-----------------------------------------------------------------*/
+
+// At most every method is swept, only those with a single winner are
+#define NB_SWEPT_METHODS UNKNOWN
+
+/**
+ * @brief What a worker counted, merged at the end.
+ */
+typedef struct s_sweep_counts {
+    uint elections; /**< Counted */
+    uint failed;    /**< Could not be read */
+    uint condorcet; /**< With a Condorcet winner */
+    uint decided[NB_SWEPT_METHODS];   /**< With a single winner */
+    uint efficient[NB_SWEPT_METHODS]; /**< Electing the Condorcet winner */
+    uint agree[NB_SWEPT_METHODS][NB_SWEPT_METHODS]; /**< Same winner */
+} SweepCounts;
+
+/**
+ * @brief The elections of a sweep, generated or read from files.
+ */
+typedef struct s_sweep {
+    const Batch *files;  /**< The ballot files, NULL to generate */
+    ElectionModel model; /**< Of the generated elections */
+    uint nb_ballots;     /**< Of each generated election */
+    uint64_t seed;       /**< Of the generated elections */
+    uint nb_elections;   /**< The number of elections */
+    enum Method methods[NB_SWEPT_METHODS]; /**< The methods compared */
+    int nb_methods;                        /**< The number of methods */
+    atomic_uint next;    /**< First election not taken */
+} Sweep;
+
+typedef struct s_sweep_worker {
+    Sweep *sweep;
+    SweepCounts counts;
+} SweepWorker;
+
+/*-----------------------------------------------------------------*/
+
+// Election k of a generated sweep is drawn from a model seeded by stream k
+static int set_election(const Sweep *sweep, uint k, ptrTallies tallies) {
+    if (sweep->files != NULL) {
+        const char *path = sweep->files->jobs[k].path;
+        int nb_candidates = infer_candidate_count(path);
+        if (nb_candidates <= 0 || nb_candidates >= MAX_TAB)
+            return -1;
+        return set_tallies_from_file(tallies, path, nb_candidates);
+    }
+    ElectionModel model = sweep->model;
+    RandomStream stream;
+    init_random_stream(&stream, sweep->seed, k);
+    model.seed = next_random(&stream);
+    if (generate_ballots(tallies->ballots, &model, sweep->nb_ballots) != 0)
+        return -1;
+    return update_tallies(tallies);
+}
+
+// Every method counts the same tallies, read or drawn once
+static void count_election(const Sweep *sweep, const Tallies *tallies,
+                           SweepCounts *counts) {
+    int winners[NB_SWEPT_METHODS], condorcet;
+    bool has_condorcet = find_condorcet_winner(
+        tallies->duel, tallies->ballots->columns, &condorcet);
+    counts->elections++;
+    counts->condorcet += has_condorcet;
+    for (int m = 0; m < sweep->nb_methods; m++) {
+        ElectionOptions options;
+        init_election_options(&options, sweep->methods[m]);
+        winners[m] = find_election_winner(tallies, &options);
+        if (winners[m] < 0)
+            continue;
+        counts->decided[m]++;
+        counts->efficient[m] += has_condorcet && winners[m] == condorcet;
+    }
+    for (int m = 0; m < sweep->nb_methods; m++) {
+        for (int n = 0; n < sweep->nb_methods; n++)
+            counts->agree[m][n] += winners[m] >= 0 && winners[m] == winners[n];
+    }
+}
+
+static void *run_sweep_worker(void *argument) {
+    SweepWorker *worker = argument;
+    Sweep *sweep = worker->sweep;
+    ptrTallies tallies = init_tallies();
+    ptrArena arena = init_arena(ARENA_BLOCK_SIZE);
+    while (true) {
+        uint k = atomic_fetch_add(&sweep->next, 1);
+        if (k >= sweep->nb_elections)
+            break;
+        if (tallies == NULL || arena == NULL ||
+            set_election(sweep, k, tallies) != 0) {
+            worker->counts.failed++;
+            continue;
+        }
+        // The scratch space of the methods is dropped with the arena
+        const Allocator *previous =
+            set_thread_allocator(get_arena_allocator(arena));
+        count_election(sweep, tallies, &worker->counts);
+        set_thread_allocator(previous);
+        reset_arena(arena);
+    }
+    delete_arena(arena);
+    delete_tallies(tallies);
+    return NULL;
+}
+
+static int run_sweep(Sweep *sweep, int nb_workers, SweepCounts *counts) {
+    SweepWorker *workers = mem_calloc(nb_workers, sizeof(SweepWorker));
+    pthread_t *threads = mem_alloc(sizeof(pthread_t) * nb_workers);
+    if (workers == NULL || threads == NULL) {
+        mem_free(workers);
+        mem_free(threads);
+        return -1;
+    }
+    int started = 0;
+    for (; started < nb_workers; started++) {
+        workers[started].sweep = sweep;
+        if (pthread_create(&threads[started], NULL, run_sweep_worker,
+                           &workers[started]) != 0)
+            break;
+    }
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+
+    memset(counts, 0, sizeof(SweepCounts));
+    for (int i = 0; i < started; i++) {
+        const SweepCounts *other = &workers[i].counts;
+        counts->elections += other->elections;
+        counts->failed += other->failed;
+        counts->condorcet += other->condorcet;
+        for (int m = 0; m < NB_SWEPT_METHODS; m++) {
+            counts->decided[m] += other->decided[m];
+            counts->efficient[m] += other->efficient[m];
+            for (int n = 0; n < NB_SWEPT_METHODS; n++)
+                counts->agree[m][n] += other->agree[m][n];
+        }
+    }
+    mem_free(workers);
+    mem_free(threads);
+    return started > 0 ? 0 : -1;
+}
+
+/*-----------------------------------------------------------------*/
+
+// How often each pair of methods elects the same candidate, then how often
+// each one elects the Condorcet winner when there is one, and elects anyone
+static void write_summary(ptrWriter out, const Sweep *sweep,
+                          const SweepCounts *counts) {
+    int nb_methods = sweep->nb_methods;
+    const char *headers[NB_SWEPT_METHODS + 3] = {"Method"};
+    for (int m = 0; m < nb_methods; m++)
+        headers[m + 1] = enum_to_str(sweep->methods[m]);
+    headers[nb_methods + 1] = "Condorcet";
+    headers[nb_methods + 2] = "Decided";
+    double elections = counts->elections ? counts->elections : 1;
+    double condorcet = counts->condorcet ? counts->condorcet : 1;
+    begin_table(out, headers, nb_methods + 3, 3);
+    for (int m = 0; m < nb_methods; m++) {
+        double values[NB_SWEPT_METHODS + 2];
+        for (int n = 0; n < nb_methods; n++)
+            values[n] = counts->agree[m][n] / elections;
+        values[nb_methods] = counts->efficient[m] / condorcet;
+        values[nb_methods + 1] = counts->decided[m] / elections;
+        write_table_row(out, headers[m + 1], values);
+    }
+    end_table(out);
+
+    static const char *const totals[] = {"Elections", "Count"};
+    begin_table(out, totals, 2, 0);
+    double values[3] = {counts->elections,
+                        counts->elections - counts->condorcet,
+                        counts->failed};
+    write_table_row(out, "counted", &values[0]);
+    write_table_row(out, "no Condorcet winner", &values[1]);
+    write_table_row(out, "failed", &values[2]);
+    end_table(out);
+}
+
+static void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-i directory|manifest | -n elections -b ballots "
+            "-c candidates [-m ic|mallows|pl|spatial1|spatial2] "
+            "[-p parameter] [-t truncation] [-s seed]] [-j workers] "
+            "[-o outputfile] [-f text|csv|json|binary]\n",
+            program);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    const char *inputPath = NULL;
+    char *outputFile = NULL;
+    long long nb_elections = 1000, nb_ballots = 1000;
+    int nb_candidates = 5, nb_workers = 0;
+    double parameter = -1, truncation = 0;
+    uint64_t seed = 1;
+    enum BallotModel kind = MODEL_IC;
+    enum OutputFormat format = FORMAT_TEXT;
+    while ((opt = getopt(argc, argv, "i:n:b:c:m:p:t:s:j:o:f:")) != -1) {
+        switch (opt) {
+        case 'i':
+            inputPath = optarg;
+            break;
+        case 'n':
+            nb_elections = atoll(optarg);
+            break;
+        case 'b':
+            nb_ballots = atoll(optarg);
+            break;
+        case 'c':
+            nb_candidates = atoi(optarg);
+            break;
+        case 'm':
+            if (parse_ballot_model(optarg, &kind) != 0)
+                usage(argv[0]);
+            break;
+        case 'p':
+            parameter = atof(optarg);
+            break;
+        case 't':
+            truncation = atof(optarg);
+            break;
+        case 's':
+            seed = strtoull(optarg, NULL, 10);
+            break;
+        case 'j':
+            nb_workers = atoi(optarg);
+            break;
+        case 'o':
+            outputFile = optarg;
+            break;
+        case 'f':
+            if (parse_output_format(optarg, &format) != 0)
+                usage(argv[0]);
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (nb_elections <= 0 || nb_elections > UINT32_MAX || nb_ballots <= 0 ||
+        nb_ballots > UINT32_MAX)
+        usage(argv[0]);
+
+    Sweep sweep = {.files = NULL,
+                   .nb_ballots = nb_ballots,
+                   .seed = seed,
+                   .nb_elections = nb_elections,
+                   .nb_methods = 0,
+                   .next = 0};
+    for (enum Method m = 0; m < UNKNOWN; m++) {
+        if (has_single_winner(m))
+            sweep.methods[sweep.nb_methods++] = m;
+    }
+    ptrBatch files = NULL;
+    if (inputPath != NULL) {
+        ElectionOptions options;
+        init_election_options(&options, UNI1);
+        files = init_batch(&options, "sweep", NULL);
+        if (files == NULL || add_batch_path(files, inputPath) < 0) {
+            fprintf(stderr, "Could not list the elections of %s\n",
+                    inputPath);
+            exit(EXIT_FAILURE);
+        }
+        sweep.files = files;
+        sweep.nb_elections = files->nb_jobs;
+    } else if (init_election_model(&sweep.model, kind, nb_candidates,
+                                   parameter, seed) != 0) {
+        fprintf(stderr, "Invalid number of candidates or parameter\n");
+        exit(EXIT_FAILURE);
+    }
+    sweep.model.truncation = truncation;
+
+    if (nb_workers <= 0)
+        nb_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_workers <= 0)
+        nb_workers = 1;
+    SweepCounts counts;
+    ptrWriter out = open_writer(outputFile, format);
+    if (out == NULL) {
+        perror("Could not open the output file");
+        exit(EXIT_FAILURE);
+    }
+    if (run_sweep(&sweep, nb_workers, &counts) != 0) {
+        fprintf(stderr, "Could not start the workers\n");
+        exit(EXIT_FAILURE);
+    }
+    write_summary(out, &sweep, &counts);
+    if (close_writer(out) != 0) {
+        perror("Could not write the results");
+        exit(EXIT_FAILURE);
+    }
+    delete_batch(files);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*-----------------------------------------------------------------*/
+/** Advanced Project
+ *  @author LAMALMI Daoud
+ *  @date 18/10/2026
+ *  @file Sends Requests to VotingMethods --serve
+ **/
+/*-----------------------------------------------------------------*/
+
+#include "server.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s -s socket [-r repeats] command\n"
+            "  open NAME PATH [CANDIDATES]\n"
+            "  create NAME CANDIDATE...\n"
+            "  append NAME RANKS... (one ballot per argument, as 1,0,2)\n"
+            "  winner NAME METHOD\n"
+            "  duel NAME\n"
+            "  ranking NAME\n"
+            "  drop NAME\n"
+            "  stop\n",
+            name);
+    exit(EXIT_FAILURE);
+}
+
+// Adds a ballot written as comma separated ranks
+static void put_ballot(Message *request, char *ballot, uint nb_candidates) {
+    char *save;
+    char *token = strtok_r(ballot, ",", &save);
+    for (uint c = 0; c < nb_candidates; c++) {
+        put_u8(request, token ? atoi(token) : 0);
+        token = token ? strtok_r(NULL, ",", &save) : NULL;
+    }
+}
+
+static uint count_fields(const char *ballot) {
+    uint count = 1;
+    for (const char *c = ballot; *c; c++)
+        count += *c == ',';
+    return count;
+}
+
+int main(int argc, char **argv) {
+    int opt, repeats = 1;
+    char *socketPath = NULL;
+    while ((opt = getopt(argc, argv, "s:r:")) != -1) {
+        switch (opt) {
+        case 's':
+            socketPath = optarg;
+            break;
+        case 'r':
+            repeats = atoi(optarg);
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (socketPath == NULL || optind == argc || repeats <= 0)
+        usage(argv[0]);
+    const char *command = argv[optind];
+    char **args = argv + optind + 1;
+    int nb_args = argc - optind - 1;
+
+    Message request, reply;
+    init_message(&request);
+    init_message(&reply);
+    if (strcmp(command, "open") == 0 && (nb_args == 2 || nb_args == 3)) {
+        put_u8(&request, REQUEST_OPEN);
+        put_string(&request, args[0]);
+        put_string(&request, args[1]);
+        put_u32(&request, nb_args == 3 ? atoi(args[2]) : 0);
+    } else if (strcmp(command, "create") == 0 && nb_args >= 2) {
+        put_u8(&request, REQUEST_CREATE);
+        put_string(&request, args[0]);
+        put_u32(&request, nb_args - 1);
+        for (int i = 1; i < nb_args; i++)
+            put_string(&request, args[i]);
+    } else if (strcmp(command, "append") == 0 && nb_args >= 2) {
+        put_u8(&request, REQUEST_APPEND);
+        put_string(&request, args[0]);
+        put_u32(&request, nb_args - 1);
+        uint nb_candidates = count_fields(args[1]);
+        for (int i = 1; i < nb_args; i++)
+            put_ballot(&request, args[i], nb_candidates);
+    } else if (strcmp(command, "winner") == 0 && nb_args == 2) {
+        put_u8(&request, REQUEST_WINNER);
+        put_string(&request, args[0]);
+        put_string(&request, args[1]);
+    } else if (strcmp(command, "duel") == 0 && nb_args == 1) {
+        put_u8(&request, REQUEST_DUEL);
+        put_string(&request, args[0]);
+    } else if (strcmp(command, "ranking") == 0 && nb_args == 1) {
+        put_u8(&request, REQUEST_RANKING);
+        put_string(&request, args[0]);
+    } else if (strcmp(command, "drop") == 0 && nb_args == 1) {
+        put_u8(&request, REQUEST_DROP);
+        put_string(&request, args[0]);
+    } else if (strcmp(command, "stop") == 0 && nb_args == 0) {
+        put_u8(&request, REQUEST_STOP);
+    } else {
+        usage(argv[0]);
+    }
+
+    int fd = connect_to_server(socketPath);
+    if (fd < 0) {
+        perror("Could not connect to the server");
+        exit(EXIT_FAILURE);
+    }
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < repeats; i++) {
+        if (send_message(fd, &request) != 0 ||
+            receive_message(fd, &reply) != 0) {
+            fprintf(stderr, "The server closed the connection\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    close(fd);
+
+    char text[MAX_ELECTION_NAME];
+    if (get_u32(&reply) != 0) {
+        get_string(&reply, text, sizeof(text));
+        fprintf(stderr, "Error: %s\n", text);
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(command, "open") == 0) {
+        uint candidates = get_u32(&reply), ballots = get_u32(&reply);
+        printf("%u candidates, %u ballots, %u rejected\n", candidates,
+               ballots, get_u32(&reply));
+    } else if (strcmp(command, "append") == 0) {
+        printf("%u ballots\n", get_u32(&reply));
+    } else if (strcmp(command, "winner") == 0) {
+        int winner = get_u32(&reply);
+        get_string(&reply, text, sizeof(text));
+        bool cached = get_u8(&reply);
+        printf("Winner: %s (%d)%s\n", text, winner, cached ? ", cached" : "");
+    } else if (strcmp(command, "duel") == 0) {
+        uint nb_candidates = get_u32(&reply);
+        for (uint i = 0; i < nb_candidates; i++) {
+            for (uint j = 0; j < nb_candidates; j++)
+                printf("%6u", get_u32(&reply));
+            printf("\n");
+        }
+    } else if (strcmp(command, "ranking") == 0) {
+        uint nb_candidates = get_u32(&reply);
+        for (uint i = 0; i < nb_candidates; i++) {
+            int candidate = get_u32(&reply), grade = get_u32(&reply);
+            get_string(&reply, text, sizeof(text));
+            printf("%u. %s (%d), grade %d\n", i + 1, text, candidate, grade);
+        }
+    }
+    if (repeats > 1) {
+        double elapsed = (end.tv_sec - start.tv_sec) * 1e6 +
+                         (end.tv_nsec - start.tv_nsec) / 1e3;
+        printf("%d requests, %.1f us each\n", repeats, elapsed / repeats);
+    }
+    release_message(&request);
+    release_message(&reply);
+    return 0;
+}